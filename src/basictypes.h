@@ -35,6 +35,9 @@ namespace noise
   /// Unsigned integer type.
   typedef unsigned int uint;
 
+  /// 64-bit unsigned integer type.
+  typedef unsigned long long uint64;
+
   /// 32-bit unsigned integer type.
   typedef unsigned int uint32;
 
@@ -44,6 +47,9 @@ namespace noise
   /// 8-bit unsigned integer type.
   typedef unsigned char uint8;
 
+  /// 64-bit signed integer type.
+  typedef long long int64;
+
   /// 32-bit signed integer type.
   typedef int int32;
 
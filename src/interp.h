@@ -84,6 +84,18 @@ namespace noise
     return (a * a * (3.0 - 2.0 * a));
   }
 
+  /// Returns the derivative of a cubic S-curve.
+  ///
+  /// @param a The value at which to evaluate the derivative.
+  ///
+  /// @returns The derivative of SCurve3() at @a a.
+  ///
+  /// @a a should range from 0.0 to 1.0.
+  inline double SCurve3Deriv (double a)
+  {
+    return (6.0 * a * (1.0 - a));
+  }
+
   /// Maps a value onto a quintic S-curve.
   ///
   /// @param a The value to map onto a quintic S-curve.
@@ -105,6 +117,19 @@ namespace noise
     return (6.0 * a5) - (15.0 * a4) + (10.0 * a3);
   }
 
+  /// Returns the derivative of a quintic S-curve.
+  ///
+  /// @param a The value at which to evaluate the derivative.
+  ///
+  /// @returns The derivative of SCurve5() at @a a.
+  ///
+  /// @a a should range from 0.0 to 1.0.
+  inline double SCurve5Deriv (double a)
+  {
+    double b = a * (1.0 - a);
+    return (30.0 * b * b);
+  }
+
   // @}
 
 }
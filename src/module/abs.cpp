@@ -30,9 +30,27 @@ Abs::Abs ():
 {
 }
 
-double Abs::GetValue (double x, double y, double z) const
+double Abs::GetValue (double x, double y) const
 {
   assert (m_pSourceModule[0] != NULL);
 
   return fabs (m_pSourceModule[0]->GetValue (x, y));
 }
+
+double Abs::GetValue (double x, double y, double footprint) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  return fabs (m_pSourceModule[0]->GetValue (x, y, footprint));
+}
+
+void Abs::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  m_pSourceModule[0]->GetValues (xs, ys, out, n);
+  for (size_t i = 0; i < n; i++) {
+    out[i] = fabs (out[i]);
+  }
+}
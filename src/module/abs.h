@@ -59,7 +59,12 @@ namespace noise
           return 1;
         }
 
-        virtual double GetValue (double x, double y, double z) const;
+        virtual double GetValue (double x, double y) const;
+
+        virtual double GetValue (double x, double y, double footprint) const;
+
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
 
     };
 
@@ -63,6 +63,11 @@ namespace noise
 
         virtual double GetValue (double x, double y) const;
 
+        virtual double GetValue (double x, double y, double footprint) const;
+
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
+
     };
 
     /// @}
@@ -21,6 +21,7 @@
 // off every 'zig'.)
 //
 
+#include "fractal.h"
 #include "billow.h"
 
 using namespace noise::module;
@@ -28,79 +29,100 @@ using namespace noise::module;
 Billow::Billow ():
   Module (GetSourceModuleCount ()),
   m_frequency       (DEFAULT_BILLOW_FREQUENCY   ),
+  m_hashType        (DEFAULT_BILLOW_HASH        ),
   m_lacunarity      (DEFAULT_BILLOW_LACUNARITY  ),
   m_noiseQuality    (DEFAULT_BILLOW_QUALITY     ),
   m_noiseType       (DEFAULT_BILLOW_TYPE        ),
   m_octaveCount     (DEFAULT_BILLOW_OCTAVE_COUNT),
   m_octaveCountTmp  (DEFAULT_BILLOW_OCTAVE_COUNT),
+  m_periodX         (DEFAULT_BILLOW_PERIOD),
+  m_periodY         (DEFAULT_BILLOW_PERIOD),
   m_persistence     (DEFAULT_BILLOW_PERSISTENCE ),
-  m_seed            (DEFAULT_BILLOW_SEED)
+  m_pFractalKernel     (NULL),
+  m_seed            (DEFAULT_BILLOW_SEED),
+  m_tolerance       (DEFAULT_BILLOW_TOLERANCE)
 {
     // m_norm is a normalizing factor to keep the signal in [-1.0,1.0]
     // The maximum signal amplitude can be calculated, since it is a geometric series
     m_norm = 1.0;//(1.0 - m_persistence) / (1.0-pow(m_persistence,m_octaveCount+1));
+    UpdateFractalKernel ();
+}
+
+void Billow::UpdatePermutationTables ()
+{
+  if (m_hashType != HASH_PERMUTATION) {
+    m_permutationTables.clear ();
+    return;
+  }
+  m_permutationTables.resize (BILLOW_MAX_OCTAVE);
+  for (int curOctave = 0; curOctave < BILLOW_MAX_OCTAVE; curOctave++) {
+    m_permutationTables[curOctave].SetSeed ((m_seed + curOctave) & 0xffffffff);
+  }
+}
+
+FractalParams Billow::GetFractalParams () const
+{
+  FractalParams params;
+  params.frequency          = m_frequency;
+  params.lacunarity         = m_lacunarity;
+  params.persistence        = m_persistence;
+  params.norm               = m_norm;
+  params.seed               = m_seed;
+  params.seedMask           = 0xffffffff;
+  params.periodX            = m_periodX;
+  params.periodY            = m_periodY;
+  params.noiseType          = m_noiseType;
+  params.noiseQuality       = m_noiseQuality;
+  params.pPermutationTables = m_permutationTables.empty ()? NULL:
+    &m_permutationTables[0];
+  params.pSpectralWeights   = NULL;
+  return params;
+}
+
+void Billow::UpdateFractalKernel ()
+{
+  m_pFractalKernel = GetFractalKernel<BillowSignal> (m_noiseType,
+    m_noiseQuality, m_hashType);
 }
 
 double Billow::GetValue (double x, double y) const
 {
-  double value = 0.0;
-  double signal = 0.0;
-  double curPersistence = 1.0;
-  double nx, ny;
-  int seed;
+  int skippedOctaves;
+  return m_pFractalKernel (GetFractalParams (), x, y, m_octaveCountTmp,
+    m_tolerance, skippedOctaves);
+}
 
-  x *= m_frequency;
-  y *= m_frequency;
-  
-  switch (m_noiseType)
-  {
-    case noise::TYPE_GRADIENT:
-    {
-        for (int curOctave = 0; curOctave < m_octaveCount; curOctave++)
-        {
-            // Make sure that these floating-point values have the same range as a 32-
-            // bit integer so that we can pass them to the coherent-noise functions.
-            nx = MakeInt32Range (x);
-            ny = MakeInt32Range (y);
+double Billow::GetValue (double x, double y, double footprint) const
+{
+  int skippedOctaves;
+  return m_pFractalKernel (GetFractalParams (), x, y, FootprintOctaveCount (
+    m_frequency, m_lacunarity, m_octaveCountTmp, footprint), m_tolerance,
+    skippedOctaves);
+}
 
-            // Get the coherent-noise value from the input value and add it to the
-            // final result.
-            seed = (m_seed + curOctave) & 0xffffffff;
-            signal = GradientCoherentNoise2D (nx, ny, seed, m_noiseQuality);
-            signal = 2.0 * fabs (signal) - 1.0;
-            value += signal * curPersistence;
+double Billow::GetValueSkipped (double x, double y, int& skippedOctaves) const
+{
+  return m_pFractalKernel (GetFractalParams (), x, y, m_octaveCountTmp,
+    m_tolerance, skippedOctaves);
+}
 
-            // Prepare the next octave.
-            x *= m_lacunarity;
-            y *= m_lacunarity;
-            curPersistence *= m_persistence;
-        }
-        break;
-    }
-    case noise::TYPE_VALUE:
-    {
-        for (int curOctave = 0; curOctave < m_octaveCount; curOctave++)
-        {
-            // Make sure that these floating-point values have the same range as a 32-
-            // bit integer so that we can pass them to the coherent-noise functions.
-            nx = MakeInt32Range (x);
-            ny = MakeInt32Range (y);
+double Billow::GetValueDeriv (double x, double y, double& dx, double& dy)
+  const
+{
+  return FractalValueDeriv<BillowSignal> (GetFractalParams (), x, y,
+    m_octaveCountTmp, dx, dy);
+}
 
-            // Get the coherent-noise value from the input value and add it to the
-            // final result.
-            seed = (m_seed + curOctave) & 0xffffffff;
-            signal = ValueCoherentNoise2D (nx, ny, seed, m_noiseQuality);
-            signal = 2.0 * fabs (signal) - 1.0;
-            value += signal * curPersistence;
+void Billow::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  FractalValues<BillowSignal> (GetFractalParams (), m_pFractalKernel, xs, ys,
+    out, n, m_octaveCountTmp, m_tolerance);
+}
 
-            // Prepare the next octave.
-            x *= m_lacunarity;
-            y *= m_lacunarity;
-            curPersistence *= m_persistence;
-        }
-        break;
-    }
-  }
-    
-  return value*m_norm;
+void Billow::GetValueGrid (double x0, double y0, double dx, double dy,
+  size_t width, size_t height, double* out, size_t stride) const
+{
+  FractalValueGrid<BillowSignal> (GetFractalParams (), m_pFractalKernel, x0,
+    y0, dx, dy, width, height, out, stride, m_octaveCountTmp, m_tolerance);
 }
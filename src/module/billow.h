@@ -24,6 +24,7 @@
 #ifndef NOISE_MODULE_BILLOW_H
 #define NOISE_MODULE_BILLOW_H
 
+#include <vector>
 #include "modulebase.h"
 
 namespace noise
@@ -51,6 +52,10 @@ namespace noise
     /// module.
     const int DEFAULT_BILLOW_OCTAVE_COUNT = 6;
 
+    /// Default lattice period for the noise::module::Billow noise
+    /// module, 0 for no period.
+    const int DEFAULT_BILLOW_PERIOD = 0;
+
     /// Default persistence value for the the noise::module::Billow noise
     /// module.
     const double DEFAULT_BILLOW_PERSISTENCE = 0.5;
@@ -61,13 +66,27 @@ namespace noise
     /// Default noise type for the noise::module::Billow noise module.
     const noise::NoiseType DEFAULT_BILLOW_TYPE = TYPE_GRADIENT;
 
+    /// Default hash type for the noise::module::Billow noise module.
+    const noise::HashType DEFAULT_BILLOW_HASH = HASH_ARITHMETIC;
+
     /// Default noise seed for the the noise::module::Billow noise module.
     const int DEFAULT_BILLOW_SEED = 0;
 
+    /// Default tolerance for the noise::module::Billow noise module,
+    /// 0 to generate all
+    /// octaves.
+    const double DEFAULT_BILLOW_TOLERANCE = 0.0;
+
     /// Maximum number of octaves for the the noise::module::Billow noise
     /// module.
     const int BILLOW_MAX_OCTAVE = 30;
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    // Parameters of the octave loops shared by the fractal noise modules,
+    // see fractal.h.
+    struct FractalParams;
+#endif
+
     /// Noise module that outputs three-dimensional "billowy" noise.
     ///
     /// @image html modulebillow.png
@@ -98,6 +117,9 @@ namespace noise
         /// The default persistence value is set to
         /// noise::module::DEFAULT_BILLOW_PERSISTENCE.
         ///
+        /// The default lattice periods are set to
+        /// noise::module::DEFAULT_BILLOW_PERIOD.
+        ///
         /// The default seed value is set to
         /// noise::module::DEFAULT_BILLOW_SEED.
         Billow ();
@@ -110,6 +132,16 @@ namespace noise
           return m_frequency;
         }
 
+        /// Returns the lattice hash of the billowy noise.
+        ///
+        /// @returns The lattice hash of the billowy noise.
+        ///
+        /// See noise::HashType for definitions of the lattice hashes.
+        noise::HashType GetHashType () const
+        {
+          return m_hashType;
+        }
+
         /// Returns the lacunarity of the billowy noise.
         ///
         /// @returns The lacunarity of the billowy noise.
@@ -132,6 +164,17 @@ namespace noise
           return m_noiseQuality;
         }
 
+        /// Returns the type of the billowy noise.
+        ///
+        /// @returns The type of the billowy noise.
+        ///
+        /// See noise::NoiseType for definitions of the
+        /// coherent-noise types.
+        noise::NoiseType GetNoiseType () const
+        {
+          return m_noiseType;
+        }
+
         /// Returns the number of octaves that generate the billowy noise.
         ///
         /// @returns The number of octaves that generate the billowy noise.
@@ -143,6 +186,26 @@ namespace noise
           return m_octaveCount;
         }
 
+        /// Returns the lattice period of the first octave along the @a x
+        /// axis.
+        ///
+        /// @returns The period in lattice cells, or 0 if the billowy noise
+        /// does not repeat along the @a x axis.
+        int GetPeriodX () const
+        {
+          return m_periodX;
+        }
+
+        /// Returns the lattice period of the first octave along the @a y
+        /// axis.
+        ///
+        /// @returns The period in lattice cells, or 0 if the billowy noise
+        /// does not repeat along the @a y axis.
+        int GetPeriodY () const
+        {
+          return m_periodY;
+        }
+
         /// Returns the persistence value of the billowy noise.
         ///
         /// @returns The persistence value of the billowy noise.
@@ -161,6 +224,15 @@ namespace noise
           return m_seed;
         }
 
+        /// Returns the tolerance of the billowy noise.
+        ///
+        /// @returns The largest change of the output value that leaving out
+        /// octaves may cause, or 0.0 if all octaves are generated.
+        double GetTolerance () const
+        {
+          return m_tolerance;
+        }
+
         virtual int GetSourceModuleCount () const
         {
           return 0;
@@ -168,6 +240,66 @@ namespace noise
 
         virtual double GetValue (double x, double y) const;
 
+        /// Generates an output value, leaving out the octaves whose
+        /// wavelength is shorter than the footprint.
+        ///
+        /// The wavelength of an octave is the reciprocal of its frequency.
+        /// The first octave is always generated, and at most as many octaves
+        /// as GetValue (x, y) generates.  See Module::GetValue (x, y,
+        /// footprint).
+        virtual double GetValue (double x, double y, double footprint) const;
+
+        /// Generates an output value and counts the octaves left out by the
+        /// tolerance.
+        ///
+        /// @param x The @a x coordinate of the input value.
+        /// @param y The @a y coordinate of the input value.
+        /// @param skippedOctaves Receives the number of octaves left out.
+        ///
+        /// @returns The output value, the same as GetValue (x, y).
+        ///
+        /// See SetTolerance().
+        double GetValueSkipped (double x, double y, int& skippedOctaves)
+          const;
+
+        /// Generates an output value and its partial derivatives.
+        ///
+        /// @param x The @a x coordinate of the input value.
+        /// @param y The @a y coordinate of the input value.
+        /// @param dx Receives the partial derivative with respect to @a x.
+        /// @param dy Receives the partial derivative with respect to @a y.
+        ///
+        /// @returns The output value, bit-identical to GetValue().
+        ///
+        /// The derivatives of the octaves are calculated analytically by
+        /// noise::GradientCoherentNoise2DDeriv() or
+        /// noise::ValueCoherentNoise2DDeriv() and combined by the chain
+        /// rule, so slopes and surface normals need a single evaluation
+        /// instead of three for finite differences.
+        double GetValueDeriv (double x, double y, double& dx, double& dy)
+          const;
+
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
+
+        /// Generates the output values of a regular grid of input values.
+        ///
+        /// @param x0 The @a x coordinate of the first grid column.
+        /// @param y0 The @a y coordinate of the first grid row.
+        /// @param dx The distance between two grid columns.
+        /// @param dy The distance between two grid rows.
+        /// @param width The number of grid columns.
+        /// @param height The number of grid rows.
+        /// @param out The buffer receiving the output values.
+        /// @param stride The distance between two rows in @a out.
+        ///
+        /// @pre @a stride is at least @a width.
+        ///
+        /// This method is equivalent to Perlin::GetValueGrid().
+        virtual void GetValueGrid (double x0, double y0, double dx,
+          double dy, size_t width, size_t height, double* out,
+          size_t stride) const;
+
         /// Sets the frequency of the first octave.
         ///
         /// @param frequency The frequency of the first octave.
@@ -176,6 +308,20 @@ namespace noise
           m_frequency = frequency;
         }
 
+        /// Sets the lattice hash of the billowy noise.
+        ///
+        /// @param hashType The lattice hash of the billowy noise.
+        ///
+        /// See noise::HashType for definitions of the lattice hashes.  The
+        /// permutation-table hash builds one table per octave, which is
+        /// repeated whenever the seed changes.
+        void SetHashType (noise::HashType hashType)
+        {
+          m_hashType = hashType;
+          UpdatePermutationTables ();
+          UpdateFractalKernel ();
+        }
+
         /// Sets the lacunarity of the billowy noise.
         ///
         /// @param lacunarity The lacunarity of the billowy noise.
@@ -199,6 +345,7 @@ namespace noise
         void SetNoiseQuality (noise::NoiseQuality noiseQuality)
         {
           m_noiseQuality = noiseQuality;
+          UpdateFractalKernel ();
         }
         
         /// Sets the type of the billowy noise.
@@ -210,6 +357,7 @@ namespace noise
         void SetNoiseType (noise::NoiseType noiseType)
         {
           m_noiseType = noiseType;
+          UpdateFractalKernel ();
         }
 
         /// Sets the number of octaves that generate the billowy noise.
@@ -237,6 +385,7 @@ namespace noise
             throw noise::ExceptionInvalidParam ();
           }
           m_octaveCount = octaveCount;
+          m_octaveCountTmp = octaveCount;
           // m_norm is a normalizing factor to keep the signal in [-1.0,1.0]
           // The maximum signal amplitude can be calculated, since it is a geometric series
           m_norm = 1.0 - m_persistence;
@@ -272,6 +421,29 @@ namespace noise
           m_octaveCountTmp = octaveCount;
         }
 
+        /// Sets the lattice periods of the first octave, so that the
+        /// billowy noise tiles seamlessly.
+        ///
+        /// @param periodX The period along the @a x axis, in lattice cells.
+        /// @param periodY The period along the @a y axis, in lattice cells.
+        ///
+        /// The lattice coordinates of each octave are wrapped before they
+        /// are hashed.  The periods are scaled by the lacunarity from one
+        /// octave to the next and rounded to the nearest integer, so with
+        /// an integer lacunarity such as the default 2.0 the output repeats
+        /// every @a periodX / @a frequency units along the @a x axis and
+        /// every @a periodY / @a frequency units along the @a y axis.  A
+        /// period of 0 disables the wrap along its axis.
+        ///
+        /// OpenSimplex noise is never periodic.  While a period is set,
+        /// GetValues() and GetValueGrid() evaluate the input values one by
+        /// one instead of using the batch noise functions.
+        void SetPeriod (int periodX, int periodY)
+        {
+          m_periodX = periodX;
+          m_periodY = periodY;
+        }
+
         /// Sets the persistence value of the billowy noise.
         ///
         /// @param persistence The persistence value of the billowy noise.
@@ -291,13 +463,58 @@ namespace noise
         void SetSeed (int seed)
         {
           m_seed = seed;
+          UpdatePermutationTables ();
+        }
+
+        /// Sets the tolerance of the billowy noise.
+        ///
+        /// @param tolerance The largest change of the output value that
+        /// leaving out octaves may cause, or 0.0 to generate all octaves.
+        ///
+        /// With a positive tolerance, the octave loop stops as soon as the
+        /// octaves left cannot change the output value by @a tolerance or
+        /// more, assuming coherent-noise values between -1.0 and +1.0.  The
+        /// amplitudes of the octaves only depend on the persistence, so the
+        /// same octaves are left out for all input values; GetValueSkipped()
+        /// reports how many.  GetValue(), GetValues() and GetValueGrid()
+        /// honour the tolerance; GetValueDeriv() ignores it.
+        void SetTolerance (double tolerance)
+        {
+          m_tolerance = tolerance;
         }
 
       protected:
 
+        // MultiFractal shares the octave loop of this module with other
+        // fractal modules.
+        friend class MultiFractal;
+
+        // CodeGenerator writes the octave loop with the settings as
+        // constants.
+        friend class CodeGenerator;
+
+        /// Builds the permutation tables of the octaves if the
+        /// permutation-table hash is used, or frees them otherwise.
+        ///
+        /// This method is called when the seed or the hash type changes.
+        void UpdatePermutationTables ();
+
+        /// Returns the parameters of the octave loops, see fractal.h.
+        FractalParams GetFractalParams () const;
+
+        /// Selects the octave loop of GetValue() for the current noise
+        /// type, noise quality and lattice hash.
+        ///
+        /// This method is called when one of them changes, so that
+        /// GetValue() does not need to branch on them.
+        void UpdateFractalKernel ();
+
         /// Frequency of the first octave.
         double m_frequency;
 
+        /// Lattice hash of the billowy noise.
+        noise::HashType m_hashType;
+
         /// Frequency multiplier between successive octaves.
         double m_lacunarity;
         
@@ -317,12 +534,30 @@ namespace noise
         /// of Billow noise. Can be used for subsampling.
         int m_octaveCountTmp;
 
+        /// Lattice period of the first octave along the @a x axis, or 0.
+        int m_periodX;
+
+        /// Lattice period of the first octave along the @a y axis, or 0.
+        int m_periodY;
+
         /// Persistence value of the billowy noise.
         double m_persistence;
 
+        /// Octave loop called by GetValue(), see UpdateFractalKernel().
+        double (*m_pFractalKernel) (const FractalParams& params, double x,
+          double y, int octaveCount, double tolerance, int& skippedOctaves);
+
+        /// Permutation tables of the octaves, or none if the arithmetic
+        /// hash is used.
+        std::vector<noise::PermutationTable> m_permutationTables;
+
         /// Seed value used by the billowy-noise function.
         int m_seed;
 
+        /// Largest change of the output value that leaving out octaves may
+        /// cause, see SetTolerance().
+        double m_tolerance;
+
     };
 
     /// @}
@@ -23,6 +23,7 @@
 
 #include "blend.h"
 #include "../interp.h"
+#include "../misc.h"
 
 using namespace noise::module;
 
@@ -42,3 +43,36 @@ double Blend::GetValue (double x, double y) const
   double alpha = (m_pSourceModule[2]->GetValue (x, y) + 1.0) / 2.0;
   return LinearInterp (v0, v1, alpha);
 }
+
+double Blend::GetValue (double x, double y, double footprint) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+
+  double v0 = m_pSourceModule[0]->GetValue (x, y, footprint);
+  double v1 = m_pSourceModule[1]->GetValue (x, y, footprint);
+  double alpha = (m_pSourceModule[2]->GetValue (x, y, footprint) + 1.0) / 2.0;
+  return LinearInterp (v0, v1, alpha);
+}
+
+void Blend::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+
+  double v1[BATCH_BLOCK_SIZE];
+  double alpha[BATCH_BLOCK_SIZE];
+  for (size_t i = 0; i < n; i += BATCH_BLOCK_SIZE) {
+    size_t count = GetMin (n - i, (size_t)BATCH_BLOCK_SIZE);
+    double* v0 = out + i;
+    m_pSourceModule[0]->GetValues (xs + i, ys + i, v0, count);
+    m_pSourceModule[1]->GetValues (xs + i, ys + i, v1, count);
+    m_pSourceModule[2]->GetValues (xs + i, ys + i, alpha, count);
+    for (size_t j = 0; j < count; j++) {
+      v0[j] = LinearInterp (v0[j], v1[j], (alpha[j] + 1.0) / 2.0);
+    }
+  }
+}
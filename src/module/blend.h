@@ -106,6 +106,11 @@ namespace noise
 
 	      virtual double GetValue (double x, double y) const;
 
+	      virtual double GetValue (double x, double y, double footprint) const;
+
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
+
         /// Sets the control module.
         ///
         /// @param controlModule The control module.
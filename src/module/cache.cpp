@@ -21,12 +21,14 @@
 // off every 'zig'.)
 //
 
+#include "../misc.h"
 #include "cache.h"
 
 using namespace noise::module;
 
 Cache::Cache ():
   Module (GetSourceModuleCount ()),
+  m_blockCount (0),
   m_isCached (false)
 {
 }
@@ -35,11 +37,70 @@ double Cache::GetValue (double x, double y) const
 {
   assert (m_pSourceModule[0] != NULL);
 
-  if (!(m_isCached && x == m_xCache && y == m_yCache)) {
+  if (!(m_isCached && x == m_xCache && y == m_yCache
+    && m_footprintCache == 0.0)) {
     m_cachedValue = m_pSourceModule[0]->GetValue (x, y);
     m_xCache = x;
     m_yCache = y;
+    m_footprintCache = 0.0;
   }
   m_isCached = true;
   return m_cachedValue;
 }
+
+double Cache::GetValue (double x, double y, double footprint) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  // All footprints of 0.0 or less request full detail, so they share the
+  // cached output value of GetValue (x, y).
+  if (footprint < 0.0) {
+    footprint = 0.0;
+  }
+  if (!(m_isCached && x == m_xCache && y == m_yCache
+    && footprint == m_footprintCache)) {
+    m_cachedValue = m_pSourceModule[0]->GetValue (x, y, footprint);
+    m_xCache = x;
+    m_yCache = y;
+    m_footprintCache = footprint;
+  }
+  m_isCached = true;
+  return m_cachedValue;
+}
+
+void Cache::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  for (size_t i = 0; i < n; i += BATCH_BLOCK_SIZE) {
+    size_t count = GetMin (n - i, (size_t)BATCH_BLOCK_SIZE);
+    const double* x = xs + i;
+    const double* y = ys + i;
+    bool isCached = (count == m_blockCount);
+    for (size_t j = 0; j < count && isCached; j++) {
+      isCached = (x[j] == m_xBlock[j] && y[j] == m_yBlock[j]);
+    }
+    if (!isCached) {
+      m_pSourceModule[0]->GetValues (x, y, m_valueBlock, count);
+      for (size_t j = 0; j < count; j++) {
+        m_xBlock[j] = x[j];
+        m_yBlock[j] = y[j];
+      }
+      m_blockCount = count;
+    }
+    for (size_t j = 0; j < count; j++) {
+      out[i + j] = m_valueBlock[j];
+    }
+  }
+
+  // Keep the last value of the buffer, so that a following call to
+  // GetValue() at the same position can use it.
+  if (n > 0) {
+    m_cachedValue = out[n - 1];
+    m_xCache = xs[n - 1];
+    m_yCache = ys[n - 1];
+    m_footprintCache = 0.0;
+    m_isCached = true;
+  }
+}
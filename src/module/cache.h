@@ -56,6 +56,15 @@ namespace noise
     /// module returns the cached output value without having the source
     /// module recalculate the output value.
     ///
+    /// The footprint passed to GetValue (x, y, footprint) is part of the
+    /// cached input value.
+    ///
+    /// GetValues() caches the last block of up to
+    /// noise::module::BATCH_BLOCK_SIZE input values in the same way.  A
+    /// block is only reused if all of its input values are equal to those
+    /// of the cached block, as when several noise modules that share this
+    /// noise module pass the same block to it.
+    ///
     /// If an application passes a new source module to the SetSourceModule()
     /// method, the cache is invalidated.
     ///
@@ -80,17 +89,38 @@ namespace noise
 
         virtual double GetValue (double x, double y) const;
 
+        virtual double GetValue (double x, double y, double footprint) const;
+
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
+
         virtual void SetSourceModule (int index, const Module& sourceModule)
         {
           Module::SetSourceModule (index, sourceModule);
           m_isCached = false;
+          m_blockCount = 0;
         }
 
       protected:
 
+        /// Number of input values of the cached block.
+        mutable size_t m_blockCount;
+
+        /// The cached output values of the cached block.
+        mutable double m_valueBlock[BATCH_BLOCK_SIZE];
+
+        /// @a x coordinates of the input values of the cached block.
+        mutable double m_xBlock[BATCH_BLOCK_SIZE];
+
+        /// @a y coordinates of the input values of the cached block.
+        mutable double m_yBlock[BATCH_BLOCK_SIZE];
+
         /// The cached output value at the cached input value.
         mutable double m_cachedValue;
 
+        /// Footprint of the cached output value, 0.0 for full detail.
+        mutable double m_footprintCache;
+
         /// Determines if a cached output value is stored in this noise
         /// module.
         mutable double m_isCached;
@@ -29,10 +29,17 @@ Checkerboard::Checkerboard ():
 {
 }
 
-double Checkerboard::GetValue (double x, double y, double z) const
+double Checkerboard::GetValue (double x, double y) const
 {
   int ix = (int)(floor (MakeInt32Range (x)));
   int iy = (int)(floor (MakeInt32Range (y)));
-  int iz = (int)(floor (MakeInt32Range (z)));
-  return (ix & 1 ^ iy & 1 ^ iz & 1)? -1.0: 1.0;
+  return (ix & 1 ^ iy & 1)? -1.0: 1.0;
+}
+
+void Checkerboard::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  for (size_t i = 0; i < n; i++) {
+    out[i] = Checkerboard::GetValue (xs[i], ys[i]);
+  }
 }
@@ -46,6 +46,20 @@ double Clamp::GetValue (double x, double y) const
   }
 }
 
+double Clamp::GetValue (double x, double y, double footprint) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  double value = m_pSourceModule[0]->GetValue (x, y, footprint);
+  if (value < m_lowerBound) {
+    return m_lowerBound;
+  } else if (value > m_upperBound) {
+    return m_upperBound;
+  } else {
+    return value;
+  }
+}
+
 void Clamp::SetBounds (double lowerBound, double upperBound)
 {
   assert (lowerBound < upperBound);
@@ -53,3 +67,18 @@ void Clamp::SetBounds (double lowerBound, double upperBound)
   m_lowerBound = lowerBound;
   m_upperBound = upperBound;
 }
+
+void Clamp::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  m_pSourceModule[0]->GetValues (xs, ys, out, n);
+  for (size_t i = 0; i < n; i++) {
+    if (out[i] < m_lowerBound) {
+      out[i] = m_lowerBound;
+    } else if (out[i] > m_upperBound) {
+      out[i] = m_upperBound;
+    }
+  }
+}
@@ -0,0 +1,969 @@
+// codegenerator.cpp
+//
+// Copyright (C) 2026 libnoise2d contributors
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include <cfloat>
+#include <sstream>
+#include <typeinfo>
+#include "../misc.h"
+#include "../noisegenscalar.h"
+#include "abs.h"
+#include "add.h"
+#include "billow.h"
+#include "blend.h"
+#include "cache.h"
+#include "checkerboard.h"
+#include "clamp.h"
+#include "codegenerator.h"
+#include "const.h"
+#include "curve.h"
+#include "cylinders.h"
+#include "displace.h"
+#include "exponent.h"
+#include "fractal.h"
+#include "invert.h"
+#include "max.h"
+#include "min.h"
+#include "multiply.h"
+#include "perlin.h"
+#include "power.h"
+#include "ridgedmulti.h"
+#include "rotatepoint.h"
+#include "scalebias.h"
+#include "scalepoint.h"
+#include "select.h"
+#include "simplex.h"
+#include "spheres.h"
+#include "terrace.h"
+#include "translatepoint.h"
+#include "turbulence.h"
+
+using namespace noise;
+using namespace noise::module;
+
+namespace
+{
+
+  // Gain and offset of ridged-multifractal noise, see RidgedSignal.
+  const double RIDGED_GAIN = 2.0;
+  const double RIDGED_OFFSET = 1.0;
+
+  // Returns a floating-point literal that reads back as exactly @a value.
+  std::string Literal (double value)
+  {
+    if (!(value >= -DBL_MAX && value <= DBL_MAX)) {
+      throw noise::ExceptionInvalidParam ();
+    }
+    std::ostringstream os;
+    os.precision (17);
+    os << value;
+    std::string literal = os.str ();
+    if (literal.find_first_of (".e") == std::string::npos) {
+      literal += ".0";
+    }
+    return (literal[0] == '-')? "(" + literal + ")": literal;
+  }
+
+  // Returns an integer literal.
+  std::string Literal (int value)
+  {
+    std::ostringstream os;
+    os << value;
+    return (value < 0)? "(" + os.str () + ")": os.str ();
+  }
+
+  // Returns the name of a noise quality.
+  const char* QualityName (NoiseQuality noiseQuality)
+  {
+    switch (noiseQuality) {
+      case QUALITY_FAST:
+        return "noise::QUALITY_FAST";
+      case QUALITY_STD:
+        return "noise::QUALITY_STD";
+      case QUALITY_BEST:
+        return "noise::QUALITY_BEST";
+    }
+    return "noise::QUALITY_STD";
+  }
+
+  // Returns true if the coherent noise of a noise type is written inline by
+  // WriteNoiseFunctions().  Value noise with the xxHash hash is not.
+  bool IsInlineNoise (NoiseType noiseType)
+  {
+#ifdef VALUE_NOISE_USE_XXHASH
+    return (noiseType == TYPE_GRADIENT);
+#else
+    return (noiseType == TYPE_GRADIENT || noiseType == TYPE_VALUE);
+#endif
+  }
+
+  // Returns a call of the coherent-noise function of a noise type.  The
+  // lattice hash is the permutation table @a table if it is not empty, or
+  // the arithmetic hash of @a seed otherwise.  Like PeriodicNoise2D(),
+  // OpenSimplex noise is never periodic.
+  std::string NoiseCall (NoiseType noiseType, NoiseQuality noiseQuality,
+    const std::string& x, const std::string& y, int seed,
+    const std::string& table, int periodX, int periodY)
+  {
+    std::ostringstream os;
+    std::string hash = table.empty ()? Literal (seed): table;
+    bool periodic = (periodX > 0 || periodY > 0);
+    if (table.empty () && !periodic && IsInlineNoise (noiseType)) {
+      os << "GeneratedCoherentNoise2D (" << x << ", " << y << ", " << hash
+         << ", " << QualityName (noiseQuality) << ", "
+         << ((noiseType == TYPE_GRADIENT)? "true": "false") << ")";
+      return os.str ();
+    }
+    switch (noiseType) {
+      case TYPE_GRADIENT:
+        os << (periodic? "noise::GradientCoherentNoise2DPeriodic (":
+          "noise::GradientCoherentNoise2D (");
+        break;
+      case TYPE_VALUE:
+        os << (periodic? "noise::ValueCoherentNoise2DPeriodic (":
+          "noise::ValueCoherentNoise2D (");
+        break;
+      case TYPE_OPENSIMPLEX:
+        os << "noise::OpenSimplexNoise2D (" << x << ", " << y << ", " << hash
+          << ")";
+        return os.str ();
+    }
+    os << x << ", " << y << ", ";
+    if (periodic) {
+      os << Literal (periodX) << ", " << Literal (periodY) << ", ";
+    }
+    os << hash << ", " << QualityName (noiseQuality) << ")";
+    return os.str ();
+  }
+
+  // Writes the inline coherent-noise functions called by NoiseCall(), once
+  // per source file.  They are the same as GradientCoherentNoise2D() and
+  // ValueCoherentNoise2D() with the arithmetic hash, including the random
+  // gradient vectors, so the compiler can fold the seed and the noise
+  // quality of each octave.
+  void WriteNoiseFunctions (std::ostream& os)
+  {
+    os << "#ifndef NOISE_GENERATED_NOISE_FUNCTIONS\n"
+       << "#define NOISE_GENERATED_NOISE_FUNCTIONS\n"
+       << "\n"
+       << "namespace\n"
+       << "{\n"
+       << "\n"
+       << "  const double g_generatedRandomVectors[512] = {\n";
+    for (int i = 0; i < 512; i++) {
+      os << (((i & 3) == 0)? "    ": " ") << Literal (g_randomVectors[i])
+         << ((i < 511)? ",": "") << (((i & 3) == 3)? "\n": "");
+    }
+    os << "  };\n"
+       << "\n"
+       << "  // Same as noise::GradientNoise2D() or noise::ValueNoise2D().\n"
+       << "  inline double GeneratedNoise2D (double fx, double fy, int ix,"
+       << " int iy,\n"
+       << "    int seed, bool gradient)\n"
+       << "  {\n"
+       << "    noise::uint32 n = (\n"
+       << "        " << Literal (X_NOISE_GEN) << " * (noise::uint32)ix\n"
+       << "      + " << Literal (Y_NOISE_GEN) << " * (noise::uint32)iy\n"
+       << "      + " << Literal (SEED_NOISE_GEN) << " * (noise::uint32)seed);\n"
+       << "    if (gradient) {\n"
+       << "      n ^= (n >> " << Literal (SHIFT_NOISE_GEN) << ");\n"
+       << "      const double* vector = &g_generatedRandomVectors"
+       << "[(n & 0xff) << 1];\n"
+       << "      return ((vector[0] * (fx - (double)ix))\n"
+       << "            + (vector[1] * (fy - (double)iy))) * "
+       << Literal (SQRT1_2) << ";\n"
+       << "    }\n"
+       << "    n &= 0x7fffffff;\n"
+       << "    n = (n >> 13) ^ n;\n"
+       << "    return 1.0 - ((double)(int)((n * (n * n * 60493 + 19990303)"
+       << " + 1376312589)\n"
+       << "      & 0x7fffffff) / 1073741824.0);\n"
+       << "  }\n"
+       << "\n"
+       << "  // Same as noise::GradientCoherentNoise2D() or\n"
+       << "  // noise::ValueCoherentNoise2D().\n"
+       << "  inline double GeneratedCoherentNoise2D (double x, double y,"
+       << " int seed,\n"
+       << "    noise::NoiseQuality noiseQuality, bool gradient)\n"
+       << "  {\n"
+       << "    int x0 = (x > 0.0? (int)x: (int)x - 1);\n"
+       << "    int x1 = x0 + 1;\n"
+       << "    int y0 = (y > 0.0? (int)y: (int)y - 1);\n"
+       << "    int y1 = y0 + 1;\n"
+       << "    double xs = (x - (double)x0);\n"
+       << "    double ys = (y - (double)y0);\n"
+       << "    if (noiseQuality == noise::QUALITY_STD) {\n"
+       << "      xs = (xs * xs * (3.0 - 2.0 * xs));\n"
+       << "      ys = (ys * ys * (3.0 - 2.0 * ys));\n"
+       << "    } else if (noiseQuality == noise::QUALITY_BEST) {\n"
+       << "      double a3 = xs * xs * xs;\n"
+       << "      double b3 = ys * ys * ys;\n"
+       << "      xs = (6.0 * (a3 * xs * xs)) - (15.0 * (a3 * xs))"
+       << " + (10.0 * a3);\n"
+       << "      ys = (6.0 * (b3 * ys * ys)) - (15.0 * (b3 * ys))"
+       << " + (10.0 * b3);\n"
+       << "    }\n"
+       << "    double n0, n1, ix0, ix1;\n"
+       << "    n0  = GeneratedNoise2D (x, y, x0, y0, seed, gradient);\n"
+       << "    n1  = GeneratedNoise2D (x, y, x1, y0, seed, gradient);\n"
+       << "    ix0 = ((1.0 - xs) * n0) + (xs * n1);\n"
+       << "    n0  = GeneratedNoise2D (x, y, x0, y1, seed, gradient);\n"
+       << "    n1  = GeneratedNoise2D (x, y, x1, y1, seed, gradient);\n"
+       << "    ix1 = ((1.0 - xs) * n0) + (xs * n1);\n"
+       << "    return ((1.0 - ys) * ix0) + (ys * ix1);\n"
+       << "  }\n"
+       << "\n"
+       << "}\n"
+       << "\n"
+       << "#endif\n";
+  }
+
+  // Returns the expression of LinearInterp().
+  std::string LinearInterpCode (const std::string& n0, const std::string& n1,
+    const std::string& a)
+  {
+    return "((1.0 - " + a + ") * " + n0 + ") + (" + a + " * " + n1 + ")";
+  }
+
+}
+
+CodeGenerator::CodeGenerator ():
+  m_depth (0),
+  m_variableCount (0)
+{
+}
+
+void CodeGenerator::CloseBlock (std::ostream& os)
+{
+  // The noise modules generated within the block are out of scope.
+  while (!m_generatedNodes.empty ()
+    && m_generatedNodes.back ().depth == m_depth) {
+    m_generatedNodes.pop_back ();
+  }
+  --m_depth;
+  os << Indent () << "}\n";
+}
+
+void CodeGenerator::Generate (const Module& root, const char* functionName,
+  std::ostream& os)
+{
+  m_generatedNodes.clear ();
+  m_inputAxes.clear ();
+  m_depth = 1;
+  m_variableCount = 2;
+
+  // Write the body first, so that nothing is written if a noise module
+  // cannot be generated.
+  std::ostringstream body;
+  int axes = GetInputAxes (root);
+  int result = GenerateModule (body, root, X_VARIABLE, Y_VARIABLE);
+  m_generatedNodes.clear ();
+  m_inputAxes.clear ();
+
+  os << "// Generated by noise::module::CodeGenerator.\n"
+     << "#include <cmath>\n"
+     << "#include \"noisegen.h\"\n"
+     << "\n";
+  WriteNoiseFunctions (os);
+  os << "\n"
+     << "double " << functionName << " (double x, double y)\n"
+     << "{\n";
+  if (!(axes & AXIS_X)) {
+    os << "  (void)x;\n";
+  }
+  if (!(axes & AXIS_Y)) {
+    os << "  (void)y;\n";
+  }
+  os << body.str ()
+     << "  return " << Variable (result) << ";\n"
+     << "}\n";
+}
+
+int CodeGenerator::GenerateFractal (std::ostream& os,
+  const FractalParams& params, FractalSignal signal, int octaveCount,
+  double tolerance, int xVariable, int yVariable)
+{
+  int result = NewVariable ();
+  os << Indent () << "double " << Variable (result) << ";\n";
+  OpenBlock (os, "");
+  os << Indent () << "double nx = " << Variable (xVariable) << " * "
+     << Literal (params.frequency) << ";\n"
+     << Indent () << "double ny = " << Variable (yVariable) << " * "
+     << Literal (params.frequency) << ";\n"
+     << Indent () << "double value = 0.0;\n"
+     << Indent () << "double signal;\n";
+
+  // The octaves of ridged-multifractal noise stop per input value if a
+  // tolerance is set, see RidgedSignal::CanStop().
+  bool canStop = (signal == SIGNAL_RIDGED && tolerance > 0.0);
+  if (signal == SIGNAL_RIDGED) {
+    os << Indent () << "double weight = 1.0;\n";
+  }
+  if (canStop) {
+    os << Indent () << "static const double spectralWeights[] = {";
+    for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+      os << ((curOctave > 0)? ", ": "")
+         << Literal (params.pSpectralWeights[curOctave]);
+    }
+    os << "};\n";
+  }
+  if (params.pPermutationTables != NULL) {
+    for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+      os << Indent () << "static const noise::PermutationTable table"
+         << curOctave << " ("
+         << Literal ((params.seed + curOctave) & params.seedMask) << ");\n";
+    }
+  }
+  if (canStop) {
+    OpenBlock (os, "do ");
+  }
+
+  double amplitude = 1.0;
+  double periodScale = 1.0;
+  for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+    std::ostringstream table;
+    if (params.pPermutationTables != NULL) {
+      table << "table" << curOctave;
+    }
+    int seed = (params.seed + curOctave) & params.seedMask;
+    if (signal == SIGNAL_SIMPLEX) {
+      os << Indent () << "signal = noise::SimplexNoise2D ("
+         << "noise::MakeInt32Range (nx), noise::MakeInt32Range (ny), "
+         << Literal (seed) << ");\n";
+    } else {
+      os << Indent () << "signal = " << NoiseCall (params.noiseType,
+        params.noiseQuality, "noise::MakeInt32Range (nx)",
+        "noise::MakeInt32Range (ny)", seed, table.str (),
+        ScalePeriod (params.periodX, periodScale),
+        ScalePeriod (params.periodY, periodScale)) << ";\n";
+    }
+
+    switch (signal) {
+      case SIGNAL_PERLIN:
+      case SIGNAL_SIMPLEX:
+        os << Indent () << "value += signal * " << Literal (amplitude)
+           << ";\n";
+        break;
+      case SIGNAL_BILLOW:
+        os << Indent () << "signal = 2.0 * fabs (signal) - 1.0;\n"
+           << Indent () << "value += signal * " << Literal (amplitude)
+           << ";\n";
+        break;
+      case SIGNAL_RIDGED:
+        os << Indent () << "signal = " << Literal (RIDGED_OFFSET)
+           << " - fabs (signal);\n"
+           << Indent () << "signal *= signal;\n"
+           << Indent () << "signal *= weight;\n"
+           << Indent () << "weight = signal * " << Literal (RIDGED_GAIN)
+           << ";\n"
+           << Indent () << "if (weight > 1.0) {\n"
+           << Indent () << "  weight = 1.0;\n"
+           << Indent () << "}\n"
+           << Indent () << "if (weight < 0.0) {\n"
+           << Indent () << "  weight = 0.0;\n"
+           << Indent () << "}\n"
+           << Indent () << "value += signal * "
+           << Literal (params.pSpectralWeights[curOctave]) << ";\n";
+        break;
+    }
+    amplitude *= params.persistence;
+
+    if (curOctave + 1 < octaveCount) {
+      if (canStop) {
+        std::string maxSignal = "weight * " + Literal (RIDGED_OFFSET) + " * "
+          + Literal (RIDGED_OFFSET);
+        OpenBlock (os, "");
+        os << Indent () << "double bound = 0.0;\n"
+           << Indent () << "double maxSignal = " << maxSignal << ";\n";
+        OpenBlock (os, "for (int nextOctave = " + Literal (curOctave + 1)
+          + "; nextOctave < " + Literal (octaveCount) + " && bound < "
+          + Literal (tolerance) + "; nextOctave++) ");
+        os << Indent () << "bound += maxSignal * spectralWeights[nextOctave]"
+           << " * " << Literal (fabs (params.norm)) << ";\n"
+           << Indent () << "maxSignal = ((maxSignal * "
+           << Literal (RIDGED_GAIN) << " < 1.0)? maxSignal * "
+           << Literal (RIDGED_GAIN) << ": 1.0) * " << Literal (RIDGED_OFFSET)
+           << " * " << Literal (RIDGED_OFFSET) << ";\n";
+        CloseBlock (os);
+        os << Indent () << "if (bound < " << Literal (tolerance) << ") {\n"
+           << Indent () << "  break;\n"
+           << Indent () << "}\n";
+        CloseBlock (os);
+      }
+      os << Indent () << "nx *= " << Literal (params.lacunarity) << ";\n"
+         << Indent () << "ny *= " << Literal (params.lacunarity) << ";\n";
+      periodScale *= params.lacunarity;
+    }
+  }
+
+  if (canStop) {
+    --m_depth;
+    os << Indent () << "} while (false);\n";
+  }
+  os << Indent () << Variable (result) << " = value";
+  if (signal != SIGNAL_SIMPLEX) {
+    os << " * " << Literal (params.norm);
+  }
+  os << ((signal == SIGNAL_RIDGED)? " * -1.0;\n": ";\n");
+  CloseBlock (os);
+  return result;
+}
+
+int CodeGenerator::GenerateModule (std::ostream& os, const Module& module,
+  int xVariable, int yVariable)
+{
+  // Reuse the output value of a noise module that has already been
+  // generated for the same input value in this block or an enclosing one.
+  for (size_t i = 0; i < m_generatedNodes.size (); i++) {
+    const GeneratedNode& node = m_generatedNodes[i];
+    if (node.pModule == &module && node.xVariable == xVariable
+      && node.yVariable == yVariable) {
+      return node.result;
+    }
+  }
+
+  std::string x = Variable (xVariable);
+  std::string y = Variable (yVariable);
+  std::ostringstream expression;
+  int result = -1;
+
+  // Only noise modules of exactly these classes are generated.  A subclass
+  // may override the output values, which cannot be written as code.
+  if (typeid (module) == typeid (Cache)) {
+    // Reusing generated noise modules already caches the output values.
+    result = GenerateModule (os, module.GetSourceModule (0), xVariable,
+      yVariable);
+  } else if (typeid (module) == typeid (Const)) {
+    const Const* pConst = static_cast<const Const*> (&module);
+    expression << Literal (pConst->GetConstValue ());
+  } else if (typeid (module) == typeid (Add)
+    || typeid (module) == typeid (Multiply)
+    || typeid (module) == typeid (Max)
+    || typeid (module) == typeid (Min)
+    || typeid (module) == typeid (Power)) {
+    std::string v0 = Variable (GenerateModule (os,
+      module.GetSourceModule (0), xVariable, yVariable));
+    std::string v1 = Variable (GenerateModule (os,
+      module.GetSourceModule (1), xVariable, yVariable));
+    if (typeid (module) == typeid (Add)) {
+      expression << v0 << " + " << v1;
+    } else if (typeid (module) == typeid (Multiply)) {
+      expression << v0 << " * " << v1;
+    } else if (typeid (module) == typeid (Max)) {
+      expression << "(" << v0 << " > " << v1 << ")? " << v0 << ": " << v1;
+    } else if (typeid (module) == typeid (Min)) {
+      expression << "(" << v0 << " < " << v1 << ")? " << v0 << ": " << v1;
+    } else {
+      expression << "pow (" << v0 << ", " << v1 << ")";
+    }
+  } else if (typeid (module) == typeid (Abs)) {
+    expression << "fabs (" << Variable (GenerateModule (os,
+      module.GetSourceModule (0), xVariable, yVariable)) << ")";
+  } else if (typeid (module) == typeid (Invert)) {
+    expression << "-" << Variable (GenerateModule (os,
+      module.GetSourceModule (0), xVariable, yVariable));
+  } else if (typeid (module) == typeid (ScaleBias)) {
+    const ScaleBias* pScaleBias = static_cast<const ScaleBias*> (&module);
+    expression << Variable (GenerateModule (os, module.GetSourceModule (0),
+      xVariable, yVariable)) << " * " << Literal (pScaleBias->GetScale ())
+      << " + " << Literal (pScaleBias->GetBias ());
+  } else if (typeid (module) == typeid (Clamp)) {
+    const Clamp* pClamp = static_cast<const Clamp*> (&module);
+    std::string v = Variable (GenerateModule (os, module.GetSourceModule (0),
+      xVariable, yVariable));
+    std::string lowerBound = Literal (pClamp->GetLowerBound ());
+    std::string upperBound = Literal (pClamp->GetUpperBound ());
+    expression << "(" << v << " < " << lowerBound << ")? " << lowerBound
+      << ": ((" << v << " > " << upperBound << ")? " << upperBound << ": "
+      << v << ")";
+  } else if (typeid (module) == typeid (Exponent)) {
+    const Exponent* pExponent = static_cast<const Exponent*> (&module);
+    expression << "pow (fabs ((" << Variable (GenerateModule (os,
+      module.GetSourceModule (0), xVariable, yVariable)) << " + 1.0) / 2.0), "
+      << Literal (pExponent->GetExponent ()) << ") * 2.0 - 1.0";
+  } else if (typeid (module) == typeid (Curve)) {
+    const Curve* pCurve = static_cast<const Curve*> (&module);
+    // Map the output value of the source module onto the curve, with one
+    // branch per pair of control points; see Curve::GetCurveValue().
+    int count = pCurve->GetControlPointCount ();
+    if (count < 4) {
+      throw noise::ExceptionInvalidParam ();
+    }
+    const ControlPoint* pControlPoints = pCurve->GetControlPointArray ();
+    std::string v = Variable (GenerateModule (os, module.GetSourceModule (0),
+      xVariable, yVariable));
+    result = NewVariable ();
+    os << Indent () << "double " << Variable (result) << ";\n";
+    for (int indexPos = 0; indexPos <= count; indexPos++) {
+      if (indexPos == 0) {
+        os << Indent () << "if (" << v << " < "
+           << Literal (pControlPoints[0].inputValue) << ") {\n";
+      } else if (indexPos < count) {
+        os << Indent () << "} else if (" << v << " < "
+           << Literal (pControlPoints[indexPos].inputValue) << ") {\n";
+      } else {
+        os << Indent () << "} else {\n";
+      }
+      ++m_depth;
+      int index0 = ClampValue (indexPos - 2, 0, count - 1);
+      int index1 = ClampValue (indexPos - 1, 0, count - 1);
+      int index2 = ClampValue (indexPos    , 0, count - 1);
+      int index3 = ClampValue (indexPos + 1, 0, count - 1);
+      if (index1 == index2) {
+        os << Indent () << Variable (result) << " = "
+           << Literal (pControlPoints[index1].outputValue) << ";\n";
+      } else {
+        double input0 = pControlPoints[index1].inputValue;
+        double input1 = pControlPoints[index2].inputValue;
+        double n0 = pControlPoints[index0].outputValue;
+        double n1 = pControlPoints[index1].outputValue;
+        double n2 = pControlPoints[index2].outputValue;
+        double n3 = pControlPoints[index3].outputValue;
+        double p = (n3 - n2) - (n0 - n1);
+        double q = (n0 - n1) - p;
+        double r = n2 - n0;
+        os << Indent () << "double alpha = (" << v << " - " << Literal (input0)
+           << ") / " << Literal (input1 - input0) << ";\n"
+           << Indent () << Variable (result) << " = " << Literal (p)
+           << " * alpha * alpha * alpha + " << Literal (q)
+           << " * alpha * alpha + " << Literal (r) << " * alpha + "
+           << Literal (n1) << ";\n";
+      }
+      --m_depth;
+    }
+    os << Indent () << "}\n";
+  } else if (typeid (module) == typeid (Terrace)) {
+    const Terrace* pTerrace = static_cast<const Terrace*> (&module);
+    // Same as Curve, see Terrace::GetTerraceValue().
+    int count = pTerrace->GetControlPointCount ();
+    if (count < 2) {
+      throw noise::ExceptionInvalidParam ();
+    }
+    const double* pControlPoints = pTerrace->GetControlPointArray ();
+    std::string v = Variable (GenerateModule (os, module.GetSourceModule (0),
+      xVariable, yVariable));
+    result = NewVariable ();
+    os << Indent () << "double " << Variable (result) << ";\n";
+    for (int indexPos = 0; indexPos <= count; indexPos++) {
+      if (indexPos == 0) {
+        os << Indent () << "if (" << v << " < "
+           << Literal (pControlPoints[0]) << ") {\n";
+      } else if (indexPos < count) {
+        os << Indent () << "} else if (" << v << " < "
+           << Literal (pControlPoints[indexPos]) << ") {\n";
+      } else {
+        os << Indent () << "} else {\n";
+      }
+      ++m_depth;
+      int index0 = ClampValue (indexPos - 1, 0, count - 1);
+      int index1 = ClampValue (indexPos    , 0, count - 1);
+      if (index0 == index1) {
+        os << Indent () << Variable (result) << " = "
+           << Literal (pControlPoints[index1]) << ";\n";
+      } else {
+        double value0 = pControlPoints[index0];
+        double value1 = pControlPoints[index1];
+        os << Indent () << "double alpha = (" << v << " - " << Literal (value0)
+           << ") / " << Literal (value1 - value0) << ";\n";
+        if (pTerrace->IsTerracesInverted ()) {
+          os << Indent () << "alpha = 1.0 - alpha;\n";
+          SwapValues (value0, value1);
+        }
+        os << Indent () << "alpha *= alpha;\n"
+           << Indent () << Variable (result) << " = " << LinearInterpCode (
+             Literal (value0), Literal (value1), "alpha") << ";\n";
+      }
+      --m_depth;
+    }
+    os << Indent () << "}\n";
+  } else if (typeid (module) == typeid (Checkerboard)) {
+    expression << "(((int)(floor (noise::MakeInt32Range (" << x
+      << "))) & 1) ^ ((int)(floor (noise::MakeInt32Range (" << y
+      << "))) & 1))? -1.0: 1.0";
+  } else if (typeid (module) == typeid (Cylinders)
+    || typeid (module) == typeid (Spheres)) {
+    // See Cylinders::GetValue() and Spheres::GetValue().
+    result = NewVariable ();
+    os << Indent () << "double " << Variable (result) << ";\n";
+    OpenBlock (os, "");
+    if (typeid (module) == typeid (Cylinders)) {
+      const Cylinders* pCylinders = static_cast<const Cylinders*> (&module);
+      os << Indent () << "double distFromCenter = fabs (" << x << " * "
+         << Literal (pCylinders->GetFrequency ()) << ");\n";
+    } else {
+      std::string frequency = Literal (
+        static_cast<const Spheres*> (&module)->GetFrequency ());
+      os << Indent () << "double sx = " << x << " * " << frequency << ";\n"
+         << Indent () << "double sy = " << y << " * " << frequency << ";\n"
+         << Indent () << "double distFromCenter = sqrt (sx * sx + sy * sy);\n";
+    }
+    os << Indent () << "double distFromSmallerSphere = distFromCenter"
+       << " - floor (distFromCenter);\n"
+       << Indent () << "double distFromLargerSphere = 1.0"
+       << " - distFromSmallerSphere;\n"
+       << Indent () << "double nearestDist = (distFromSmallerSphere"
+       << " < distFromLargerSphere)? distFromSmallerSphere:"
+       << " distFromLargerSphere;\n"
+       << Indent () << Variable (result) << " = 1.0 - (nearestDist * 4.0);\n";
+    CloseBlock (os);
+  } else if (typeid (module) == typeid (Perlin)) {
+    const Perlin* pPerlin = static_cast<const Perlin*> (&module);
+    FractalParams params = pPerlin->GetFractalParams ();
+    result = GenerateFractal (os, params, SIGNAL_PERLIN,
+      ToleranceOctaveCount (params.persistence, params.norm,
+      pPerlin->m_octaveCountTmp, pPerlin->m_tolerance),
+      pPerlin->m_tolerance, xVariable, yVariable);
+  } else if (typeid (module) == typeid (Billow)) {
+    const Billow* pBillow = static_cast<const Billow*> (&module);
+    FractalParams params = pBillow->GetFractalParams ();
+    result = GenerateFractal (os, params, SIGNAL_BILLOW,
+      ToleranceOctaveCount (params.persistence, params.norm,
+      pBillow->m_octaveCountTmp, pBillow->m_tolerance),
+      pBillow->m_tolerance, xVariable, yVariable);
+  } else if (typeid (module) == typeid (Simplex)) {
+    // Simplex sums its octaves like Perlin, without a period, a hash or a
+    // normalisation; see Simplex::GetValue().
+    const Simplex* pSimplex = static_cast<const Simplex*> (&module);
+    FractalParams params;
+    params.frequency          = pSimplex->GetFrequency ();
+    params.lacunarity         = pSimplex->GetLacunarity ();
+    params.persistence        = pSimplex->GetPersistence ();
+    params.norm               = 1.0;
+    params.seed               = pSimplex->GetSeed ();
+    params.seedMask           = 0xffffffff;
+    params.periodX            = 0;
+    params.periodY            = 0;
+    params.noiseType          = TYPE_GRADIENT;
+    params.noiseQuality       = QUALITY_STD;
+    params.pPermutationTables = NULL;
+    params.pSpectralWeights   = NULL;
+    result = GenerateFractal (os, params, SIGNAL_SIMPLEX,
+      pSimplex->m_octaveCountTmp, 0.0, xVariable, yVariable);
+  } else if (typeid (module) == typeid (RidgedMulti)) {
+    const RidgedMulti* pRidgedMulti =
+      static_cast<const RidgedMulti*> (&module);
+    result = GenerateFractal (os, pRidgedMulti->GetFractalParams (),
+      SIGNAL_RIDGED, pRidgedMulti->m_octaveCountTmp,
+      pRidgedMulti->m_tolerance, xVariable, yVariable);
+  } else if (typeid (module) == typeid (ScalePoint)) {
+    const ScalePoint* pScalePoint = static_cast<const ScalePoint*> (&module);
+    // A coordinate that the source module does not read keeps the variable
+    // of the input value, which is not read either.
+    int axes = GetInputAxes (module.GetSourceModule (0));
+    int nx = xVariable;
+    int ny = yVariable;
+    if (axes & AXIS_X) {
+      nx = NewVariable ();
+      os << Indent () << "double " << Variable (nx) << " = " << x << " * "
+         << Literal (pScalePoint->GetXScale ()) << ";\n";
+    }
+    if (axes & AXIS_Y) {
+      ny = NewVariable ();
+      os << Indent () << "double " << Variable (ny) << " = " << y << " * "
+         << Literal (pScalePoint->GetYScale ()) << ";\n";
+    }
+    result = GenerateModule (os, module.GetSourceModule (0), nx, ny);
+  } else if (typeid (module) == typeid (TranslatePoint)) {
+    const TranslatePoint* pTranslatePoint =
+      static_cast<const TranslatePoint*> (&module);
+    int axes = GetInputAxes (module.GetSourceModule (0));
+    int nx = xVariable;
+    int ny = yVariable;
+    if (axes & AXIS_X) {
+      nx = NewVariable ();
+      os << Indent () << "double " << Variable (nx) << " = " << x << " + "
+         << Literal (pTranslatePoint->GetXTranslation ()) << ";\n";
+    }
+    if (axes & AXIS_Y) {
+      ny = NewVariable ();
+      os << Indent () << "double " << Variable (ny) << " = " << y << " + "
+         << Literal (pTranslatePoint->GetYTranslation ()) << ";\n";
+    }
+    result = GenerateModule (os, module.GetSourceModule (0), nx, ny);
+  } else if (typeid (module) == typeid (RotatePoint)) {
+    const RotatePoint* pRotatePoint =
+      static_cast<const RotatePoint*> (&module);
+    int axes = GetInputAxes (module.GetSourceModule (0));
+    int nx = xVariable;
+    int ny = yVariable;
+    if (axes & AXIS_X) {
+      nx = NewVariable ();
+      os << Indent () << "double " << Variable (nx) << " = ("
+         << Literal (pRotatePoint->m_x1Matrix) << " * " << x << ") + ("
+         << Literal (pRotatePoint->m_y1Matrix) << " * " << y << ");\n";
+    }
+    if (axes & AXIS_Y) {
+      ny = NewVariable ();
+      os << Indent () << "double " << Variable (ny) << " = ("
+         << Literal (pRotatePoint->m_x2Matrix) << " * " << x << ") + ("
+         << Literal (pRotatePoint->m_y2Matrix) << " * " << y << ");\n";
+    }
+    result = GenerateModule (os, module.GetSourceModule (0), nx, ny);
+  } else if (typeid (module) == typeid (Displace)) {
+    // The displacement module of a coordinate that the source module does
+    // not read is not generated.
+    int axes = GetInputAxes (module.GetSourceModule (0));
+    int nx = xVariable;
+    int ny = yVariable;
+    if (axes & AXIS_X) {
+      std::string xDisplace = Variable (GenerateModule (os,
+        module.GetSourceModule (1), xVariable, yVariable));
+      nx = NewVariable ();
+      os << Indent () << "double " << Variable (nx) << " = " << x << " + "
+         << xDisplace << ";\n";
+    }
+    if (axes & AXIS_Y) {
+      std::string yDisplace = Variable (GenerateModule (os,
+        module.GetSourceModule (2), xVariable, yVariable));
+      ny = NewVariable ();
+      os << Indent () << "double " << Variable (ny) << " = " << y << " + "
+         << yDisplace << ";\n";
+    }
+    result = GenerateModule (os, module.GetSourceModule (0), nx, ny);
+  } else if (typeid (module) == typeid (Turbulence)) {
+    const Turbulence* pTurbulence = static_cast<const Turbulence*> (&module);
+    // Both channels of the Perlin noise are generated in one octave loop,
+    // see Turbulence::GetValue() and VectorPerlin.
+    FractalParams params = pTurbulence->m_distortModule.GetFractalParams ();
+    int octaveCount = pTurbulence->GetEffectiveRoughness ();
+    std::string power = Literal (pTurbulence->GetPower ());
+    // Only the channels of the coordinates that the source module reads
+    // are generated; the channels are independent of each other.
+    int axes = GetInputAxes (module.GetSourceModule (0));
+    if (axes == 0) {
+      result = GenerateModule (os, module.GetSourceModule (0), xVariable,
+        yVariable);
+    } else {
+      bool channels[2] = {(axes & AXIS_X) != 0, (axes & AXIS_Y) != 0};
+      int nx = xVariable;
+      int ny = yVariable;
+      if (channels[0]) {
+        nx = NewVariable ();
+        os << Indent () << "double " << Variable (nx) << ";\n";
+      }
+      if (channels[1]) {
+        ny = NewVariable ();
+        os << Indent () << "double " << Variable (ny) << ";\n";
+      }
+      OpenBlock (os, "");
+      os << Indent () << "double nx = (" << x << " + "
+         << Literal (12414.0 / 65536.0) << ") * " << Literal (params.frequency)
+         << ";\n"
+         << Indent () << "double ny = (" << y << " + "
+         << Literal (65124.0 / 65536.0) << ") * " << Literal (params.frequency)
+         << ";\n";
+      for (int channel = 0; channel < 2; channel++) {
+        if (channels[channel]) {
+          os << Indent () << "double value" << channel << " = 0.0;\n";
+        }
+      }
+      double amplitude = 1.0;
+      for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+        for (int channel = 0; channel < 2; channel++) {
+          if (!channels[channel]) {
+            continue;
+          }
+          os << Indent () << "value" << channel << " += " << NoiseCall (
+            params.noiseType, params.noiseQuality,
+            "noise::MakeInt32Range (nx)", "noise::MakeInt32Range (ny)",
+            (params.seed + channel + curOctave) & params.seedMask, "", 0, 0)
+            << " * " << Literal (amplitude) << ";\n";
+        }
+        amplitude *= params.persistence;
+        if (curOctave + 1 < octaveCount) {
+          os << Indent () << "nx *= " << Literal (params.lacunarity) << ";\n"
+             << Indent () << "ny *= " << Literal (params.lacunarity) << ";\n";
+        }
+      }
+      if (channels[0]) {
+        os << Indent () << Variable (nx) << " = " << x << " + ((value0 * "
+           << Literal (params.norm) << ") * " << power << ");\n";
+      }
+      if (channels[1]) {
+        os << Indent () << Variable (ny) << " = " << y << " + ((value1 * "
+           << Literal (params.norm) << ") * " << power << ");\n";
+      }
+      CloseBlock (os);
+      result = GenerateModule (os, module.GetSourceModule (0), nx, ny);
+    }
+  } else if (typeid (module) == typeid (Blend)) {
+    const Blend* pBlend = static_cast<const Blend*> (&module);
+    std::string v0 = Variable (GenerateModule (os,
+      pBlend->GetSourceModule (0), xVariable, yVariable));
+    std::string v1 = Variable (GenerateModule (os,
+      pBlend->GetSourceModule (1), xVariable, yVariable));
+    std::string alpha = Variable (GenerateModule (os,
+      pBlend->GetSourceModule (2), xVariable, yVariable));
+    expression << LinearInterpCode (v0, v1, "((" + alpha + " + 1.0) / 2.0)");
+  } else if (typeid (module) == typeid (Select)) {
+    const Select* pSelect = static_cast<const Select*> (&module);
+    // Choose the source modules from the control value first, so that each
+    // source module is only evaluated if it is needed; see
+    // Select::GetValue().  The mode is 0 or 1 for one of the source
+    // modules, 2 for a blend from source module 0 to 1 and 3 for a blend
+    // from source module 1 to 0.
+    std::string control = Variable (GenerateModule (os,
+      module.GetSourceModule (2), xVariable, yVariable));
+    double lowerBound = pSelect->GetLowerBound ();
+    double upperBound = pSelect->GetUpperBound ();
+    double edgeFalloff = pSelect->GetEdgeFalloff ();
+    std::string mode = Variable (NewVariable ());
+    std::string alpha = Variable (NewVariable ());
+    os << Indent () << "int " << mode << ";\n"
+       << Indent () << "double " << alpha << " = 0.0;\n";
+    if (edgeFalloff > 0.0) {
+      double lowerCurve[2] = {lowerBound - edgeFalloff,
+        upperBound - edgeFalloff};
+      double upperCurve[2] = {lowerBound + edgeFalloff,
+        upperBound + edgeFalloff};
+      std::string inner = Indent () + "  ";
+      os << Indent () << "if (" << control << " < "
+         << Literal (lowerCurve[0]) << ") {\n"
+         << inner << mode << " = 0;\n";
+      for (int edge = 0; edge < 2; edge++) {
+        os << Indent () << "} else if (" << control << " < "
+           << Literal (upperCurve[edge]) << ") {\n"
+           << inner << "double a = (" << control << " - "
+           << Literal (lowerCurve[edge]) << ") / "
+           << Literal (upperCurve[edge] - lowerCurve[edge]) << ";\n"
+           << inner << mode << " = " << (2 + edge) << ";\n"
+           << inner << alpha << " = (a * a * (3.0 - 2.0 * a));\n";
+        if (edge == 0) {
+          os << Indent () << "} else if (" << control << " < "
+             << Literal (lowerCurve[1]) << ") {\n"
+             << inner << mode << " = 1;\n";
+        }
+      }
+      os << Indent () << "} else {\n"
+         << inner << mode << " = 0;\n"
+         << Indent () << "}\n";
+    } else {
+      os << Indent () << mode << " = (" << control << " < "
+         << Literal (lowerBound) << " || " << control << " > "
+         << Literal (upperBound) << ")? 0: 1;\n";
+    }
+
+    std::string v[2];
+    for (int sourceIndex = 0; sourceIndex < 2; sourceIndex++) {
+      v[sourceIndex] = Variable (NewVariable ());
+      os << Indent () << "double " << v[sourceIndex] << " = 0.0;\n";
+      OpenBlock (os, "if (" + mode + " != " + Literal (1 - sourceIndex)
+        + ") ");
+      int source = GenerateModule (os, module.GetSourceModule (sourceIndex),
+        xVariable, yVariable);
+      os << Indent () << v[sourceIndex] << " = " << Variable (source)
+         << ";\n";
+      CloseBlock (os);
+    }
+    expression << "(" << mode << " == 0)? " << v[0] << ": ((" << mode
+      << " == 1)? " << v[1] << ": ((" << mode << " == 2)? "
+      << LinearInterpCode (v[0], v[1], alpha) << ": "
+      << LinearInterpCode (v[1], v[0], alpha) << "))";
+  } else {
+    throw noise::ExceptionInvalidParam ();
+  }
+
+  if (result < 0) {
+    result = NewVariable ();
+    os << Indent () << "double " << Variable (result) << " = "
+       << expression.str () << ";\n";
+  }
+
+  GeneratedNode node;
+  node.pModule = &module;
+  node.xVariable = xVariable;
+  node.yVariable = yVariable;
+  node.result = result;
+  node.depth = m_depth;
+  m_generatedNodes.push_back (node);
+  return result;
+}
+
+std::string CodeGenerator::Indent () const
+{
+  return std::string (2 * m_depth, ' ');
+}
+
+int CodeGenerator::GetInputAxes (const Module& module)
+{
+  for (size_t i = 0; i < m_inputAxes.size (); i++) {
+    if (m_inputAxes[i].pModule == &module) {
+      return m_inputAxes[i].axes;
+    }
+  }
+
+  int axes = 0;
+  if (typeid (module) == typeid (Const)) {
+    axes = 0;
+  } else if (typeid (module) == typeid (Cylinders)) {
+    // The cylinders are parallel to the y axis.
+    axes = AXIS_X;
+  } else if (typeid (module) == typeid (ScalePoint)
+    || typeid (module) == typeid (TranslatePoint)) {
+    axes = GetInputAxes (module.GetSourceModule (0));
+  } else if (typeid (module) == typeid (RotatePoint)
+    || typeid (module) == typeid (Turbulence)) {
+    // Each transformed coordinate depends on both coordinates.
+    if (GetInputAxes (module.GetSourceModule (0)) != 0) {
+      axes = AXIS_X | AXIS_Y;
+    }
+  } else if (typeid (module) == typeid (Displace)) {
+    int sourceAxes = GetInputAxes (module.GetSourceModule (0));
+    if (sourceAxes & AXIS_X) {
+      axes |= AXIS_X | GetInputAxes (module.GetSourceModule (1));
+    }
+    if (sourceAxes & AXIS_Y) {
+      axes |= AXIS_Y | GetInputAxes (module.GetSourceModule (2));
+    }
+  } else if (module.GetSourceModuleCount () == 0) {
+    axes = AXIS_X | AXIS_Y;
+  } else {
+    for (int i = 0; i < module.GetSourceModuleCount (); i++) {
+      axes |= GetInputAxes (module.GetSourceModule (i));
+    }
+  }
+
+  InputAxes inputAxes;
+  inputAxes.pModule = &module;
+  inputAxes.axes = axes;
+  m_inputAxes.push_back (inputAxes);
+  return axes;
+}
+
+int CodeGenerator::NewVariable ()
+{
+  return m_variableCount++;
+}
+
+void CodeGenerator::OpenBlock (std::ostream& os, const std::string& statement)
+{
+  os << Indent () << statement << "{\n";
+  ++m_depth;
+}
+
+std::string CodeGenerator::Variable (int variable) const
+{
+  if (variable == X_VARIABLE) {
+    return "x";
+  } else if (variable == Y_VARIABLE) {
+    return "y";
+  }
+  std::ostringstream os;
+  os << "v" << variable;
+  return os.str ();
+}
@@ -0,0 +1,210 @@
+// codegenerator.h
+//
+// Copyright (C) 2026 libnoise2d contributors
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#ifndef NOISE_MODULE_CODEGENERATOR_H
+#define NOISE_MODULE_CODEGENERATOR_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include "modulebase.h"
+
+namespace noise
+{
+
+  namespace module
+  {
+
+    struct FractalParams;
+
+    /// @addtogroup libnoise
+    /// @{
+
+    /// @addtogroup modules
+    /// @{
+
+    /// Generates the C++ source code of a function that outputs the values
+    /// of a graph of noise modules.
+    ///
+    /// Generate() writes a function <tt>double name (double x, double
+    /// y)</tt> that returns the same value as GetValue (x, y) of the root
+    /// module.  The settings of all noise modules, such as frequencies,
+    /// octave counts, seeds, control points and bounds, are written as
+    /// constants, and the octave loops are unrolled, so the compiler can
+    /// inline and fold the whole graph instead of calling GetValue() of
+    /// each noise module.  The function only calls the coherent-noise
+    /// functions of noisegen.h, so it can be compiled into an application
+    /// and linked against libnoise without the noise modules.
+    ///
+    /// The following noise modules can be generated:
+    /// noise::module::Abs, noise::module::Add, noise::module::Billow,
+    /// noise::module::Blend, noise::module::Cache,
+    /// noise::module::Checkerboard, noise::module::Clamp,
+    /// noise::module::Const, noise::module::Curve,
+    /// noise::module::Cylinders, noise::module::Displace,
+    /// noise::module::Exponent, noise::module::Invert, noise::module::Max,
+    /// noise::module::Min, noise::module::Multiply, noise::module::Perlin,
+    /// noise::module::Power, noise::module::RidgedMulti,
+    /// noise::module::RotatePoint, noise::module::ScaleBias,
+    /// noise::module::ScalePoint, noise::module::Select,
+    /// noise::module::Simplex, noise::module::Spheres, noise::module::Terrace,
+    /// noise::module::TranslatePoint and noise::module::Turbulence.
+    /// Classes derived from these noise modules cannot be generated, because
+    /// they may override the output values.
+    ///
+    /// A noise module that is reached several times with the same input
+    /// values is generated only once.  The source modules of a Select
+    /// module are only evaluated for the input values that need them.
+    ///
+    /// The generated function returns bit-identical values as long as it
+    /// is compiled without contracting floating-point operations (for
+    /// example, GCC and Clang with <tt>-ffp-contract=off</tt> on targets
+    /// with fused multiply-add instructions.)  The settings are read when
+    /// the function is generated, so it must be generated again after
+    /// changing the graph.
+    class CodeGenerator
+    {
+
+      public:
+
+        /// Constructor.
+        CodeGenerator ();
+
+        /// Generates the C++ source code of a function that outputs the
+        /// values of a graph of noise modules.
+        ///
+        /// @param root The noise module whose output values the function
+        /// returns.
+        /// @param functionName The name of the generated function.
+        /// @param os The stream that receives the source code.
+        ///
+        /// @throw noise::ExceptionInvalidParam A noise module of the graph
+        /// cannot be generated, or a setting is not a finite number.
+        /// @throw noise::ExceptionNoModule A noise module of the graph
+        /// does not have all required source modules.
+        ///
+        /// The source code includes <tt>noisegen.h</tt>, which must be on
+        /// the include path of the application.
+        void Generate (const Module& root, const char* functionName,
+          std::ostream& os);
+
+      protected:
+
+        /// Octave loops of the fractal noise modules.
+        enum FractalSignal
+        {
+          SIGNAL_PERLIN,
+          SIGNAL_BILLOW,
+          SIGNAL_RIDGED,
+          SIGNAL_SIMPLEX
+        };
+
+        /// A noise module that has been generated for the given coordinate
+        /// variables, and the variable of its output value.
+        struct GeneratedNode
+        {
+          const Module* pModule;
+          int xVariable;
+          int yVariable;
+          int result;
+          int depth;
+        };
+
+        /// The variables that hold the coordinates of the input value.
+        enum
+        {
+          X_VARIABLE = 0,
+          Y_VARIABLE = 1
+        };
+
+        /// The axes of the input value, see GetInputAxes().
+        enum
+        {
+          AXIS_X = 1,
+          AXIS_Y = 2
+        };
+
+        /// The axes of the input value that a noise module reads.
+        struct InputAxes
+        {
+          const Module* pModule;
+          int axes;
+        };
+
+        /// Closes a block of statements, whose variables go out of scope.
+        void CloseBlock (std::ostream& os);
+
+        /// Writes the statements of a fractal noise module and returns the
+        /// variable of its output value.
+        int GenerateFractal (std::ostream& os, const FractalParams& params,
+          FractalSignal signal, int octaveCount, double tolerance,
+          int xVariable, int yVariable);
+
+        /// Writes the statements of a noise module for the given coordinate
+        /// variables and returns the variable of its output value.
+        int GenerateModule (std::ostream& os, const Module& module,
+          int xVariable, int yVariable);
+
+        /// Returns the indentation of the current block.
+        std::string Indent () const;
+
+        /// Returns the axes of the input value whose coordinates the
+        /// output value of a noise module depends on, as a combination of
+        /// AXIS_X and AXIS_Y.
+        ///
+        /// Transformer modules only generate the coordinates that their
+        /// source module reads, so that the generated function has no
+        /// unused variables.
+        int GetInputAxes (const Module& module);
+
+        /// Declares a new variable and returns it.
+        int NewVariable ();
+
+        /// Opens a block of statements after @a statement, such as the
+        /// condition of an if statement.
+        void OpenBlock (std::ostream& os, const std::string& statement);
+
+        /// Returns the name of a variable.
+        std::string Variable (int variable) const;
+
+        /// The noise modules generated so far, including those of the
+        /// blocks that are still open.
+        std::vector<GeneratedNode> m_generatedNodes;
+
+        /// The axes read by the noise modules visited so far by
+        /// GetInputAxes().
+        std::vector<InputAxes> m_inputAxes;
+
+        /// Number of blocks that are open.
+        int m_depth;
+
+        /// Number of variables declared so far.
+        int m_variableCount;
+
+    };
+
+    /// @}
+
+    /// @}
+
+  }
+
+}
+
+#endif
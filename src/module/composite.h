@@ -0,0 +1,1524 @@
+// composite.h
+//
+// Copyright (C) 2026 libnoise2d contributors
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#ifndef NOISE_MODULE_COMPOSITE_H
+#define NOISE_MODULE_COMPOSITE_H
+
+#include "../interp.h"
+#include "../mathconsts.h"
+#include "../misc.h"
+#include "billow.h"
+#include "checkerboard.h"
+#include "clamp.h"
+#include "const.h"
+#include "cylinders.h"
+#include "exponent.h"
+#include "perlin.h"
+#include "ridgedmulti.h"
+#include "rotatepoint.h"
+#include "scalebias.h"
+#include "scalepoint.h"
+#include "select.h"
+#include "simplex.h"
+#include "spheres.h"
+#include "translatepoint.h"
+#include "voronoi.h"
+
+namespace noise
+{
+
+  /// Noise modules composed at compile time.
+  ///
+  /// The classes of this namespace mirror the noise modules of
+  /// noise::module, but take their source modules as template parameters
+  /// and contain them, instead of pointing to them:
+  ///
+  /// @code
+  /// noise::composite::ScaleBias<noise::composite::Add<
+  ///   noise::composite::Perlin, noise::composite::RidgedMulti> > terrain;
+  /// terrain.SetScale (0.5);
+  /// terrain.GetSourceModule0 ().GetSourceModule1 ().SetOctaveCount (8);
+  /// double value = terrain.GetValue (x, y);
+  /// @endcode
+  ///
+  /// The whole graph is one type, so the methods are called without
+  /// virtual calls and without m_pSourceModule, and the compiler can
+  /// inline the graph into the calling code and vectorise the loops of
+  /// GetValues().  The generator modules are those of noise::module, whose
+  /// calls are resolved statically because their type is known.  Each
+  /// class calculates its output values exactly like the noise module of
+  /// the same name, so a graph outputs the same values as the same graph
+  /// of noise modules.
+  ///
+  /// A graph is a value: copying a graph copies every module of the graph
+  /// and its settings, including the permutation tables of the generator
+  /// modules, and the copy does not share any state with the original.  A
+  /// graph cannot be assigned, because noise modules cannot be assigned.
+  ///
+  /// A graph can be used as the source module of a noise module through
+  /// noise::composite::ModuleAdapter.
+  namespace composite
+  {
+
+    /// @addtogroup libnoise
+    /// @{
+
+    /// @addtogroup modules
+    /// @{
+
+    /// @defgroup compositemodules Composite Modules
+    /// @addtogroup compositemodules
+    /// @{
+
+    using noise::module::Billow;
+    using noise::module::Checkerboard;
+    using noise::module::Const;
+    using noise::module::Cylinders;
+    using noise::module::Perlin;
+    using noise::module::RidgedMulti;
+    using noise::module::Simplex;
+    using noise::module::Spheres;
+    using noise::module::Voronoi;
+
+    /// Combines the output values of two source modules, see Add, Max,
+    /// Min, Multiply and Power.
+    ///
+    /// @a Operator provides a static method Apply() that combines two
+    /// output values.
+    template <class Operator, class Source0, class Source1>
+    class Combiner
+    {
+
+      public:
+
+        /// Returns the first source module.
+        Source0& GetSourceModule0 ()
+        {
+          return m_source0;
+        }
+
+        /// Returns the first source module.
+        const Source0& GetSourceModule0 () const
+        {
+          return m_source0;
+        }
+
+        /// Returns the second source module.
+        Source1& GetSourceModule1 ()
+        {
+          return m_source1;
+        }
+
+        /// Returns the second source module.
+        const Source1& GetSourceModule1 () const
+        {
+          return m_source1;
+        }
+
+        double GetValue (double x, double y) const
+        {
+          double v0 = m_source0.GetValue (x, y);
+          double v1 = m_source1.GetValue (x, y);
+          return Operator::Apply (v0, v1);
+        }
+
+        double GetValue (double x, double y, double footprint) const
+        {
+          double v0 = m_source0.GetValue (x, y, footprint);
+          double v1 = m_source1.GetValue (x, y, footprint);
+          return Operator::Apply (v0, v1);
+        }
+
+        void GetValues (const double* xs, const double* ys, double* out,
+          size_t n) const
+        {
+          double v1[noise::module::BATCH_BLOCK_SIZE];
+          for (size_t i = 0; i < n; i += noise::module::BATCH_BLOCK_SIZE) {
+            size_t count = GetMin (n - i,
+              (size_t)noise::module::BATCH_BLOCK_SIZE);
+            double* v0 = out + i;
+            m_source0.GetValues (xs + i, ys + i, v0, count);
+            m_source1.GetValues (xs + i, ys + i, v1, count);
+            for (size_t j = 0; j < count; j++) {
+              v0[j] = Operator::Apply (v0[j], v1[j]);
+            }
+          }
+        }
+
+      protected:
+
+        /// The first source module.
+        Source0 m_source0;
+
+        /// The second source module.
+        Source1 m_source1;
+
+    };
+
+    /// Operator of Add.
+    struct AddOperator
+    {
+      static double Apply (double v0, double v1)
+      {
+        return v0 + v1;
+      }
+    };
+
+    /// Operator of Max.
+    struct MaxOperator
+    {
+      static double Apply (double v0, double v1)
+      {
+        return GetMax (v0, v1);
+      }
+    };
+
+    /// Operator of Min.
+    struct MinOperator
+    {
+      static double Apply (double v0, double v1)
+      {
+        return GetMin (v0, v1);
+      }
+    };
+
+    /// Operator of Multiply.
+    struct MultiplyOperator
+    {
+      static double Apply (double v0, double v1)
+      {
+        return v0 * v1;
+      }
+    };
+
+    /// Operator of Power.
+    struct PowerOperator
+    {
+      static double Apply (double v0, double v1)
+      {
+        return pow (v0, v1);
+      }
+    };
+
+    /// Noise module that outputs the absolute value of the output value
+    /// from a source module, see noise::module::Abs.
+    template <class Source>
+    class Abs
+    {
+
+      public:
+
+        /// Returns the source module.
+        Source& GetSourceModule0 ()
+        {
+          return m_source;
+        }
+
+        /// Returns the source module.
+        const Source& GetSourceModule0 () const
+        {
+          return m_source;
+        }
+
+        double GetValue (double x, double y) const
+        {
+          return fabs (m_source.GetValue (x, y));
+        }
+
+        double GetValue (double x, double y, double footprint) const
+        {
+          return fabs (m_source.GetValue (x, y, footprint));
+        }
+
+        void GetValues (const double* xs, const double* ys, double* out,
+          size_t n) const
+        {
+          m_source.GetValues (xs, ys, out, n);
+          for (size_t i = 0; i < n; i++) {
+            out[i] = fabs (out[i]);
+          }
+        }
+
+      protected:
+
+        /// The source module.
+        Source m_source;
+
+    };
+
+    /// Noise module that outputs the sum of the two output values from two
+    /// source modules, see noise::module::Add.
+    template <class Source0, class Source1>
+    class Add: public Combiner<AddOperator, Source0, Source1>
+    {
+    };
+
+    /// Noise module that outputs a weighted blend of the output values from
+    /// two source modules given the output value supplied by a control
+    /// module, see noise::module::Blend.
+    template <class Source0, class Source1, class Control>
+    class Blend
+    {
+
+      public:
+
+        /// Returns the control module.
+        Control& GetControlModule ()
+        {
+          return m_control;
+        }
+
+        /// Returns the control module.
+        const Control& GetControlModule () const
+        {
+          return m_control;
+        }
+
+        /// Returns the first source module.
+        Source0& GetSourceModule0 ()
+        {
+          return m_source0;
+        }
+
+        /// Returns the first source module.
+        const Source0& GetSourceModule0 () const
+        {
+          return m_source0;
+        }
+
+        /// Returns the second source module.
+        Source1& GetSourceModule1 ()
+        {
+          return m_source1;
+        }
+
+        /// Returns the second source module.
+        const Source1& GetSourceModule1 () const
+        {
+          return m_source1;
+        }
+
+        double GetValue (double x, double y) const
+        {
+          double v0 = m_source0.GetValue (x, y);
+          double v1 = m_source1.GetValue (x, y);
+          double alpha = (m_control.GetValue (x, y) + 1.0) / 2.0;
+          return LinearInterp (v0, v1, alpha);
+        }
+
+        double GetValue (double x, double y, double footprint) const
+        {
+          double v0 = m_source0.GetValue (x, y, footprint);
+          double v1 = m_source1.GetValue (x, y, footprint);
+          double alpha = (m_control.GetValue (x, y, footprint) + 1.0) / 2.0;
+          return LinearInterp (v0, v1, alpha);
+        }
+
+        void GetValues (const double* xs, const double* ys, double* out,
+          size_t n) const
+        {
+          double v1[noise::module::BATCH_BLOCK_SIZE];
+          double alpha[noise::module::BATCH_BLOCK_SIZE];
+          for (size_t i = 0; i < n; i += noise::module::BATCH_BLOCK_SIZE) {
+            size_t count = GetMin (n - i,
+              (size_t)noise::module::BATCH_BLOCK_SIZE);
+            double* v0 = out + i;
+            m_source0.GetValues (xs + i, ys + i, v0, count);
+            m_source1.GetValues (xs + i, ys + i, v1, count);
+            m_control.GetValues (xs + i, ys + i, alpha, count);
+            for (size_t j = 0; j < count; j++) {
+              v0[j] = LinearInterp (v0[j], v1[j], (alpha[j] + 1.0) / 2.0);
+            }
+          }
+        }
+
+      protected:
+
+        /// The control module.
+        Control m_control;
+
+        /// The first source module.
+        Source0 m_source0;
+
+        /// The second source module.
+        Source1 m_source1;
+
+    };
+
+    /// Noise module that clamps the output value from a source module to a
+    /// range of values, see noise::module::Clamp.
+    template <class Source>
+    class Clamp
+    {
+
+      public:
+
+        /// Constructor.
+        Clamp ():
+          m_lowerBound (noise::module::DEFAULT_CLAMP_LOWER_BOUND),
+          m_upperBound (noise::module::DEFAULT_CLAMP_UPPER_BOUND)
+        {
+        }
+
+        /// Returns the lower bound of the clamping range.
+        double GetLowerBound () const
+        {
+          return m_lowerBound;
+        }
+
+        /// Returns the source module.
+        Source& GetSourceModule0 ()
+        {
+          return m_source;
+        }
+
+        /// Returns the source module.
+        const Source& GetSourceModule0 () const
+        {
+          return m_source;
+        }
+
+        /// Returns the upper bound of the clamping range.
+        double GetUpperBound () const
+        {
+          return m_upperBound;
+        }
+
+        double GetValue (double x, double y) const
+        {
+          return ClampOutput (m_source.GetValue (x, y));
+        }
+
+        double GetValue (double x, double y, double footprint) const
+        {
+          return ClampOutput (m_source.GetValue (x, y, footprint));
+        }
+
+        void GetValues (const double* xs, const double* ys, double* out,
+          size_t n) const
+        {
+          m_source.GetValues (xs, ys, out, n);
+          for (size_t i = 0; i < n; i++) {
+            out[i] = ClampOutput (out[i]);
+          }
+        }
+
+        /// Sets the lower and upper bounds of the clamping range.
+        ///
+        /// @pre The lower bound must be less than the upper bound.
+        void SetBounds (double lowerBound, double upperBound)
+        {
+          assert (lowerBound < upperBound);
+
+          m_lowerBound = lowerBound;
+          m_upperBound = upperBound;
+        }
+
+      protected:
+
+        /// Clamps an output value of the source module.
+        double ClampOutput (double value) const
+        {
+          if (value < m_lowerBound) {
+            return m_lowerBound;
+          } else if (value > m_upperBound) {
+            return m_upperBound;
+          } else {
+            return value;
+          }
+        }
+
+        /// Lower bound of the clamping range.
+        double m_lowerBound;
+
+        /// The source module.
+        Source m_source;
+
+        /// Upper bound of the clamping range.
+        double m_upperBound;
+
+    };
+
+    /// Noise module that uses three source modules to displace each
+    /// coordinate of the input value before returning the output value
+    /// from a source module, see noise::module::Displace.
+    template <class Source, class XDisplace, class YDisplace>
+    class Displace
+    {
+
+      public:
+
+        /// Returns the source module.
+        Source& GetSourceModule0 ()
+        {
+          return m_source;
+        }
+
+        /// Returns the source module.
+        const Source& GetSourceModule0 () const
+        {
+          return m_source;
+        }
+
+        double GetValue (double x, double y) const
+        {
+          double xDisplace = x + (m_xDisplace.GetValue (x, y));
+          double yDisplace = y + (m_yDisplace.GetValue (x, y));
+          return m_source.GetValue (xDisplace, yDisplace);
+        }
+
+        double GetValue (double x, double y, double footprint) const
+        {
+          double xDisplace = x + (m_xDisplace.GetValue (x, y, footprint));
+          double yDisplace = y + (m_yDisplace.GetValue (x, y, footprint));
+          return m_source.GetValue (xDisplace, yDisplace, footprint);
+        }
+
+        void GetValues (const double* xs, const double* ys, double* out,
+          size_t n) const
+        {
+          double xDisplace[noise::module::BATCH_BLOCK_SIZE];
+          double yDisplace[noise::module::BATCH_BLOCK_SIZE];
+          for (size_t i = 0; i < n; i += noise::module::BATCH_BLOCK_SIZE) {
+            size_t count = GetMin (n - i,
+              (size_t)noise::module::BATCH_BLOCK_SIZE);
+            m_xDisplace.GetValues (xs + i, ys + i, xDisplace, count);
+            m_yDisplace.GetValues (xs + i, ys + i, yDisplace, count);
+            for (size_t j = 0; j < count; j++) {
+              xDisplace[j] = xs[i + j] + xDisplace[j];
+              yDisplace[j] = ys[i + j] + yDisplace[j];
+            }
+            m_source.GetValues (xDisplace, yDisplace, out + i, count);
+          }
+        }
+
+        /// Returns the @a x displacement module.
+        XDisplace& GetXDisplaceModule ()
+        {
+          return m_xDisplace;
+        }
+
+        /// Returns the @a x displacement module.
+        const XDisplace& GetXDisplaceModule () const
+        {
+          return m_xDisplace;
+        }
+
+        /// Returns the @a y displacement module.
+        YDisplace& GetYDisplaceModule ()
+        {
+          return m_yDisplace;
+        }
+
+        /// Returns the @a y displacement module.
+        const YDisplace& GetYDisplaceModule () const
+        {
+          return m_yDisplace;
+        }
+
+      protected:
+
+        /// The source module.
+        Source m_source;
+
+        /// The @a x displacement module.
+        XDisplace m_xDisplace;
+
+        /// The @a y displacement module.
+        YDisplace m_yDisplace;
+
+    };
+
+    /// Noise module that maps the output value from a source module onto an
+    /// exponential curve, see noise::module::Exponent.
+    template <class Source>
+    class Exponent
+    {
+
+      public:
+
+        /// Constructor.
+        Exponent ():
+          m_exponent (noise::module::DEFAULT_EXPONENT)
+        {
+        }
+
+        /// Returns the exponent value to apply to the output value from the
+        /// source module.
+        double GetExponent () const
+        {
+          return m_exponent;
+        }
+
+        /// Returns the source module.
+        Source& GetSourceModule0 ()
+        {
+          return m_source;
+        }
+
+        /// Returns the source module.
+        const Source& GetSourceModule0 () const
+        {
+          return m_source;
+        }
+
+        double GetValue (double x, double y) const
+        {
+          double value = m_source.GetValue (x, y);
+          return (pow (fabs ((value + 1.0) / 2.0), m_exponent) * 2.0 - 1.0);
+        }
+
+        double GetValue (double x, double y, double footprint) const
+        {
+          double value = m_source.GetValue (x, y, footprint);
+          return (pow (fabs ((value + 1.0) / 2.0), m_exponent) * 2.0 - 1.0);
+        }
+
+        void GetValues (const double* xs, const double* ys, double* out,
+          size_t n) const
+        {
+          m_source.GetValues (xs, ys, out, n);
+          for (size_t i = 0; i < n; i++) {
+            out[i] = (pow (fabs ((out[i] + 1.0) / 2.0), m_exponent) * 2.0
+              - 1.0);
+          }
+        }
+
+        /// Sets the exponent value to apply to the output value from the
+        /// source module.
+        void SetExponent (double exponent)
+        {
+          m_exponent = exponent;
+        }
+
+      protected:
+
+        /// Exponent to apply to the output value from the source module.
+        double m_exponent;
+
+        /// The source module.
+        Source m_source;
+
+    };
+
+    /// Noise module that inverts the output value from a source module, see
+    /// noise::module::Invert.
+    template <class Source>
+    class Invert
+    {
+
+      public:
+
+        /// Returns the source module.
+        Source& GetSourceModule0 ()
+        {
+          return m_source;
+        }
+
+        /// Returns the source module.
+        const Source& GetSourceModule0 () const
+        {
+          return m_source;
+        }
+
+        double GetValue (double x, double y) const
+        {
+          return -(m_source.GetValue (x, y));
+        }
+
+        double GetValue (double x, double y, double footprint) const
+        {
+          return -(m_source.GetValue (x, y, footprint));
+        }
+
+        void GetValues (const double* xs, const double* ys, double* out,
+          size_t n) const
+        {
+          m_source.GetValues (xs, ys, out, n);
+          for (size_t i = 0; i < n; i++) {
+            out[i] = -out[i];
+          }
+        }
+
+      protected:
+
+        /// The source module.
+        Source m_source;
+
+    };
+
+    /// Noise module that outputs the larger of the two output values from
+    /// two source modules, see noise::module::Max.
+    template <class Source0, class Source1>
+    class Max: public Combiner<MaxOperator, Source0, Source1>
+    {
+    };
+
+    /// Noise module that outputs the smaller of the two output values from
+    /// two source modules, see noise::module::Min.
+    template <class Source0, class Source1>
+    class Min: public Combiner<MinOperator, Source0, Source1>
+    {
+    };
+
+    /// Noise module that outputs the product of the two output values from
+    /// two source modules, see noise::module::Multiply.
+    template <class Source0, class Source1>
+    class Multiply: public Combiner<MultiplyOperator, Source0, Source1>
+    {
+    };
+
+    /// Noise module that raises the output value from a first source module
+    /// to the power of the output value from a second source module, see
+    /// noise::module::Power.
+    template <class Source0, class Source1>
+    class Power: public Combiner<PowerOperator, Source0, Source1>
+    {
+    };
+
+    /// Noise module that rotates the input value around the origin before
+    /// returning the output value from a source module, see
+    /// noise::module::RotatePoint.
+    template <class Source>
+    class RotatePoint
+    {
+
+      public:
+
+        /// Constructor.
+        RotatePoint ()
+        {
+          SetAngles (noise::module::DEFAULT_ROTATE_X,
+            noise::module::DEFAULT_ROTATE_Y,
+            noise::module::DEFAULT_ROTATE_Z);
+        }
+
+        /// Returns the source module.
+        Source& GetSourceModule0 ()
+        {
+          return m_source;
+        }
+
+        /// Returns the source module.
+        const Source& GetSourceModule0 () const
+        {
+          return m_source;
+        }
+
+        double GetValue (double x, double y) const
+        {
+          double nx = (m_x1Matrix * x) + (m_y1Matrix * y);
+          double ny = (m_x2Matrix * x) + (m_y2Matrix * y);
+          return m_source.GetValue (nx, ny);
+        }
+
+        double GetValue (double x, double y, double footprint) const
+        {
+          double nx = (m_x1Matrix * x) + (m_y1Matrix * y);
+          double ny = (m_x2Matrix * x) + (m_y2Matrix * y);
+          return m_source.GetValue (nx, ny, footprint);
+        }
+
+        void GetValues (const double* xs, const double* ys, double* out,
+          size_t n) const
+        {
+          double nx[noise::module::BATCH_BLOCK_SIZE];
+          double ny[noise::module::BATCH_BLOCK_SIZE];
+          for (size_t i = 0; i < n; i += noise::module::BATCH_BLOCK_SIZE) {
+            size_t count = GetMin (n - i,
+              (size_t)noise::module::BATCH_BLOCK_SIZE);
+            const double* x = xs + i;
+            const double* y = ys + i;
+            for (size_t j = 0; j < count; j++) {
+              nx[j] = (m_x1Matrix * x[j]) + (m_y1Matrix * y[j]);
+              ny[j] = (m_x2Matrix * x[j]) + (m_y2Matrix * y[j]);
+            }
+            m_source.GetValues (nx, ny, out + i, count);
+          }
+        }
+
+        /// Sets the rotation angles around all three axes to apply to the
+        /// input value, in degrees.
+        ///
+        /// The rotation matrix is calculated like that of
+        /// noise::module::RotatePoint::SetAngles().  Only its entries in
+        /// the plane are kept.
+        void SetAngles (double xAngle, double yAngle, double zAngle)
+        {
+          double xCos, yCos, zCos, xSin, ySin, zSin;
+          xCos = cos (xAngle * DEG_TO_RAD);
+          yCos = cos (yAngle * DEG_TO_RAD);
+          zCos = cos (zAngle * DEG_TO_RAD);
+          xSin = sin (xAngle * DEG_TO_RAD);
+          ySin = sin (yAngle * DEG_TO_RAD);
+          zSin = sin (zAngle * DEG_TO_RAD);
+
+          m_x1Matrix = ySin * xSin * zSin + yCos * zCos;
+          m_y1Matrix = xCos * zSin;
+          m_x2Matrix = ySin * xSin * zCos - yCos * zSin;
+          m_y2Matrix = xCos * zCos;
+
+          m_xAngle = xAngle;
+          m_yAngle = yAngle;
+          m_zAngle = zAngle;
+        }
+
+        /// Returns the rotation angle around the @a x axis to apply to the
+        /// input value, in degrees.
+        double GetXAngle () const
+        {
+          return m_xAngle;
+        }
+
+        /// Returns the rotation angle around the @a y axis to apply to the
+        /// input value, in degrees.
+        double GetYAngle () const
+        {
+          return m_yAngle;
+        }
+
+        /// Returns the rotation angle around the @a z axis to apply to the
+        /// input value, in degrees.
+        double GetZAngle () const
+        {
+          return m_zAngle;
+        }
+
+        /// Sets the rotation angle around the @a x axis to apply to the
+        /// input value, in degrees.
+        void SetXAngle (double xAngle)
+        {
+          SetAngles (xAngle, m_yAngle, m_zAngle);
+        }
+
+        /// Sets the rotation angle around the @a y axis to apply to the
+        /// input value, in degrees.
+        void SetYAngle (double yAngle)
+        {
+          SetAngles (m_xAngle, yAngle, m_zAngle);
+        }
+
+        /// Sets the rotation angle around the @a z axis to apply to the
+        /// input value, in degrees.
+        void SetZAngle (double zAngle)
+        {
+          SetAngles (m_xAngle, m_yAngle, zAngle);
+        }
+
+      protected:
+
+        /// The source module.
+        Source m_source;
+
+        /// An entry within the rotation matrix used for rotating the input
+        /// value.
+        double m_x1Matrix;
+
+        /// An entry within the rotation matrix used for rotating the input
+        /// value.
+        double m_x2Matrix;
+
+        /// An entry within the rotation matrix used for rotating the input
+        /// value.
+        double m_y1Matrix;
+
+        /// An entry within the rotation matrix used for rotating the input
+        /// value.
+        double m_y2Matrix;
+
+        /// The rotation angle around the @a x axis to apply to the input
+        /// value, in degrees.
+        double m_xAngle;
+
+        /// The rotation angle around the @a y axis to apply to the input
+        /// value, in degrees.
+        double m_yAngle;
+
+        /// The rotation angle around the @a z axis to apply to the input
+        /// value, in degrees.
+        double m_zAngle;
+
+    };
+
+    /// Noise module that applies a scaling factor and a bias to the output
+    /// value from a source module, see noise::module::ScaleBias.
+    template <class Source>
+    class ScaleBias
+    {
+
+      public:
+
+        /// Constructor.
+        ScaleBias ():
+          m_bias  (noise::module::DEFAULT_BIAS ),
+          m_scale (noise::module::DEFAULT_SCALE)
+        {
+        }
+
+        /// Returns the bias to apply to the scaled output value from the
+        /// source module.
+        double GetBias () const
+        {
+          return m_bias;
+        }
+
+        /// Returns the scaling factor to apply to the output value from the
+        /// source module.
+        double GetScale () const
+        {
+          return m_scale;
+        }
+
+        /// Returns the source module.
+        Source& GetSourceModule0 ()
+        {
+          return m_source;
+        }
+
+        /// Returns the source module.
+        const Source& GetSourceModule0 () const
+        {
+          return m_source;
+        }
+
+        double GetValue (double x, double y) const
+        {
+          return m_source.GetValue (x, y) * m_scale + m_bias;
+        }
+
+        double GetValue (double x, double y, double footprint) const
+        {
+          return m_source.GetValue (x, y, footprint) * m_scale + m_bias;
+        }
+
+        void GetValues (const double* xs, const double* ys, double* out,
+          size_t n) const
+        {
+          m_source.GetValues (xs, ys, out, n);
+          for (size_t i = 0; i < n; i++) {
+            out[i] = out[i] * m_scale + m_bias;
+          }
+        }
+
+        /// Sets the bias to apply to the scaled output value from the
+        /// source module.
+        void SetBias (double bias)
+        {
+          m_bias = bias;
+        }
+
+        /// Sets the scaling factor to apply to the output value from the
+        /// source module.
+        void SetScale (double scale)
+        {
+          m_scale = scale;
+        }
+
+      protected:
+
+        /// Bias to apply to the scaled output value from the source module.
+        double m_bias;
+
+        /// Scaling factor to apply to the output value from the source
+        /// module.
+        double m_scale;
+
+        /// The source module.
+        Source m_source;
+
+    };
+
+    /// Noise module that scales the coordinates of the input value before
+    /// returning the output value from a source module, see
+    /// noise::module::ScalePoint.
+    template <class Source>
+    class ScalePoint
+    {
+
+      public:
+
+        /// Constructor.
+        ScalePoint ():
+          m_xScale (noise::module::DEFAULT_SCALE_POINT_X),
+          m_yScale (noise::module::DEFAULT_SCALE_POINT_Y)
+        {
+        }
+
+        /// Returns the source module.
+        Source& GetSourceModule0 ()
+        {
+          return m_source;
+        }
+
+        /// Returns the source module.
+        const Source& GetSourceModule0 () const
+        {
+          return m_source;
+        }
+
+        double GetValue (double x, double y) const
+        {
+          return m_source.GetValue (x * m_xScale, y * m_yScale);
+        }
+
+        double GetValue (double x, double y, double footprint) const
+        {
+          return m_source.GetValue (x * m_xScale, y * m_yScale,
+            footprint * GetMax (fabs (m_xScale), fabs (m_yScale)));
+        }
+
+        void GetValues (const double* xs, const double* ys, double* out,
+          size_t n) const
+        {
+          double nx[noise::module::BATCH_BLOCK_SIZE];
+          double ny[noise::module::BATCH_BLOCK_SIZE];
+          for (size_t i = 0; i < n; i += noise::module::BATCH_BLOCK_SIZE) {
+            size_t count = GetMin (n - i,
+              (size_t)noise::module::BATCH_BLOCK_SIZE);
+            const double* x = xs + i;
+            const double* y = ys + i;
+            for (size_t j = 0; j < count; j++) {
+              nx[j] = x[j] * m_xScale;
+              ny[j] = y[j] * m_yScale;
+            }
+            m_source.GetValues (nx, ny, out + i, count);
+          }
+        }
+
+        /// Returns the scaling factor applied to the @a x coordinate of the
+        /// input value.
+        double GetXScale () const
+        {
+          return m_xScale;
+        }
+
+        /// Returns the scaling factor applied to the @a y coordinate of the
+        /// input value.
+        double GetYScale () const
+        {
+          return m_yScale;
+        }
+
+        /// Sets the scaling factor to apply to both coordinates of the
+        /// input value.
+        void SetScale (double scale)
+        {
+          m_xScale = scale;
+          m_yScale = scale;
+        }
+
+        /// Sets the scaling factors to apply to the ( @a x, @a y )
+        /// coordinates of the input value.
+        void SetScale (double xScale, double yScale)
+        {
+          m_xScale = xScale;
+          m_yScale = yScale;
+        }
+
+        /// Sets the scaling factor to apply to the @a x coordinate of the
+        /// input value.
+        void SetXScale (double xScale)
+        {
+          m_xScale = xScale;
+        }
+
+        /// Sets the scaling factor to apply to the @a y coordinate of the
+        /// input value.
+        void SetYScale (double yScale)
+        {
+          m_yScale = yScale;
+        }
+
+      protected:
+
+        /// The source module.
+        Source m_source;
+
+        /// Scaling factor applied to the @a x coordinate of the input value.
+        double m_xScale;
+
+        /// Scaling factor applied to the @a y coordinate of the input value.
+        double m_yScale;
+
+    };
+
+    /// Noise module that outputs the value selected from one of two source
+    /// modules chosen by the output value from a control module, see
+    /// noise::module::Select.
+    template <class Source0, class Source1, class Control>
+    class Select
+    {
+
+      public:
+
+        /// Constructor.
+        Select ():
+          m_edgeFalloff (noise::module::DEFAULT_SELECT_EDGE_FALLOFF),
+          m_lowerBound (noise::module::DEFAULT_SELECT_LOWER_BOUND),
+          m_upperBound (noise::module::DEFAULT_SELECT_UPPER_BOUND)
+        {
+        }
+
+        /// Returns the control module.
+        Control& GetControlModule ()
+        {
+          return m_control;
+        }
+
+        /// Returns the control module.
+        const Control& GetControlModule () const
+        {
+          return m_control;
+        }
+
+        /// Returns the falloff value at the edge transition.
+        double GetEdgeFalloff () const
+        {
+          return m_edgeFalloff;
+        }
+
+        /// Returns the lower bound of the selection range.
+        double GetLowerBound () const
+        {
+          return m_lowerBound;
+        }
+
+        /// Returns the first source module.
+        Source0& GetSourceModule0 ()
+        {
+          return m_source0;
+        }
+
+        /// Returns the first source module.
+        const Source0& GetSourceModule0 () const
+        {
+          return m_source0;
+        }
+
+        /// Returns the second source module.
+        Source1& GetSourceModule1 ()
+        {
+          return m_source1;
+        }
+
+        /// Returns the second source module.
+        const Source1& GetSourceModule1 () const
+        {
+          return m_source1;
+        }
+
+        /// Returns the upper bound of the selection range.
+        double GetUpperBound () const
+        {
+          return m_upperBound;
+        }
+
+        double GetValue (double x, double y) const
+        {
+          double alpha;
+          switch (GetSelectMode (m_control.GetValue (x, y), alpha)) {
+            case SELECT_SOURCE_0:
+              return m_source0.GetValue (x, y);
+            case SELECT_SOURCE_1:
+              return m_source1.GetValue (x, y);
+            case BLEND_SOURCE_0_1:
+              return LinearInterp (m_source0.GetValue (x, y),
+                m_source1.GetValue (x, y), alpha);
+            default:
+              return LinearInterp (m_source1.GetValue (x, y),
+                m_source0.GetValue (x, y), alpha);
+          }
+        }
+
+        double GetValue (double x, double y, double footprint) const
+        {
+          double alpha;
+          switch (GetSelectMode (m_control.GetValue (x, y, footprint),
+            alpha)) {
+            case SELECT_SOURCE_0:
+              return m_source0.GetValue (x, y, footprint);
+            case SELECT_SOURCE_1:
+              return m_source1.GetValue (x, y, footprint);
+            case BLEND_SOURCE_0_1:
+              return LinearInterp (m_source0.GetValue (x, y, footprint),
+                m_source1.GetValue (x, y, footprint), alpha);
+            default:
+              return LinearInterp (m_source1.GetValue (x, y, footprint),
+                m_source0.GetValue (x, y, footprint), alpha);
+          }
+        }
+
+        void GetValues (const double* xs, const double* ys, double* out,
+          size_t n) const
+        {
+          SelectMode mode[noise::module::BATCH_BLOCK_SIZE];
+          double alpha[noise::module::BATCH_BLOCK_SIZE];
+          double v1[noise::module::BATCH_BLOCK_SIZE];
+          double xGather[noise::module::BATCH_BLOCK_SIZE];
+          double yGather[noise::module::BATCH_BLOCK_SIZE];
+          double vGather[noise::module::BATCH_BLOCK_SIZE];
+          size_t index[noise::module::BATCH_BLOCK_SIZE];
+
+          for (size_t i = 0; i < n; i += noise::module::BATCH_BLOCK_SIZE) {
+            size_t count = GetMin (n - i,
+              (size_t)noise::module::BATCH_BLOCK_SIZE);
+            const double* x = xs + i;
+            const double* y = ys + i;
+            double* v0 = out + i;
+
+            m_control.GetValues (x, y, alpha, count);
+            for (size_t j = 0; j < count; j++) {
+              mode[j] = GetSelectMode (alpha[j], alpha[j]);
+            }
+
+            // Only retrieve the output values of the source modules that
+            // are needed, like noise::module::Select::GetValues().
+            size_t gatherCount = 0;
+            for (size_t j = 0; j < count; j++) {
+              if (mode[j] != SELECT_SOURCE_1) {
+                index  [gatherCount] = j;
+                xGather[gatherCount] = x[j];
+                yGather[gatherCount] = y[j];
+                ++gatherCount;
+              }
+            }
+            if (gatherCount > 0) {
+              m_source0.GetValues (xGather, yGather, vGather, gatherCount);
+              for (size_t k = 0; k < gatherCount; k++) {
+                v0[index[k]] = vGather[k];
+              }
+            }
+
+            gatherCount = 0;
+            for (size_t j = 0; j < count; j++) {
+              if (mode[j] != SELECT_SOURCE_0) {
+                index  [gatherCount] = j;
+                xGather[gatherCount] = x[j];
+                yGather[gatherCount] = y[j];
+                ++gatherCount;
+              }
+            }
+            if (gatherCount > 0) {
+              m_source1.GetValues (xGather, yGather, vGather, gatherCount);
+              for (size_t k = 0; k < gatherCount; k++) {
+                v1[index[k]] = vGather[k];
+              }
+            }
+
+            for (size_t j = 0; j < count; j++) {
+              switch (mode[j]) {
+                case SELECT_SOURCE_0:
+                  break;
+                case SELECT_SOURCE_1:
+                  v0[j] = v1[j];
+                  break;
+                case BLEND_SOURCE_0_1:
+                  v0[j] = LinearInterp (v0[j], v1[j], alpha[j]);
+                  break;
+                case BLEND_SOURCE_1_0:
+                  v0[j] = LinearInterp (v1[j], v0[j], alpha[j]);
+                  break;
+              }
+            }
+          }
+        }
+
+        /// Sets the lower and upper bounds of the selection range.
+        ///
+        /// @pre The lower bound must be less than the upper bound.
+        void SetBounds (double lowerBound, double upperBound)
+        {
+          assert (lowerBound < upperBound);
+
+          m_lowerBound = lowerBound;
+          m_upperBound = upperBound;
+
+          // Make sure that the edge falloff curves do not overlap.
+          SetEdgeFalloff (m_edgeFalloff);
+        }
+
+        /// Sets the falloff value at the edge transition.
+        void SetEdgeFalloff (double edgeFalloff)
+        {
+          // Make sure that the edge falloff curves do not overlap.
+          double boundSize = m_upperBound - m_lowerBound;
+          m_edgeFalloff = (edgeFalloff > boundSize / 2)? boundSize / 2:
+            edgeFalloff;
+        }
+
+      protected:
+
+        /// How the output value is combined from the source modules.
+        enum SelectMode
+        {
+          SELECT_SOURCE_0,
+          SELECT_SOURCE_1,
+          BLEND_SOURCE_0_1,
+          BLEND_SOURCE_1_0
+        };
+
+        /// Returns how the output value is combined from the source modules
+        /// for a control value, and the interpolation weight in @a alpha.
+        /// This follows the same rules as noise::module::Select.
+        SelectMode GetSelectMode (double controlValue, double& alpha) const
+        {
+          if (m_edgeFalloff > 0.0) {
+            if (controlValue < (m_lowerBound - m_edgeFalloff)) {
+              return SELECT_SOURCE_0;
+            } else if (controlValue < (m_lowerBound + m_edgeFalloff)) {
+              double lowerCurve = (m_lowerBound - m_edgeFalloff);
+              double upperCurve = (m_lowerBound + m_edgeFalloff);
+              alpha = SCurve3 (
+                (controlValue - lowerCurve) / (upperCurve - lowerCurve));
+              return BLEND_SOURCE_0_1;
+            } else if (controlValue < (m_upperBound - m_edgeFalloff)) {
+              return SELECT_SOURCE_1;
+            } else if (controlValue < (m_upperBound + m_edgeFalloff)) {
+              double lowerCurve = (m_upperBound - m_edgeFalloff);
+              double upperCurve = (m_upperBound + m_edgeFalloff);
+              alpha = SCurve3 (
+                (controlValue - lowerCurve) / (upperCurve - lowerCurve));
+              return BLEND_SOURCE_1_0;
+            } else {
+              return SELECT_SOURCE_0;
+            }
+          } else {
+            if (controlValue < m_lowerBound || controlValue > m_upperBound) {
+              return SELECT_SOURCE_0;
+            } else {
+              return SELECT_SOURCE_1;
+            }
+          }
+        }
+
+        /// The control module.
+        Control m_control;
+
+        /// Edge-falloff value.
+        double m_edgeFalloff;
+
+        /// Lower bound of the selection range.
+        double m_lowerBound;
+
+        /// The first source module.
+        Source0 m_source0;
+
+        /// The second source module.
+        Source1 m_source1;
+
+        /// Upper bound of the selection range.
+        double m_upperBound;
+
+    };
+
+    /// Noise module that moves the coordinates of the input value before
+    /// returning the output value from a source module, see
+    /// noise::module::TranslatePoint.
+    template <class Source>
+    class TranslatePoint
+    {
+
+      public:
+
+        /// Constructor.
+        TranslatePoint ():
+          m_xTranslation (noise::module::DEFAULT_TRANSLATE_POINT_X),
+          m_yTranslation (noise::module::DEFAULT_TRANSLATE_POINT_Y)
+        {
+        }
+
+        /// Returns the source module.
+        Source& GetSourceModule0 ()
+        {
+          return m_source;
+        }
+
+        /// Returns the source module.
+        const Source& GetSourceModule0 () const
+        {
+          return m_source;
+        }
+
+        double GetValue (double x, double y) const
+        {
+          return m_source.GetValue (x + m_xTranslation, y + m_yTranslation);
+        }
+
+        double GetValue (double x, double y, double footprint) const
+        {
+          return m_source.GetValue (x + m_xTranslation, y + m_yTranslation,
+            footprint);
+        }
+
+        void GetValues (const double* xs, const double* ys, double* out,
+          size_t n) const
+        {
+          double nx[noise::module::BATCH_BLOCK_SIZE];
+          double ny[noise::module::BATCH_BLOCK_SIZE];
+          for (size_t i = 0; i < n; i += noise::module::BATCH_BLOCK_SIZE) {
+            size_t count = GetMin (n - i,
+              (size_t)noise::module::BATCH_BLOCK_SIZE);
+            const double* x = xs + i;
+            const double* y = ys + i;
+            for (size_t j = 0; j < count; j++) {
+              nx[j] = x[j] + m_xTranslation;
+              ny[j] = y[j] + m_yTranslation;
+            }
+            m_source.GetValues (nx, ny, out + i, count);
+          }
+        }
+
+        /// Returns the translation amount applied to the @a x coordinate of
+        /// the input value.
+        double GetXTranslation () const
+        {
+          return m_xTranslation;
+        }
+
+        /// Returns the translation amount applied to the @a y coordinate of
+        /// the input value.
+        double GetYTranslation () const
+        {
+          return m_yTranslation;
+        }
+
+        /// Sets the translation amount to apply to both coordinates of the
+        /// input value.
+        void SetTranslation (double translation)
+        {
+          m_xTranslation = translation;
+          m_yTranslation = translation;
+        }
+
+        /// Sets the translation amounts to apply to the ( @a x, @a y )
+        /// coordinates of the input value.
+        void SetTranslation (double xTranslation, double yTranslation)
+        {
+          m_xTranslation = xTranslation;
+          m_yTranslation = yTranslation;
+        }
+
+        /// Sets the translation amount to apply to the @a x coordinate of
+        /// the input value.
+        void SetXTranslation (double xTranslation)
+        {
+          m_xTranslation = xTranslation;
+        }
+
+        /// Sets the translation amount to apply to the @a y coordinate of
+        /// the input value.
+        void SetYTranslation (double yTranslation)
+        {
+          m_yTranslation = yTranslation;
+        }
+
+      protected:
+
+        /// The source module.
+        Source m_source;
+
+        /// Translation amount applied to the @a x coordinate of the input
+        /// value.
+        double m_xTranslation;
+
+        /// Translation amount applied to the @a y coordinate of the input
+        /// value.
+        double m_yTranslation;
+
+    };
+
+    /// Noise module of the runtime module graph that outputs the values of
+    /// a composite graph.
+    ///
+    /// This noise module contains the graph and does not require any source
+    /// modules, so a composite graph can be connected to noise::module
+    /// classes and to the noise::utils builders.  Only the call of this
+    /// noise module is virtual.
+    template <class Graph>
+    class ModuleAdapter: public noise::module::Module
+    {
+
+      public:
+
+        /// Constructor.
+        ModuleAdapter ():
+          Module (GetSourceModuleCount ())
+        {
+        }
+
+        /// Constructor.
+        ///
+        /// @param graph The graph to copy into this noise module.
+        ModuleAdapter (const Graph& graph):
+          Module (GetSourceModuleCount ()),
+          m_graph (graph)
+        {
+        }
+
+        /// Returns the graph.
+        Graph& GetGraph ()
+        {
+          return m_graph;
+        }
+
+        /// Returns the graph.
+        const Graph& GetGraph () const
+        {
+          return m_graph;
+        }
+
+        virtual int GetSourceModuleCount () const
+        {
+          return 0;
+        }
+
+        virtual double GetValue (double x, double y) const
+        {
+          return m_graph.GetValue (x, y);
+        }
+
+        virtual double GetValue (double x, double y, double footprint) const
+        {
+          return m_graph.GetValue (x, y, footprint);
+        }
+
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const
+        {
+          m_graph.GetValues (xs, ys, out, n);
+        }
+
+      protected:
+
+        /// The composite graph.
+        Graph m_graph;
+
+    };
+
+    /// @}
+
+    /// @}
+
+    /// @}
+
+  }
+
+}
+
+#endif
@@ -29,3 +29,21 @@ Const::Const ():
   m_constValue (DEFAULT_CONST_VALUE)
 {
 }
+
+void Const::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  for (size_t i = 0; i < n; i++) {
+    out[i] = m_constValue;
+  }
+}
+
+void Const::GetValueGrid (double x0, double y0, double dx, double dy,
+  size_t width, size_t height, double* out, size_t stride) const
+{
+  for (size_t j = 0; j < height; j++) {
+    for (size_t i = 0; i < width; i++) {
+      out[j * stride + i] = m_constValue;
+    }
+  }
+}
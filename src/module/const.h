@@ -78,11 +78,20 @@ namespace noise
           return 0;
         }
 
-        virtual double GetValue (double x, double y, double z) const
+        using Module::GetValue;
+
+        virtual double GetValue (double x, double y) const
         {
           return m_constValue;
         }
 
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
+
+        virtual void GetValueGrid (double x0, double y0, double dx,
+          double dy, size_t width, size_t height, double* out,
+          size_t stride) const;
+
         /// Sets the constant output value for this noise module.
         ///
         /// @param constValue The constant output value for this noise module.
@@ -77,9 +77,20 @@ double Curve::GetValue (double x, double y) const
   assert (m_pSourceModule[0] != NULL);
   assert (m_controlPointCount >= 4);
 
-  // Get the output value from the source module.
-  double sourceModuleValue = m_pSourceModule[0]->GetValue (x, y);
+  // Get the output value from the source module and map it onto the curve.
+  return GetCurveValue (m_pSourceModule[0]->GetValue (x, y));
+}
+
+double Curve::GetValue (double x, double y, double footprint) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_controlPointCount >= 4);
+
+  return GetCurveValue (m_pSourceModule[0]->GetValue (x, y, footprint));
+}
 
+double Curve::GetCurveValue (double sourceModuleValue) const
+{
   // Find the first element in the control point array that has an input value
   // larger than the output value from the source module.
   int indexPos;
@@ -142,3 +153,15 @@ void Curve::InsertAtPos (int insertionPos, double inputValue,
   m_pControlPoints[insertionPos].inputValue  = inputValue ;
   m_pControlPoints[insertionPos].outputValue = outputValue;
 }
+
+void Curve::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_controlPointCount >= 4);
+
+  m_pSourceModule[0]->GetValues (xs, ys, out, n);
+  for (size_t i = 0; i < n; i++) {
+    out[i] = GetCurveValue (out[i]);
+  }
+}
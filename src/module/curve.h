@@ -138,8 +138,20 @@ namespace noise
 
         virtual double GetValue (double x, double y) const;
 
+        virtual double GetValue (double x, double y, double footprint) const;
+
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
+
       protected:
 
+        /// Maps an output value from the source module onto the curve.
+        ///
+        /// @param sourceModuleValue The output value from the source module.
+        ///
+        /// @returns The mapped value.
+        double GetCurveValue (double sourceModuleValue) const;
+
         /// Determines the array index in which to insert the control point
         /// into the internal control point array.
         ///
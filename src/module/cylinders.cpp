@@ -31,14 +31,23 @@ Cylinders::Cylinders ():
 {
 }
 
-double Cylinders::GetValue (double x, double y, double z) const
+double Cylinders::GetValue (double x, double y) const
 {
   x *= m_frequency;
-  z *= m_frequency;
 
-  double distFromCenter = sqrt (x * x + z * z);
+  // The cylinders are oriented along the y axis, hence, only the distance
+  // along the x axis is of interest within the plane.
+  double distFromCenter = fabs (x);
   double distFromSmallerSphere = distFromCenter - floor (distFromCenter);
   double distFromLargerSphere = 1.0 - distFromSmallerSphere;
   double nearestDist = GetMin (distFromSmallerSphere, distFromLargerSphere);
   return 1.0 - (nearestDist * 4.0); // Puts it in the -1.0 to +1.0 range.
 }
+
+void Cylinders::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  for (size_t i = 0; i < n; i++) {
+    out[i] = Cylinders::GetValue (xs[i], ys[i]);
+  }
+}
@@ -21,6 +21,7 @@
 // off every 'zig'.)
 //
 
+#include "../misc.h"
 #include "displace.h"
 
 using namespace noise::module;
@@ -46,3 +47,38 @@ double Displace::GetValue (double x, double y) const
   // the original input value.
   return m_pSourceModule[0]->GetValue (xDisplace, yDisplace);
 }
+
+double Displace::GetValue (double x, double y, double footprint) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+  assert (m_pSourceModule[3] != NULL);
+
+  double xDisplace = x + (m_pSourceModule[1]->GetValue (x, y, footprint));
+  double yDisplace = y + (m_pSourceModule[2]->GetValue (x, y, footprint));
+
+  return m_pSourceModule[0]->GetValue (xDisplace, yDisplace, footprint);
+}
+
+void Displace::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+  assert (m_pSourceModule[3] != NULL);
+
+  double xDisplace[BATCH_BLOCK_SIZE];
+  double yDisplace[BATCH_BLOCK_SIZE];
+  for (size_t i = 0; i < n; i += BATCH_BLOCK_SIZE) {
+    size_t count = GetMin (n - i, (size_t)BATCH_BLOCK_SIZE);
+    m_pSourceModule[1]->GetValues (xs + i, ys + i, xDisplace, count);
+    m_pSourceModule[2]->GetValues (xs + i, ys + i, yDisplace, count);
+    for (size_t j = 0; j < count; j++) {
+      xDisplace[j] = xs[i + j] + xDisplace[j];
+      yDisplace[j] = ys[i + j] + yDisplace[j];
+    }
+    m_pSourceModule[0]->GetValues (xDisplace, yDisplace, out + i, count);
+  }
+}
@@ -38,3 +38,22 @@ double Exponent::GetValue (double x, double y) const
   double value = m_pSourceModule[0]->GetValue (x, y);
   return (pow (fabs ((value + 1.0) / 2.0), m_exponent) * 2.0 - 1.0);
 }
+
+double Exponent::GetValue (double x, double y, double footprint) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  double value = m_pSourceModule[0]->GetValue (x, y, footprint);
+  return (pow (fabs ((value + 1.0) / 2.0), m_exponent) * 2.0 - 1.0);
+}
+
+void Exponent::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  m_pSourceModule[0]->GetValues (xs, ys, out, n);
+  for (size_t i = 0; i < n; i++) {
+    out[i] = (pow (fabs ((out[i] + 1.0) / 2.0), m_exponent) * 2.0 - 1.0);
+  }
+}
@@ -86,6 +86,11 @@ namespace noise
 
         virtual double GetValue (double x, double y) const;
 
+        virtual double GetValue (double x, double y, double footprint) const;
+
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
+
         /// Sets the exponent value to apply to the output value from the
         /// source module.
         ///
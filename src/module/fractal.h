@@ -0,0 +1,912 @@
+// fractal.h
+//
+// Copyright (C) 2026 libnoise2d contributors
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#ifndef NOISE_MODULE_FRACTAL_H
+#define NOISE_MODULE_FRACTAL_H
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+#include "../misc.h"
+#include "../noisegenscalar.h"
+#include "modulebase.h"
+
+// Internal header, not installed.  The fractal engine behind the Perlin,
+// Billow and RidgedMulti noise modules: one octave loop per kind of query
+// (an input value, its partial derivatives, a buffer and a grid of input
+// values), templated on a signal policy that turns the coherent-noise value
+// of each octave into its contribution to the output value.  An
+// optimisation of one of the loops applies to all three modules.
+//
+// A signal policy is constructed from the FractalParams of its module and
+// provides:
+// - State, the state of an input value carried from one octave to the
+//   next, set up by Init(), and Octave(), which returns the contribution of
+//   an octave and updates the state.
+// - DerivState, InitDeriv() and OctaveDeriv(), the same with the partial
+//   derivatives.
+// - Finish(), which turns the sum of the contributions into the output
+//   value.
+// - OctaveCount(), which leaves out the octaves that cannot change any
+//   output value by the tolerance or more, and CanStop(), which stops the
+//   octave loop of a single input value depending on its state.
+//   STOPS_PER_SAMPLE is false if CanStop() always returns false.
+
+namespace noise
+{
+
+  namespace module
+  {
+
+    // The parameters of a fractal noise module used by the octave loops.
+    struct FractalParams
+    {
+      double frequency;
+      double lacunarity;
+      double norm;
+      int seed;
+      int seedMask;
+      int periodX;
+      int periodY;
+      noise::NoiseType noiseType;
+      noise::NoiseQuality noiseQuality;
+
+      // Persistence, only used by PerlinSignal and BillowSignal.
+      double persistence;
+
+      // Permutation tables of the octaves, or NULL if the arithmetic hash
+      // is used.
+      const noise::PermutationTable* pPermutationTables;
+
+      // Spectral weights of the octaves, only used by RidgedSignal.
+      const double* pSpectralWeights;
+    };
+
+    // Octave loop of a single input value, see FractalValue().
+    typedef double (*FractalKernelPtr) (const FractalParams& params, double x,
+      double y, int octaveCount, double tolerance, int& skippedOctaves);
+
+    namespace
+    {
+
+      // Number of grid rows FractalValueGrid() processes at once.
+      const size_t GRID_BLOCK_HEIGHT = 16;
+
+      // Signal policy of Perlin noise: the octaves are weighted by the
+      // powers of the persistence.
+      class PerlinSignal
+      {
+
+        public:
+
+          struct State
+          {
+            double amplitude;
+          };
+
+          typedef State DerivState;
+
+          enum { STOPS_PER_SAMPLE = false };
+
+          PerlinSignal (const FractalParams& params):
+            m_persistence (params.persistence)
+          {
+          }
+
+          void Init (State& state) const
+          {
+            state.amplitude = 1.0;
+          }
+
+          void InitDeriv (DerivState& state) const
+          {
+            Init (state);
+          }
+
+          double Octave (double signal, int curOctave, State& state) const
+          {
+            double value = signal * state.amplitude;
+            state.amplitude *= m_persistence;
+            return value;
+          }
+
+          double OctaveDeriv (double signal, double& dx, double& dy,
+            int curOctave, DerivState& state) const
+          {
+            dx *= state.amplitude;
+            dy *= state.amplitude;
+            return Octave (signal, curOctave, state);
+          }
+
+          double Finish (double value, double norm) const
+          {
+            return value*norm;
+          }
+
+          // The amplitudes of the octaves do not depend on the input value,
+          // so the same octaves are left out for all input values.
+          int OctaveCount (int octaveCount, double norm, double tolerance)
+            const
+          {
+            return ToleranceOctaveCount (m_persistence, norm, octaveCount,
+              tolerance);
+          }
+
+          bool CanStop (const State& state, int curOctave, int octaveCount,
+            double norm, double tolerance) const
+          {
+            return false;
+          }
+
+        protected:
+
+          double m_persistence;
+
+      };
+
+      // Signal policy of billowy noise: the absolute value of each octave,
+      // scaled to the range -1.0 to +1.0, weighted like Perlin noise.
+      class BillowSignal: public PerlinSignal
+      {
+
+        public:
+
+          BillowSignal (const FractalParams& params):
+            PerlinSignal (params)
+          {
+          }
+
+          double Octave (double signal, int curOctave, State& state) const
+          {
+            signal = 2.0 * fabs (signal) - 1.0;
+            return PerlinSignal::Octave (signal, curOctave, state);
+          }
+
+          double OctaveDeriv (double signal, double& dx, double& dy,
+            int curOctave, DerivState& state) const
+          {
+            // Derivative of 2.0 * fabs (signal) - 1.0.
+            double sign = (signal < 0.0)? -2.0: 2.0;
+            dx *= sign;
+            dy *= sign;
+            signal = 2.0 * fabs (signal) - 1.0;
+            return PerlinSignal::OctaveDeriv (signal, dx, dy, curOctave,
+              state);
+          }
+
+      };
+
+      // Signal policy of ridged-multifractal noise, with the weight of each
+      // octave fed back from the signal of the previous one.
+      //
+      // Multifractal code originally written by F. Kenton "Doc Mojo"
+      // Musgrave, 1998.  Modified by jas for use with libnoise.
+      class RidgedSignal
+      {
+
+        public:
+
+          struct State
+          {
+            double weight;
+          };
+
+          struct DerivState
+          {
+            double weight;
+            double weightDx;
+            double weightDy;
+          };
+
+          enum { STOPS_PER_SAMPLE = true };
+
+          // The offset and the gain should be user-defined; they may be
+          // exposed in a future version of libnoise.
+          RidgedSignal (const FractalParams& params):
+            m_gain (2.0),
+            m_offset (1.0),
+            m_pSpectralWeights (params.pSpectralWeights)
+          {
+          }
+
+          void Init (State& state) const
+          {
+            state.weight = 1.0;
+          }
+
+          void InitDeriv (DerivState& state) const
+          {
+            state.weight = 1.0;
+            state.weightDx = 0.0;
+            state.weightDy = 0.0;
+          }
+
+          double Octave (double signal, int curOctave, State& state) const
+          {
+            // Make the ridges.
+            signal = fabs (signal);
+            signal = m_offset - signal;
+
+            // Square the signal to increase the sharpness of the ridges.
+            signal *= signal;
+
+            // The weighting from the previous octave is applied to the
+            // signal.  Larger values have higher weights, producing sharp
+            // points along the ridges.
+            signal *= state.weight;
+
+            // Weight successive contributions by the previous signal.
+            state.weight = signal * m_gain;
+            if (state.weight > 1.0) {
+              state.weight = 1.0;
+            }
+            if (state.weight < 0.0) {
+              state.weight = 0.0;
+            }
+
+            return (signal * m_pSpectralWeights[curOctave]);
+          }
+
+          double OctaveDeriv (double signal, double& dx, double& dy,
+            int curOctave, DerivState& state) const
+          {
+            // Make the ridges: ridge = offset - fabs (signal).
+            double sign = (signal < 0.0)? 1.0: -1.0;
+            double ridge = m_offset - fabs (signal);
+            double ridgeDx = sign * dx;
+            double ridgeDy = sign * dy;
+
+            // Square the ridge and apply the weighting from the previous
+            // octave: signal = ridge * ridge * weight.
+            signal = ridge * ridge;
+            dx = 2.0 * ridge * ridgeDx * state.weight
+              + signal * state.weightDx;
+            dy = 2.0 * ridge * ridgeDy * state.weight
+              + signal * state.weightDy;
+            signal *= state.weight;
+
+            // Weight successive contributions by the previous signal.  The
+            // weight is constant where it is clamped.
+            state.weight = signal * m_gain;
+            state.weightDx = dx * m_gain;
+            state.weightDy = dy * m_gain;
+            if (state.weight > 1.0) {
+              state.weight = 1.0;
+              state.weightDx = state.weightDy = 0.0;
+            }
+            if (state.weight < 0.0) {
+              state.weight = 0.0;
+              state.weightDx = state.weightDy = 0.0;
+            }
+
+            dx *= m_pSpectralWeights[curOctave];
+            dy *= m_pSpectralWeights[curOctave];
+            return (signal * m_pSpectralWeights[curOctave]);
+          }
+
+          double Finish (double value, double norm) const
+          {
+            return (value*norm*-1.0);
+          }
+
+          int OctaveCount (int octaveCount, double norm, double tolerance)
+            const
+          {
+            return octaveCount;
+          }
+
+          // Returns true if the octaves after @a curOctave cannot change the
+          // output value by the tolerance or more.  The signal of an octave
+          // is at most the weight of the previous octave times the squared
+          // offset, and the weight at most the signal times the gain.
+          bool CanStop (const State& state, int curOctave, int octaveCount,
+            double norm, double tolerance) const
+          {
+            double bound = 0.0;
+            double maxSignal = state.weight * m_offset * m_offset;
+            for (int nextOctave = curOctave + 1; nextOctave < octaveCount
+              && bound < tolerance; nextOctave++) {
+              bound += maxSignal * m_pSpectralWeights[nextOctave]
+                * fabs (norm);
+              maxSignal = GetMin (maxSignal * m_gain, 1.0) * m_offset
+                * m_offset;
+            }
+            return bound < tolerance;
+          }
+
+        protected:
+
+          double m_gain;
+
+          double m_offset;
+
+          const double* m_pSpectralWeights;
+
+      };
+
+      // Octave loop of a single input value over the first @a octaveCount
+      // octaves, specialised for a noise type, a noise quality and a lattice
+      // hash.  @a skippedOctaves receives the number of octaves left out by
+      // the tolerance.
+      template <class Signal, NoiseType TYPE, NoiseQuality QUALITY,
+        HashType HASH>
+      double FractalValue (const FractalParams& params, double x, double y,
+        int octaveCount, double tolerance, int& skippedOctaves)
+      {
+        Signal transform (params);
+        typename Signal::State state;
+        transform.Init (state);
+
+        int count = transform.OctaveCount (octaveCount, params.norm,
+          tolerance);
+        skippedOctaves = octaveCount - count;
+
+        double value = 0.0;
+        x *= params.frequency;
+        y *= params.frequency;
+
+        // Evaluate the octaves in parallel SIMD lanes when there are enough
+        // of them and none of them are left out.  The contributions are
+        // still added in octave order, so the result is bit-identical to
+        // the loop below.
+        if (TYPE != TYPE_OPENSIMPLEX && HASH == HASH_ARITHMETIC
+          && params.periodX <= 0 && params.periodY <= 0
+          && !(Signal::STOPS_PER_SAMPLE && tolerance > 0.0)
+          && UseOctaveNoise2D (count)) {
+          double signals[OCTAVE_LANES];
+          OctaveNoise2D<TYPE, QUALITY> (x, y, params.lacunarity, params.seed,
+            params.seedMask, count, signals);
+          for (int curOctave = 0; curOctave < count; curOctave++) {
+            value += transform.Octave (signals[curOctave], curOctave, state);
+          }
+          return transform.Finish (value, params.norm);
+        }
+
+        double periodScale = 1.0;
+
+        for (int curOctave = 0; curOctave < count; curOctave++) {
+
+          // Make sure that these floating-point values have the same range
+          // as a 32-bit integer so that we can pass them to the
+          // coherent-noise functions.
+          double nx = MakeInt32Range (x);
+          double ny = MakeInt32Range (y);
+
+          // Get the coherent-noise value from the input value and add its
+          // contribution to the final result.
+          double signal;
+          int periodX = ScalePeriod (params.periodX, periodScale);
+          int periodY = ScalePeriod (params.periodY, periodScale);
+          if (HASH == HASH_PERMUTATION) {
+            signal = PeriodicNoise2D<TYPE, QUALITY> (nx, ny,
+              PermutationHash (params.pPermutationTables[curOctave]), periodX,
+              periodY);
+          } else {
+            signal = PeriodicNoise2D<TYPE, QUALITY> (nx, ny,
+              ArithmeticHash ((params.seed + curOctave) & params.seedMask),
+              periodX, periodY);
+          }
+          value += transform.Octave (signal, curOctave, state);
+
+          // Stop if the octaves left cannot change the output value by the
+          // tolerance or more.
+          if (tolerance > 0.0 && transform.CanStop (state, curOctave, count,
+            params.norm, tolerance)) {
+            skippedOctaves += count - curOctave - 1;
+            break;
+          }
+
+          // Prepare the next octave.
+          x *= params.lacunarity;
+          y *= params.lacunarity;
+          periodScale *= params.lacunarity;
+        }
+
+        return transform.Finish (value, params.norm);
+      }
+
+      // Adds the contributions of the octaves from OCTAVE to OCTAVES - 1 to
+      // @a value, see FractalValueN().  Each octave is a separate
+      // instantiation with its own octave number, so the compiler sees
+      // the whole octave loop as straight-line code.
+      template <class Signal, NoiseType TYPE, NoiseQuality QUALITY,
+        HashType HASH, int OCTAVE, int OCTAVES>
+      struct UnrolledOctaves
+      {
+        static inline double Sum (const FractalParams& params,
+          const Signal& transform, typename Signal::State& state, double x,
+          double y, double value)
+        {
+          double nx = MakeInt32Range (x);
+          double ny = MakeInt32Range (y);
+          double signal;
+          if (HASH == HASH_PERMUTATION) {
+            signal = Noise2D<TYPE, QUALITY> (nx, ny,
+              PermutationHash (params.pPermutationTables[OCTAVE]));
+          } else {
+            signal = Noise2D<TYPE, QUALITY> (nx, ny,
+              ArithmeticHash ((params.seed + OCTAVE) & params.seedMask));
+          }
+          value += transform.Octave (signal, OCTAVE, state);
+          return UnrolledOctaves<Signal, TYPE, QUALITY, HASH, OCTAVE + 1,
+            OCTAVES>::Sum (params, transform, state, x * params.lacunarity,
+            y * params.lacunarity, value);
+        }
+      };
+
+      template <class Signal, NoiseType TYPE, NoiseQuality QUALITY,
+        HashType HASH, int OCTAVES>
+      struct UnrolledOctaves<Signal, TYPE, QUALITY, HASH, OCTAVES, OCTAVES>
+      {
+        static inline double Sum (const FractalParams& params,
+          const Signal& transform, typename Signal::State& state, double x,
+          double y, double value)
+        {
+          return value;
+        }
+      };
+
+      // Same as FractalValue(), with the octave loop unrolled for exactly
+      // OCTAVES octaves.  The result is bit-identical.  Other octave
+      // counts, a tolerance and a periodic lattice take FractalValue().
+      template <class Signal, int OCTAVES, NoiseType TYPE,
+        NoiseQuality QUALITY, HashType HASH>
+      double FractalValueN (const FractalParams& params, double x, double y,
+        int octaveCount, double tolerance, int& skippedOctaves)
+      {
+        if (octaveCount != OCTAVES || tolerance > 0.0
+          || params.periodX > 0 || params.periodY > 0) {
+          return FractalValue<Signal, TYPE, QUALITY, HASH> (params, x, y,
+            octaveCount, tolerance, skippedOctaves);
+        }
+
+        Signal transform (params);
+        typename Signal::State state;
+        transform.Init (state);
+        skippedOctaves = 0;
+
+        double value = UnrolledOctaves<Signal, TYPE, QUALITY, HASH, 0,
+          OCTAVES>::Sum (params, transform, state, x * params.frequency,
+          y * params.frequency, 0.0);
+        return transform.Finish (value, params.norm);
+      }
+
+      // Returns the octave loop of a single input value for a noise type, a
+      // noise quality and a lattice hash, so that the loop does not need to
+      // branch on them.
+      template <class Signal>
+      FractalKernelPtr GetFractalKernel (NoiseType noiseType,
+        NoiseQuality noiseQuality, HashType hashType)
+      {
+        // Indexed by the noise type, the noise quality and the lattice hash.
+        static const FractalKernelPtr kernels[3][3][2] = {
+          {
+            {&FractalValue<Signal, TYPE_GRADIENT, QUALITY_FAST,
+               HASH_ARITHMETIC>,
+             &FractalValue<Signal, TYPE_GRADIENT, QUALITY_FAST,
+               HASH_PERMUTATION>},
+            {&FractalValue<Signal, TYPE_GRADIENT, QUALITY_STD,
+               HASH_ARITHMETIC>,
+             &FractalValue<Signal, TYPE_GRADIENT, QUALITY_STD,
+               HASH_PERMUTATION>},
+            {&FractalValue<Signal, TYPE_GRADIENT, QUALITY_BEST,
+               HASH_ARITHMETIC>,
+             &FractalValue<Signal, TYPE_GRADIENT, QUALITY_BEST,
+               HASH_PERMUTATION>}
+          },
+          {
+            {&FractalValue<Signal, TYPE_VALUE, QUALITY_FAST,
+               HASH_ARITHMETIC>,
+             &FractalValue<Signal, TYPE_VALUE, QUALITY_FAST,
+               HASH_PERMUTATION>},
+            {&FractalValue<Signal, TYPE_VALUE, QUALITY_STD,
+               HASH_ARITHMETIC>,
+             &FractalValue<Signal, TYPE_VALUE, QUALITY_STD,
+               HASH_PERMUTATION>},
+            {&FractalValue<Signal, TYPE_VALUE, QUALITY_BEST,
+               HASH_ARITHMETIC>,
+             &FractalValue<Signal, TYPE_VALUE, QUALITY_BEST,
+               HASH_PERMUTATION>}
+          },
+          {
+            {&FractalValue<Signal, TYPE_OPENSIMPLEX, QUALITY_FAST,
+               HASH_ARITHMETIC>,
+             &FractalValue<Signal, TYPE_OPENSIMPLEX, QUALITY_FAST,
+               HASH_PERMUTATION>},
+            {&FractalValue<Signal, TYPE_OPENSIMPLEX, QUALITY_STD,
+               HASH_ARITHMETIC>,
+             &FractalValue<Signal, TYPE_OPENSIMPLEX, QUALITY_STD,
+               HASH_PERMUTATION>},
+            {&FractalValue<Signal, TYPE_OPENSIMPLEX, QUALITY_BEST,
+               HASH_ARITHMETIC>,
+             &FractalValue<Signal, TYPE_OPENSIMPLEX, QUALITY_BEST,
+               HASH_PERMUTATION>}
+          }
+        };
+        return kernels[noiseType][noiseQuality][hashType];
+      }
+
+      // Returns the unrolled octave loop of OCTAVES octaves for a noise
+      // type, a noise quality and a lattice hash.
+      template <class Signal, int OCTAVES>
+      FractalKernelPtr GetFractalKernelN (NoiseType noiseType,
+        NoiseQuality noiseQuality, HashType hashType)
+      {
+        // Indexed by the noise type, the noise quality and the lattice hash.
+        static const FractalKernelPtr kernels[2][3][2] = {
+          {
+            {&FractalValueN<Signal, OCTAVES, TYPE_GRADIENT, QUALITY_FAST,
+               HASH_ARITHMETIC>,
+             &FractalValueN<Signal, OCTAVES, TYPE_GRADIENT, QUALITY_FAST,
+               HASH_PERMUTATION>},
+            {&FractalValueN<Signal, OCTAVES, TYPE_GRADIENT, QUALITY_STD,
+               HASH_ARITHMETIC>,
+             &FractalValueN<Signal, OCTAVES, TYPE_GRADIENT, QUALITY_STD,
+               HASH_PERMUTATION>},
+            {&FractalValueN<Signal, OCTAVES, TYPE_GRADIENT, QUALITY_BEST,
+               HASH_ARITHMETIC>,
+             &FractalValueN<Signal, OCTAVES, TYPE_GRADIENT, QUALITY_BEST,
+               HASH_PERMUTATION>}
+          },
+          {
+            {&FractalValueN<Signal, OCTAVES, TYPE_VALUE, QUALITY_FAST,
+               HASH_ARITHMETIC>,
+             &FractalValueN<Signal, OCTAVES, TYPE_VALUE, QUALITY_FAST,
+               HASH_PERMUTATION>},
+            {&FractalValueN<Signal, OCTAVES, TYPE_VALUE, QUALITY_STD,
+               HASH_ARITHMETIC>,
+             &FractalValueN<Signal, OCTAVES, TYPE_VALUE, QUALITY_STD,
+               HASH_PERMUTATION>},
+            {&FractalValueN<Signal, OCTAVES, TYPE_VALUE, QUALITY_BEST,
+               HASH_ARITHMETIC>,
+             &FractalValueN<Signal, OCTAVES, TYPE_VALUE, QUALITY_BEST,
+               HASH_PERMUTATION>}
+          }
+        };
+        return kernels[noiseType][noiseQuality][hashType];
+      }
+
+      // Same as GetFractalKernel(), with an unrolled octave loop for the
+      // octave counts most graphs use.  OpenSimplex noise, whose octaves
+      // are too large to unroll, keeps the loop.
+      template <class Signal>
+      FractalKernelPtr GetUnrolledFractalKernel (NoiseType noiseType,
+        NoiseQuality noiseQuality, HashType hashType, int octaveCount)
+      {
+        if (noiseType != TYPE_OPENSIMPLEX) {
+          switch (octaveCount) {
+            case 6:
+              return GetFractalKernelN<Signal, 6> (noiseType, noiseQuality,
+                hashType);
+            case 8:
+              return GetFractalKernelN<Signal, 8> (noiseType, noiseQuality,
+                hashType);
+          }
+        }
+        return GetFractalKernel<Signal> (noiseType, noiseQuality, hashType);
+      }
+
+      // Octave loop of an input value and its partial derivatives.  The
+      // result is bit-identical to FractalValue() without a tolerance.
+      template <class Signal>
+      double FractalValueDeriv (const FractalParams& params, double x,
+        double y, int octaveCount, double& dx, double& dy)
+      {
+        Signal transform (params);
+        typename Signal::DerivState state;
+        transform.InitDeriv (state);
+
+        double value = 0.0;
+        double curFrequency = params.frequency;
+        double periodScale = 1.0;
+
+        x *= params.frequency;
+        y *= params.frequency;
+        dx = 0.0;
+        dy = 0.0;
+
+        for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+          double nx = MakeInt32Range (x);
+          double ny = MakeInt32Range (y);
+
+          // Get the coherent-noise value and its derivatives with respect to
+          // the scaled input value.
+          int seed = (params.seed + curOctave) & params.seedMask;
+          double signal = 0.0;
+          double signalDx = 0.0;
+          double signalDy = 0.0;
+          int periodX = ScalePeriod (params.periodX, periodScale);
+          int periodY = ScalePeriod (params.periodY, periodScale);
+          if (params.pPermutationTables != NULL) {
+            signal = PeriodicNoise2DDeriv (nx, ny,
+              PermutationHash (params.pPermutationTables[curOctave]), periodX,
+              periodY, params.noiseType, params.noiseQuality, signalDx,
+              signalDy);
+          } else {
+            signal = PeriodicNoise2DDeriv (nx, ny, ArithmeticHash (seed),
+              periodX, periodY, params.noiseType, params.noiseQuality,
+              signalDx, signalDy);
+          }
+
+          // Chain rule for the scaling of the input value.
+          signalDx *= curFrequency;
+          signalDy *= curFrequency;
+
+          value += transform.OctaveDeriv (signal, signalDx, signalDy,
+            curOctave, state);
+          dx += signalDx;
+          dy += signalDy;
+
+          // Prepare the next octave.
+          x *= params.lacunarity;
+          y *= params.lacunarity;
+          curFrequency *= params.lacunarity;
+          periodScale *= params.lacunarity;
+        }
+
+        dx = transform.Finish (dx, params.norm);
+        dy = transform.Finish (dy, params.norm);
+        return transform.Finish (value, params.norm);
+      }
+
+      // Generates the coherent-noise values of an octave for a buffer of
+      // input values that have been passed through MakeInt32Range().
+      inline void OctaveNoise2DBatch (const FractalParams& params,
+        int curOctave, const double* nx, const double* ny, double* signal,
+        size_t count)
+      {
+        const PermutationTable* pTable = (params.pPermutationTables != NULL)?
+          &params.pPermutationTables[curOctave]: NULL;
+        int seed = (params.seed + curOctave) & params.seedMask;
+        switch (params.noiseType)
+        {
+          case noise::TYPE_GRADIENT:
+            if (pTable != NULL) {
+              GradientCoherentNoise2DBatch (nx, ny, signal, count, *pTable,
+                params.noiseQuality);
+            } else {
+              GradientCoherentNoise2DBatch (nx, ny, signal, count, seed,
+                params.noiseQuality);
+            }
+            break;
+          case noise::TYPE_VALUE:
+            if (pTable != NULL) {
+              ValueCoherentNoise2DBatch (nx, ny, signal, count, *pTable,
+                params.noiseQuality);
+            } else {
+              ValueCoherentNoise2DBatch (nx, ny, signal, count, seed,
+                params.noiseQuality);
+            }
+            break;
+          case noise::TYPE_OPENSIMPLEX:
+            if (pTable != NULL) {
+              OpenSimplexNoise2DBatch (nx, ny, signal, count, *pTable);
+            } else {
+              OpenSimplexNoise2DBatch (nx, ny, signal, count, seed);
+            }
+            break;
+        }
+      }
+
+      // Generates the coherent-noise values of an octave for a grid of
+      // @a columns by @a rows input values that have been passed through
+      // MakeInt32Range(), stored row by row in @a signal.
+      inline void OctaveNoise2DGrid (const FractalParams& params,
+        int curOctave, const double* nx, size_t columns, const double* ny,
+        size_t rows, double* signal)
+      {
+        double nyRow[BATCH_BLOCK_SIZE];
+        const PermutationTable* pTable = (params.pPermutationTables != NULL)?
+          &params.pPermutationTables[curOctave]: NULL;
+        int seed = (params.seed + curOctave) & params.seedMask;
+        switch (params.noiseType)
+        {
+          case noise::TYPE_GRADIENT:
+            if (pTable != NULL) {
+              GradientCoherentNoise2DGrid (nx, columns, ny, rows, signal,
+                columns, *pTable, params.noiseQuality);
+            } else {
+              GradientCoherentNoise2DGrid (nx, columns, ny, rows, signal,
+                columns, seed, params.noiseQuality);
+            }
+            break;
+          case noise::TYPE_VALUE:
+            if (pTable != NULL) {
+              ValueCoherentNoise2DGrid (nx, columns, ny, rows, signal,
+                columns, *pTable, params.noiseQuality);
+            } else {
+              ValueCoherentNoise2DGrid (nx, columns, ny, rows, signal,
+                columns, seed, params.noiseQuality);
+            }
+            break;
+          case noise::TYPE_OPENSIMPLEX:
+            // The triangles of OpenSimplex noise are not aligned with the
+            // grid, so there are no lattice points to share between rows.
+            for (size_t j = 0; j < rows; j++) {
+              for (size_t i = 0; i < columns; i++) {
+                nyRow[i] = ny[j];
+              }
+              OctaveNoise2DBatch (params, curOctave, nx, nyRow,
+                signal + j * columns, columns);
+            }
+            break;
+        }
+      }
+
+      // Octave loop of a buffer of input values.  The batch noise functions
+      // have no periodic lattice, and a tolerance that depends on the state
+      // of an input value stops its octave loop on its own, so then the
+      // input values are evaluated one by one by @a pKernel.
+      template <class Signal>
+      void FractalValues (const FractalParams& params,
+        FractalKernelPtr pKernel, const double* xs, const double* ys,
+        double* out, size_t n, int octaveCount, double tolerance)
+      {
+        if (params.periodX > 0 || params.periodY > 0
+          || (Signal::STOPS_PER_SAMPLE && tolerance > 0.0)) {
+          int skippedOctaves;
+          for (size_t i = 0; i < n; i++) {
+            out[i] = pKernel (params, xs[i], ys[i], octaveCount, tolerance,
+              skippedOctaves);
+          }
+          return;
+        }
+
+        Signal transform (params);
+        octaveCount = transform.OctaveCount (octaveCount, params.norm,
+          tolerance);
+
+        double x[BATCH_BLOCK_SIZE];
+        double y[BATCH_BLOCK_SIZE];
+        double nx[BATCH_BLOCK_SIZE];
+        double ny[BATCH_BLOCK_SIZE];
+        double signal[BATCH_BLOCK_SIZE];
+        typename Signal::State state[BATCH_BLOCK_SIZE];
+
+        for (size_t i = 0; i < n; i += BATCH_BLOCK_SIZE) {
+          size_t count = GetMin (n - i, (size_t)BATCH_BLOCK_SIZE);
+          double* value = out + i;
+          for (size_t j = 0; j < count; j++) {
+            x[j] = xs[i + j] * params.frequency;
+            y[j] = ys[i + j] * params.frequency;
+            value[j] = 0.0;
+            transform.Init (state[j]);
+          }
+
+          // Process the whole block octave by octave, so that the noise type
+          // and the octave parameters are only evaluated once per block.
+          for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+            for (size_t j = 0; j < count; j++) {
+              nx[j] = MakeInt32Range (x[j]);
+              ny[j] = MakeInt32Range (y[j]);
+            }
+
+            OctaveNoise2DBatch (params, curOctave, nx, ny, signal, count);
+
+            for (size_t j = 0; j < count; j++) {
+              value[j] += transform.Octave (signal[j], curOctave, state[j]);
+
+              // Prepare the next octave.
+              x[j] *= params.lacunarity;
+              y[j] *= params.lacunarity;
+            }
+          }
+
+          for (size_t j = 0; j < count; j++) {
+            value[j] = transform.Finish (value[j], params.norm);
+          }
+        }
+      }
+
+      // Octave loop of a regular grid of input values, see
+      // Perlin::GetValueGrid().  Falls back to @a pKernel like
+      // FractalValues().
+      template <class Signal>
+      void FractalValueGrid (const FractalParams& params,
+        FractalKernelPtr pKernel, double x0, double y0, double dx, double dy,
+        size_t width, size_t height, double* out, size_t stride,
+        int octaveCount, double tolerance)
+      {
+        if (params.periodX > 0 || params.periodY > 0
+          || (Signal::STOPS_PER_SAMPLE && tolerance > 0.0)) {
+          int skippedOctaves;
+          for (size_t j = 0; j < height; j++) {
+            for (size_t i = 0; i < width; i++) {
+              out[j * stride + i] = pKernel (params, x0 + (double)i * dx,
+                y0 + (double)j * dy, octaveCount, tolerance, skippedOctaves);
+            }
+          }
+          return;
+        }
+
+        Signal transform (params);
+        octaveCount = transform.OctaveCount (octaveCount, params.norm,
+          tolerance);
+
+        double x[BATCH_BLOCK_SIZE];
+        double y[GRID_BLOCK_HEIGHT];
+        double nx[BATCH_BLOCK_SIZE];
+        double ny[GRID_BLOCK_HEIGHT];
+        double signal[GRID_BLOCK_HEIGHT * BATCH_BLOCK_SIZE];
+        typename Signal::State state[GRID_BLOCK_HEIGHT * BATCH_BLOCK_SIZE];
+
+        for (size_t j0 = 0; j0 < height; j0 += GRID_BLOCK_HEIGHT) {
+          size_t rows = GetMin (height - j0, GRID_BLOCK_HEIGHT);
+          for (size_t i0 = 0; i0 < width; i0 += BATCH_BLOCK_SIZE) {
+            size_t columns = GetMin (width - i0, (size_t)BATCH_BLOCK_SIZE);
+            double* value = out + j0 * stride + i0;
+            for (size_t i = 0; i < columns; i++) {
+              x[i] = (x0 + (double)(i0 + i) * dx) * params.frequency;
+            }
+            for (size_t j = 0; j < rows; j++) {
+              y[j] = (y0 + (double)(j0 + j) * dy) * params.frequency;
+              for (size_t i = 0; i < columns; i++) {
+                value[j * stride + i] = 0.0;
+                transform.Init (state[j * columns + i]);
+              }
+            }
+
+            // The coordinates of a grid are separable, so they are scaled
+            // per column and per row only.
+            for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+              for (size_t i = 0; i < columns; i++) {
+                nx[i] = MakeInt32Range (x[i]);
+              }
+              for (size_t j = 0; j < rows; j++) {
+                ny[j] = MakeInt32Range (y[j]);
+              }
+
+              OctaveNoise2DGrid (params, curOctave, nx, columns, ny, rows,
+                signal);
+
+              for (size_t j = 0; j < rows; j++) {
+                for (size_t i = 0; i < columns; i++) {
+                  value[j * stride + i] += transform.Octave (
+                    signal[j * columns + i], curOctave,
+                    state[j * columns + i]);
+                }
+              }
+
+              // Prepare the next octave.
+              for (size_t i = 0; i < columns; i++) {
+                x[i] *= params.lacunarity;
+              }
+              for (size_t j = 0; j < rows; j++) {
+                y[j] *= params.lacunarity;
+              }
+            }
+
+            for (size_t j = 0; j < rows; j++) {
+              for (size_t i = 0; i < columns; i++) {
+                value[j * stride + i] = transform.Finish (
+                  value[j * stride + i], params.norm);
+              }
+            }
+          }
+        }
+      }
+
+    }
+
+  }
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,1042 @@
+// graphcompiler.cpp
+//
+// Copyright (C) 2026 libnoise2d contributors
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include <cmath>
+#include <typeinfo>
+#include "../interp.h"
+#include "../misc.h"
+#include "abs.h"
+#include "add.h"
+#include "blend.h"
+#include "cache.h"
+#include "clamp.h"
+#include "const.h"
+#include "displace.h"
+#include "exponent.h"
+#include "graphcompiler.h"
+#include "invert.h"
+#include "max.h"
+#include "min.h"
+#include "multiply.h"
+#include "power.h"
+#include "rotatepoint.h"
+#include "scalebias.h"
+#include "scalepoint.h"
+#include "select.h"
+#include "translatepoint.h"
+
+using namespace noise;
+using namespace noise::module;
+
+namespace
+{
+
+  // Number of register values that GraphCompiler::GetValues() keeps on the
+  // stack, enough for a full block of a graph with up to 16 registers.
+  const size_t GRAPH_STACK_STORAGE_SIZE = 4096;
+
+  // Number of registers that GraphCompiler::GetValue() keeps on the stack.
+  const size_t GRAPH_VALUE_STORAGE_SIZE = 512;
+
+  // How the output value of a Select module is combined from its source
+  // modules, see Select::GetValues().
+  enum SelectMode
+  {
+    SELECT_SOURCE_0,
+    SELECT_SOURCE_1,
+    BLEND_SOURCE_0_1,
+    BLEND_SOURCE_1_0
+  };
+
+  // Returns how a Select module combines its source modules for a control
+  // value, and the interpolation weight in @a alpha.  This follows the same
+  // rules as Select::GetValues().
+  inline SelectMode GetSelectMode (double controlValue, double lowerBound,
+    double upperBound, double edgeFalloff, double& alpha)
+  {
+    if (edgeFalloff > 0.0) {
+      if (controlValue < (lowerBound - edgeFalloff)) {
+        return SELECT_SOURCE_0;
+      } else if (controlValue < (lowerBound + edgeFalloff)) {
+        double lowerCurve = (lowerBound - edgeFalloff);
+        double upperCurve = (lowerBound + edgeFalloff);
+        alpha = SCurve3 (
+          (controlValue - lowerCurve) / (upperCurve - lowerCurve));
+        return BLEND_SOURCE_0_1;
+      } else if (controlValue < (upperBound - edgeFalloff)) {
+        return SELECT_SOURCE_1;
+      } else if (controlValue < (upperBound + edgeFalloff)) {
+        double lowerCurve = (upperBound - edgeFalloff);
+        double upperCurve = (upperBound + edgeFalloff);
+        alpha = SCurve3 (
+          (controlValue - lowerCurve) / (upperCurve - lowerCurve));
+        return BLEND_SOURCE_1_0;
+      } else {
+        return SELECT_SOURCE_0;
+      }
+    } else {
+      if (controlValue < lowerBound || controlValue > upperBound) {
+        return SELECT_SOURCE_0;
+      } else {
+        return SELECT_SOURCE_1;
+      }
+    }
+  }
+
+  // Returns an output value of a Clamp module, see Clamp::GetValues().
+  inline double GetClampedValue (double value, double lowerBound,
+    double upperBound)
+  {
+    if (value < lowerBound) {
+      return lowerBound;
+    } else if (value > upperBound) {
+      return upperBound;
+    } else {
+      return value;
+    }
+  }
+
+  // Returns true if a value is negative zero, which leaves any value
+  // unchanged when added to it.
+  inline bool IsNegativeZero (double value)
+  {
+    return value == 0.0 && 1.0 / value < 0.0;
+  }
+
+  // Returns true if a Select module needs the output value of a source
+  // module for a control value.
+  inline bool NeedsSource (double controlValue, double lowerBound,
+    double upperBound, double edgeFalloff, int sourceIndex)
+  {
+    double alpha;
+    SelectMode mode = GetSelectMode (controlValue, lowerBound, upperBound,
+      edgeFalloff, alpha);
+    return (sourceIndex == 0)? (mode != SELECT_SOURCE_1):
+      (mode != SELECT_SOURCE_0);
+  }
+
+}
+
+GraphCompiler::GraphCompiler ():
+  Module (GetSourceModuleCount ()),
+  m_eliminatedInstructionCount (0),
+  m_storageRegisterCount (0),
+  m_reassociate (false)
+{
+  for (int i = 0; i < SIMPLIFICATION_COUNT; i++) {
+    m_simplificationCount[i] = 0;
+  }
+}
+
+int GraphCompiler::AddInstruction (int program, Opcode opcode, int src0,
+  int src1, int src2, double param0, double param1, double param2,
+  double param3)
+{
+  Program& target = m_programs[program];
+  Instruction instruction;
+  instruction.opcode = opcode;
+  instruction.dst = target.registerCount++;
+  instruction.src[0] = src0;
+  instruction.src[1] = src1;
+  instruction.src[2] = src2;
+  instruction.param[0] = param0;
+  instruction.param[1] = param1;
+  instruction.param[2] = param2;
+  instruction.param[3] = param3;
+  instruction.pModule = NULL;
+  instruction.program = -1;
+  target.instructions.push_back (instruction);
+  return instruction.dst;
+}
+
+void GraphCompiler::Compile (const Module& root)
+{
+  m_programs.clear ();
+  m_compiledNodes.clear ();
+  m_pSourceModule[0] = NULL;
+  m_eliminatedInstructionCount = 0;
+  m_storageRegisterCount = 0;
+  for (int i = 0; i < SIMPLIFICATION_COUNT; i++) {
+    m_simplificationCount[i] = 0;
+  }
+
+  try {
+    int program = NewProgram ();
+    m_programs[program].result = CompileModule (program, root, X_REGISTER,
+      Y_REGISTER);
+    Simplify ();
+  } catch (...) {
+    m_programs.clear ();
+    m_compiledNodes.clear ();
+    throw;
+  }
+
+  // The registers of all programs are stored together.
+  for (size_t i = 0; i < m_programs.size (); i++) {
+    m_programs[i].registerOffset = m_storageRegisterCount;
+    m_storageRegisterCount += m_programs[i].registerCount - 2;
+  }
+
+  // The compiled nodes are only needed while compiling.
+  m_compiledNodes.clear ();
+  m_pSourceModule[0] = &root;
+}
+
+int GraphCompiler::CompileModule (int program, const Module& module,
+  int xRegister, int yRegister)
+{
+  // Reuse the output values of a noise module that has already been
+  // compiled for the same input values.
+  for (size_t i = 0; i < m_compiledNodes[program].size (); i++) {
+    const CompiledNode& node = m_compiledNodes[program][i];
+    if (node.pModule == &module && node.xRegister == xRegister
+      && node.yRegister == yRegister) {
+      return node.result;
+    }
+  }
+
+  // Only noise modules of exactly these classes are compiled into
+  // instructions.  A subclass may override the output values, so it is
+  // called like any other noise module.
+  int result;
+  if (typeid (module) == typeid (Cache)) {
+    // Reusing compiled nodes already caches the output values.
+    result = CompileModule (program, module.GetSourceModule (0), xRegister,
+      yRegister);
+  } else if (typeid (module) == typeid (Const)) {
+    const Const* pConst = static_cast<const Const*> (&module);
+    result = AddInstruction (program, OP_CONST, -1, -1, -1,
+      pConst->GetConstValue ());
+  } else if (typeid (module) == typeid (Add)
+    || typeid (module) == typeid (Multiply)
+    || typeid (module) == typeid (Max)
+    || typeid (module) == typeid (Min)
+    || typeid (module) == typeid (Power)) {
+    Opcode opcode = OP_POWER;
+    if (typeid (module) == typeid (Add)) {
+      opcode = OP_ADD;
+    } else if (typeid (module) == typeid (Multiply)) {
+      opcode = OP_MULTIPLY;
+    } else if (typeid (module) == typeid (Max)) {
+      opcode = OP_MAX;
+    } else if (typeid (module) == typeid (Min)) {
+      opcode = OP_MIN;
+    }
+    int v0 = CompileModule (program, module.GetSourceModule (0), xRegister,
+      yRegister);
+    int v1 = CompileModule (program, module.GetSourceModule (1), xRegister,
+      yRegister);
+    result = AddInstruction (program, opcode, v0, v1);
+  } else if (typeid (module) == typeid (Abs)) {
+    result = AddInstruction (program, OP_ABS, CompileModule (program,
+      module.GetSourceModule (0), xRegister, yRegister));
+  } else if (typeid (module) == typeid (Invert)) {
+    result = AddInstruction (program, OP_INVERT, CompileModule (program,
+      module.GetSourceModule (0), xRegister, yRegister));
+  } else if (typeid (module) == typeid (ScaleBias)) {
+    const ScaleBias* pScaleBias = static_cast<const ScaleBias*> (&module);
+    result = AddInstruction (program, OP_SCALE_BIAS, CompileModule (program,
+      module.GetSourceModule (0), xRegister, yRegister), -1, -1,
+      pScaleBias->GetScale (), pScaleBias->GetBias ());
+  } else if (typeid (module) == typeid (Clamp)) {
+    const Clamp* pClamp = static_cast<const Clamp*> (&module);
+    result = AddInstruction (program, OP_CLAMP, CompileModule (program,
+      module.GetSourceModule (0), xRegister, yRegister), -1, -1,
+      pClamp->GetLowerBound (), pClamp->GetUpperBound ());
+  } else if (typeid (module) == typeid (Exponent)) {
+    const Exponent* pExponent = static_cast<const Exponent*> (&module);
+    result = AddInstruction (program, OP_EXPONENT, CompileModule (program,
+      module.GetSourceModule (0), xRegister, yRegister), -1, -1,
+      pExponent->GetExponent ());
+  } else if (typeid (module) == typeid (ScalePoint)) {
+    const ScalePoint* pScalePoint = static_cast<const ScalePoint*> (&module);
+    int nx = AddInstruction (program, OP_SCALE, xRegister, -1, -1,
+      pScalePoint->GetXScale ());
+    int ny = AddInstruction (program, OP_SCALE, yRegister, -1, -1,
+      pScalePoint->GetYScale ());
+    result = CompileModule (program, module.GetSourceModule (0), nx, ny);
+  } else if (typeid (module) == typeid (TranslatePoint)) {
+    const TranslatePoint* pTranslatePoint =
+      static_cast<const TranslatePoint*> (&module);
+    int nx = AddInstruction (program, OP_TRANSLATE, xRegister, -1, -1,
+      pTranslatePoint->GetXTranslation ());
+    int ny = AddInstruction (program, OP_TRANSLATE, yRegister, -1, -1,
+      pTranslatePoint->GetYTranslation ());
+    result = CompileModule (program, module.GetSourceModule (0), nx, ny);
+  } else if (typeid (module) == typeid (RotatePoint)) {
+    const RotatePoint* pRotatePoint =
+      static_cast<const RotatePoint*> (&module);
+    int nx = AddInstruction (program, OP_ROTATE, xRegister, yRegister, -1,
+      pRotatePoint->m_x1Matrix, pRotatePoint->m_y1Matrix);
+    int ny = AddInstruction (program, OP_ROTATE, xRegister, yRegister, -1,
+      pRotatePoint->m_x2Matrix, pRotatePoint->m_y2Matrix);
+    result = CompileModule (program, module.GetSourceModule (0), nx, ny);
+  } else if (typeid (module) == typeid (Displace)) {
+    int xDisplace = CompileModule (program, module.GetSourceModule (1),
+      xRegister, yRegister);
+    int yDisplace = CompileModule (program, module.GetSourceModule (2),
+      xRegister, yRegister);
+    int nx = AddInstruction (program, OP_ADD, xRegister, xDisplace);
+    int ny = AddInstruction (program, OP_ADD, yRegister, yDisplace);
+    result = CompileModule (program, module.GetSourceModule (0), nx, ny);
+  } else if (typeid (module) == typeid (Blend)) {
+    int v0 = CompileModule (program, module.GetSourceModule (0), xRegister,
+      yRegister);
+    int v1 = CompileModule (program, module.GetSourceModule (1), xRegister,
+      yRegister);
+    int alpha = CompileModule (program, module.GetSourceModule (2),
+      xRegister, yRegister);
+    result = AddInstruction (program, OP_BLEND, v0, v1, alpha);
+  } else if (typeid (module) == typeid (Select)) {
+    const Select* pSelect = static_cast<const Select*> (&module);
+    // Each source module gets its own program, which only runs for the
+    // input values that need it.  Its coordinates are gathered into the
+    // coordinate registers of that program.
+    int control = CompileModule (program, module.GetSourceModule (2),
+      xRegister, yRegister);
+    int v[2];
+    for (int sourceIndex = 0; sourceIndex < 2; sourceIndex++) {
+      int sourceProgram = NewProgram ();
+      m_programs[sourceProgram].result = CompileModule (sourceProgram,
+        module.GetSourceModule (sourceIndex), X_REGISTER, Y_REGISTER);
+      v[sourceIndex] = AddInstruction (program, OP_GATHER, control,
+        xRegister, yRegister, pSelect->GetLowerBound (),
+        pSelect->GetUpperBound (), pSelect->GetEdgeFalloff (),
+        sourceIndex);
+      m_programs[program].instructions.back ().program = sourceProgram;
+    }
+    result = AddInstruction (program, OP_SELECT, control, v[0], v[1],
+      pSelect->GetLowerBound (), pSelect->GetUpperBound (),
+      pSelect->GetEdgeFalloff ());
+  } else {
+    result = AddInstruction (program, OP_MODULE, xRegister, yRegister);
+    m_programs[program].instructions.back ().pModule = &module;
+  }
+
+  CompiledNode node;
+  node.pModule = &module;
+  node.xRegister = xRegister;
+  node.yRegister = yRegister;
+  node.result = result;
+  m_compiledNodes[program].push_back (node);
+  return result;
+}
+
+inline double GraphCompiler::EvaluateInstruction (
+  const Instruction& instruction, const double* operand)
+{
+  const double* param = instruction.param;
+  switch (instruction.opcode) {
+    case OP_CONST:
+      return param[0];
+    case OP_ADD:
+      return operand[0] + operand[1];
+    case OP_MULTIPLY:
+      return operand[0] * operand[1];
+    case OP_MAX:
+      return GetMax (operand[0], operand[1]);
+    case OP_MIN:
+      return GetMin (operand[0], operand[1]);
+    case OP_POWER:
+      return pow (operand[0], operand[1]);
+    case OP_ABS:
+      return fabs (operand[0]);
+    case OP_INVERT:
+      return -operand[0];
+    case OP_SCALE_BIAS:
+      return operand[0] * param[0] + param[1];
+    case OP_CLAMP:
+      return GetClampedValue (operand[0], param[0], param[1]);
+    case OP_EXPONENT:
+      return (pow (fabs ((operand[0] + 1.0) / 2.0), param[0]) * 2.0 - 1.0);
+    case OP_SCALE:
+      return operand[0] * param[0];
+    case OP_TRANSLATE:
+      return operand[0] + param[0];
+    case OP_ROTATE:
+      return (param[0] * operand[0]) + (param[1] * operand[1]);
+    case OP_BLEND:
+      return LinearInterp (operand[0], operand[1],
+        (operand[2] + 1.0) / 2.0);
+    case OP_LERP:
+      return LinearInterp (operand[0], operand[1], param[0]);
+    default:
+      // The other instructions depend on the coordinates of the input
+      // values.
+      assert (false);
+      return 0.0;
+  }
+}
+
+int GraphCompiler::GetInstructionCount () const
+{
+  int instructionCount = 0;
+  for (size_t i = 0; i < m_programs.size (); i++) {
+    instructionCount += (int)m_programs[i].instructions.size ();
+  }
+  return instructionCount;
+}
+
+int GraphCompiler::GetRegisterCount () const
+{
+  int registerCount = 0;
+  for (size_t i = 0; i < m_programs.size (); i++) {
+    registerCount += m_programs[i].registerCount;
+  }
+  return registerCount;
+}
+
+double GraphCompiler::GetValue (double x, double y) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  // One value per register fits on the stack for all but huge graphs.
+  if (m_storageRegisterCount + 2 * m_programs.size ()
+    <= GRAPH_VALUE_STORAGE_SIZE) {
+    double storage[GRAPH_VALUE_STORAGE_SIZE];
+    return RunProgramValue (0, x, y, storage);
+  } else {
+    double value;
+    GetValues (&x, &y, &value, 1);
+    return value;
+  }
+}
+
+double GraphCompiler::GetValue (double x, double y, double footprint) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  return m_pSourceModule[0]->GetValue (x, y, footprint);
+}
+
+void GraphCompiler::GetValues (const double* xs, const double* ys,
+  double* out, size_t n) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  // The registers are allocated per call so that several threads may
+  // evaluate the program at once.  They are kept on the stack unless the
+  // block does not fit, which spares single input values and small graphs
+  // from allocating memory.
+  size_t stride = GetMin (n, (size_t)BATCH_BLOCK_SIZE);
+  size_t storageSize = m_storageRegisterCount * stride;
+  double stackStorage[GRAPH_STACK_STORAGE_SIZE];
+  std::vector<double> heapStorage;
+  double* storage = stackStorage;
+  if (storageSize > GRAPH_STACK_STORAGE_SIZE) {
+    heapStorage.resize (storageSize);
+    storage = &heapStorage[0];
+  }
+
+  for (size_t i = 0; i < n; i += BATCH_BLOCK_SIZE) {
+    size_t count = GetMin (n - i, (size_t)BATCH_BLOCK_SIZE);
+    RunProgram (0, xs + i, ys + i, out + i, count, storage, stride);
+  }
+}
+
+int GraphCompiler::NewProgram ()
+{
+  Program program;
+  program.registerCount = 2;
+  program.result = X_REGISTER;
+  program.registerOffset = 0;
+  m_programs.push_back (program);
+  m_compiledNodes.push_back (std::vector<CompiledNode> ());
+  return (int)m_programs.size () - 1;
+}
+
+double GraphCompiler::RunProgramValue (int program, double x, double y,
+  double* storage) const
+{
+  const Program& source = m_programs[program];
+  double* registers = storage + source.registerOffset + 2 * program;
+  registers[X_REGISTER] = x;
+  registers[Y_REGISTER] = y;
+
+  for (size_t k = 0; k < source.instructions.size (); k++) {
+    const Instruction& instruction = source.instructions[k];
+    const int* src = instruction.src;
+    const double* param = instruction.param;
+    double& dst = registers[instruction.dst];
+    switch (instruction.opcode) {
+      case OP_MODULE:
+        dst = instruction.pModule->GetValue (registers[src[0]],
+          registers[src[1]]);
+        break;
+      case OP_GATHER:
+        if (NeedsSource (registers[src[0]], param[0], param[1], param[2],
+          (int)param[3])) {
+          dst = RunProgramValue (instruction.program, registers[src[1]],
+            registers[src[2]], storage);
+        }
+        break;
+      case OP_SELECT:
+        {
+          double alpha;
+          switch (GetSelectMode (registers[src[0]], param[0], param[1],
+            param[2], alpha)) {
+            case SELECT_SOURCE_0:
+              dst = registers[src[1]];
+              break;
+            case SELECT_SOURCE_1:
+              dst = registers[src[2]];
+              break;
+            case BLEND_SOURCE_0_1:
+              dst = LinearInterp (registers[src[1]], registers[src[2]],
+                alpha);
+              break;
+            case BLEND_SOURCE_1_0:
+              dst = LinearInterp (registers[src[2]], registers[src[1]],
+                alpha);
+              break;
+          }
+        }
+        break;
+      default:
+        {
+          double operand[3];
+          for (int i = 0; i < 3; i++) {
+            operand[i] = (src[i] >= 0)? registers[src[i]]: 0.0;
+          }
+          dst = EvaluateInstruction (instruction, operand);
+        }
+        break;
+    }
+  }
+  return registers[source.result];
+}
+
+void GraphCompiler::RunProgram (int program, const double* xs,
+  const double* ys, double* out, size_t count, double* storage,
+  size_t stride) const
+{
+  const Program& source = m_programs[program];
+  double* registers = storage + source.registerOffset * stride;
+#define NOISE_REGISTER(index) ((index) == X_REGISTER? xs: \
+  ((index) == Y_REGISTER? ys: registers + ((index) - 2) * stride))
+
+  for (size_t k = 0; k < source.instructions.size (); k++) {
+    const Instruction& instruction = source.instructions[k];
+    double* dst = registers + (instruction.dst - 2) * stride;
+    const double* a = (instruction.src[0] >= 0)?
+      NOISE_REGISTER (instruction.src[0]): NULL;
+    const double* b = (instruction.src[1] >= 0)?
+      NOISE_REGISTER (instruction.src[1]): NULL;
+    const double* c = (instruction.src[2] >= 0)?
+      NOISE_REGISTER (instruction.src[2]): NULL;
+    const double* param = instruction.param;
+
+    switch (instruction.opcode) {
+      case OP_CONST:
+        for (size_t j = 0; j < count; j++) {
+          dst[j] = param[0];
+        }
+        break;
+      case OP_ADD:
+        for (size_t j = 0; j < count; j++) {
+          dst[j] = a[j] + b[j];
+        }
+        break;
+      case OP_MULTIPLY:
+        for (size_t j = 0; j < count; j++) {
+          dst[j] = a[j] * b[j];
+        }
+        break;
+      case OP_MAX:
+        for (size_t j = 0; j < count; j++) {
+          dst[j] = GetMax (a[j], b[j]);
+        }
+        break;
+      case OP_MIN:
+        for (size_t j = 0; j < count; j++) {
+          dst[j] = GetMin (a[j], b[j]);
+        }
+        break;
+      case OP_POWER:
+        for (size_t j = 0; j < count; j++) {
+          dst[j] = pow (a[j], b[j]);
+        }
+        break;
+      case OP_ABS:
+        for (size_t j = 0; j < count; j++) {
+          dst[j] = fabs (a[j]);
+        }
+        break;
+      case OP_INVERT:
+        for (size_t j = 0; j < count; j++) {
+          dst[j] = -a[j];
+        }
+        break;
+      case OP_SCALE_BIAS:
+        for (size_t j = 0; j < count; j++) {
+          dst[j] = a[j] * param[0] + param[1];
+        }
+        break;
+      case OP_CLAMP:
+        for (size_t j = 0; j < count; j++) {
+          if (a[j] < param[0]) {
+            dst[j] = param[0];
+          } else if (a[j] > param[1]) {
+            dst[j] = param[1];
+          } else {
+            dst[j] = a[j];
+          }
+        }
+        break;
+      case OP_EXPONENT:
+        for (size_t j = 0; j < count; j++) {
+          dst[j] = (pow (fabs ((a[j] + 1.0) / 2.0), param[0]) * 2.0 - 1.0);
+        }
+        break;
+      case OP_SCALE:
+        for (size_t j = 0; j < count; j++) {
+          dst[j] = a[j] * param[0];
+        }
+        break;
+      case OP_TRANSLATE:
+        for (size_t j = 0; j < count; j++) {
+          dst[j] = a[j] + param[0];
+        }
+        break;
+      case OP_ROTATE:
+        for (size_t j = 0; j < count; j++) {
+          dst[j] = (param[0] * a[j]) + (param[1] * b[j]);
+        }
+        break;
+      case OP_BLEND:
+        for (size_t j = 0; j < count; j++) {
+          dst[j] = LinearInterp (a[j], b[j], (c[j] + 1.0) / 2.0);
+        }
+        break;
+      case OP_LERP:
+        for (size_t j = 0; j < count; j++) {
+          dst[j] = LinearInterp (a[j], b[j], param[0]);
+        }
+        break;
+      case OP_MODULE:
+        instruction.pModule->GetValues (a, b, dst, count);
+        break;
+      case OP_GATHER:
+        {
+          double xGather[BATCH_BLOCK_SIZE];
+          double yGather[BATCH_BLOCK_SIZE];
+          double vGather[BATCH_BLOCK_SIZE];
+          size_t index[BATCH_BLOCK_SIZE];
+          size_t gatherCount = 0;
+          for (size_t j = 0; j < count; j++) {
+            if (NeedsSource (a[j], param[0], param[1], param[2],
+              (int)param[3])) {
+              index  [gatherCount] = j;
+              xGather[gatherCount] = b[j];
+              yGather[gatherCount] = c[j];
+              ++gatherCount;
+            }
+          }
+          if (gatherCount > 0) {
+            RunProgram (instruction.program, xGather, yGather, vGather,
+              gatherCount, storage, stride);
+            for (size_t j = 0; j < gatherCount; j++) {
+              dst[index[j]] = vGather[j];
+            }
+          }
+        }
+        break;
+      case OP_SELECT:
+        for (size_t j = 0; j < count; j++) {
+          double alpha;
+          switch (GetSelectMode (a[j], param[0], param[1], param[2],
+            alpha)) {
+            case SELECT_SOURCE_0:
+              dst[j] = b[j];
+              break;
+            case SELECT_SOURCE_1:
+              dst[j] = c[j];
+              break;
+            case BLEND_SOURCE_0_1:
+              dst[j] = LinearInterp (b[j], c[j], alpha);
+              break;
+            case BLEND_SOURCE_1_0:
+              dst[j] = LinearInterp (c[j], b[j], alpha);
+              break;
+          }
+        }
+        break;
+    }
+  }
+
+  const double* result = NOISE_REGISTER (source.result);
+#undef NOISE_REGISTER
+  for (size_t j = 0; j < count; j++) {
+    out[j] = result[j];
+  }
+}
+
+void GraphCompiler::Simplify ()
+{
+  int instructionCount = GetInstructionCount ();
+
+  // A program is only run by the programs that precede it, so the programs
+  // that are still run after simplifying their predecessors are known in
+  // order.  Programs inlined into their predecessors are no longer run.
+  std::vector<bool> isRun (m_programs.size (), false);
+  isRun[0] = true;
+  for (size_t i = 0; i < m_programs.size (); i++) {
+    if (isRun[i]) {
+      SimplifyProgram ((int)i);
+      const std::vector<Instruction>& instructions =
+        m_programs[i].instructions;
+      for (size_t k = 0; k < instructions.size (); k++) {
+        if (instructions[k].opcode == OP_GATHER) {
+          isRun[instructions[k].program] = true;
+        }
+      }
+    }
+  }
+
+  // Remove the programs that are no longer run.
+  std::vector<int> newIndex (m_programs.size (), -1);
+  std::vector<Program> programs;
+  for (size_t i = 0; i < m_programs.size (); i++) {
+    if (isRun[i]) {
+      newIndex[i] = (int)programs.size ();
+      programs.push_back (m_programs[i]);
+    }
+  }
+  for (size_t i = 0; i < programs.size (); i++) {
+    std::vector<Instruction>& instructions = programs[i].instructions;
+    for (size_t k = 0; k < instructions.size (); k++) {
+      if (instructions[k].opcode == OP_GATHER) {
+        instructions[k].program = newIndex[instructions[k].program];
+      }
+    }
+  }
+  m_programs.swap (programs);
+
+  m_eliminatedInstructionCount = instructionCount - GetInstructionCount ();
+}
+
+void GraphCompiler::SimplifyProgram (int program)
+{
+  std::vector<Instruction> input;
+  input.swap (m_programs[program].instructions);
+  std::vector<Instruction>& output = m_programs[program].instructions;
+  std::vector<RegisterInfo> registers;
+
+  for (size_t k = 0; k < input.size (); k++) {
+    // Inlining a program adds registers.
+    while ((int)registers.size () < m_programs[program].registerCount) {
+      RegisterInfo info;
+      info.alias = (int)registers.size ();
+      info.producer = -1;
+      info.isConstant = false;
+      info.constantValue = 0.0;
+      info.lowerBound = -HUGE_VAL;
+      info.upperBound = HUGE_VAL;
+      registers.push_back (info);
+    }
+
+    Instruction instruction = input[k];
+    int* src = instruction.src;
+    double* param = instruction.param;
+    for (int i = 0; i < 3; i++) {
+      if (src[i] >= 0) {
+        while (registers[src[i]].alias != src[i]) {
+          src[i] = registers[src[i]].alias;
+        }
+      }
+    }
+
+    // Rewrite the instruction until no simplification applies, or until it
+    // is replaced by the register of one of its operands.
+    int replacement = -1;
+    bool isRewritten = true;
+    while (isRewritten && replacement < 0) {
+      isRewritten = false;
+      Opcode opcode = instruction.opcode;
+      const RegisterInfo* operand[3];
+      const Instruction* pProducer[3];
+      bool isConstant = (opcode != OP_CONST && opcode != OP_MODULE
+        && opcode != OP_GATHER && opcode != OP_SELECT);
+      double constantValue[3];
+      for (int i = 0; i < 3; i++) {
+        operand[i] = (src[i] >= 0)? &registers[src[i]]: NULL;
+        pProducer[i] = (operand[i] != NULL && operand[i]->producer >= 0)?
+          &output[operand[i]->producer]: NULL;
+        constantValue[i] = (operand[i] != NULL)? operand[i]->constantValue:
+          0.0;
+        if (operand[i] != NULL && !operand[i]->isConstant) {
+          isConstant = false;
+        }
+      }
+
+      if (isConstant) {
+        param[0] = EvaluateInstruction (instruction, constantValue);
+        instruction.opcode = OP_CONST;
+        src[0] = src[1] = src[2] = -1;
+        ++m_simplificationCount[SIMPLIFY_CONSTANT];
+      } else if ((opcode == OP_ADD || opcode == OP_MULTIPLY)
+        && (operand[0]->isConstant || operand[1]->isConstant)) {
+        // v + c is v * 1.0 + c, and v * c is v * c + -0.0.
+        int variable = operand[0]->isConstant? src[1]: src[0];
+        double constant = operand[0]->isConstant? constantValue[0]:
+          constantValue[1];
+        instruction.opcode = OP_SCALE_BIAS;
+        src[0] = variable;
+        src[1] = -1;
+        param[0] = (opcode == OP_ADD)? 1.0: constant;
+        param[1] = (opcode == OP_ADD)? constant: -0.0;
+        isRewritten = true;
+        ++m_simplificationCount[SIMPLIFY_AFFINE];
+      } else if (opcode == OP_INVERT && pProducer[0] != NULL
+        && pProducer[0]->opcode == OP_INVERT) {
+        replacement = pProducer[0]->src[0];
+        ++m_simplificationCount[SIMPLIFY_IDENTITY];
+      } else if (opcode == OP_INVERT && m_reassociate && pProducer[0] != NULL
+        && pProducer[0]->opcode == OP_SCALE_BIAS) {
+        instruction.opcode = OP_SCALE_BIAS;
+        src[0] = pProducer[0]->src[0];
+        param[0] = -pProducer[0]->param[0];
+        param[1] = -pProducer[0]->param[1];
+        isRewritten = true;
+        ++m_simplificationCount[SIMPLIFY_AFFINE];
+      } else if (opcode == OP_SCALE_BIAS && pProducer[0] != NULL
+        && pProducer[0]->opcode == OP_INVERT) {
+        // (-v) * s is exactly v * (-s).
+        src[0] = pProducer[0]->src[0];
+        param[0] = -param[0];
+        isRewritten = true;
+        ++m_simplificationCount[SIMPLIFY_AFFINE];
+      } else if (opcode == OP_SCALE_BIAS && m_reassociate
+        && pProducer[0] != NULL && pProducer[0]->opcode == OP_SCALE_BIAS) {
+        src[0] = pProducer[0]->src[0];
+        param[1] = pProducer[0]->param[1] * param[0] + param[1];
+        param[0] = pProducer[0]->param[0] * param[0];
+        isRewritten = true;
+        ++m_simplificationCount[SIMPLIFY_AFFINE];
+      } else if ((opcode == OP_SCALE_BIAS && param[0] == 1.0
+          && (IsNegativeZero (param[1])
+            || (m_reassociate && param[1] == 0.0)))
+        || (opcode == OP_SCALE && param[0] == 1.0)
+        || (opcode == OP_TRANSLATE && (IsNegativeZero (param[0])
+          || (m_reassociate && param[0] == 0.0)))) {
+        replacement = src[0];
+        ++m_simplificationCount[SIMPLIFY_IDENTITY];
+      } else if (opcode == OP_ROTATE && m_reassociate
+        && ((param[0] == 1.0 && param[1] == 0.0)
+          || (param[0] == 0.0 && param[1] == 1.0))) {
+        replacement = (param[0] == 1.0)? src[0]: src[1];
+        ++m_simplificationCount[SIMPLIFY_IDENTITY];
+      } else if (opcode == OP_CLAMP && operand[0]->lowerBound >= param[0]
+        && operand[0]->upperBound <= param[1]) {
+        replacement = src[0];
+        ++m_simplificationCount[SIMPLIFY_IDENTITY];
+      } else if (opcode == OP_BLEND && operand[2]->isConstant) {
+        instruction.opcode = OP_LERP;
+        src[2] = -1;
+        param[0] = (constantValue[2] + 1.0) / 2.0;
+        isRewritten = true;
+        ++m_simplificationCount[SIMPLIFY_CONTROL];
+      } else if (opcode == OP_LERP && m_reassociate
+        && (param[0] == 0.0 || param[0] == 1.0)) {
+        replacement = (param[0] == 0.0)? src[0]: src[1];
+        ++m_simplificationCount[SIMPLIFY_CONTROL];
+      } else if (opcode == OP_GATHER && operand[0]->isConstant) {
+        if (NeedsSource (constantValue[0], param[0], param[1], param[2],
+          (int)param[3])) {
+          // All input values need the source module, so its program runs
+          // on the coordinates of this program instead.  Its instructions
+          // are simplified next.
+          const Program& source = m_programs[instruction.program];
+          int offset = m_programs[program].registerCount - 2;
+          m_programs[program].registerCount += source.registerCount - 2;
+          std::vector<Instruction> inlined (source.instructions);
+          for (size_t j = 0; j < inlined.size (); j++) {
+            inlined[j].dst += offset;
+            for (int i = 0; i < 3; i++) {
+              int& r = inlined[j].src[i];
+              r = (r == X_REGISTER)? src[1]: ((r == Y_REGISTER)? src[2]:
+                ((r >= 0)? r + offset: r));
+            }
+          }
+          input.insert (input.begin () + k + 1, inlined.begin (),
+            inlined.end ());
+          replacement = (source.result == X_REGISTER)? src[1]:
+            ((source.result == Y_REGISTER)? src[2]: source.result + offset);
+        } else {
+          // The Select module below does not read these output values.
+          replacement = src[0];
+        }
+      } else if (opcode == OP_SELECT && operand[0]->isConstant) {
+        double alpha;
+        switch (GetSelectMode (constantValue[0], param[0], param[1],
+          param[2], alpha)) {
+          case SELECT_SOURCE_0:
+            replacement = src[1];
+            break;
+          case SELECT_SOURCE_1:
+            replacement = src[2];
+            break;
+          case BLEND_SOURCE_0_1:
+            instruction.opcode = OP_LERP;
+            src[0] = src[1];
+            src[1] = src[2];
+            src[2] = -1;
+            param[0] = alpha;
+            isRewritten = true;
+            break;
+          case BLEND_SOURCE_1_0:
+            instruction.opcode = OP_LERP;
+            src[0] = src[2];
+            src[2] = -1;
+            param[0] = alpha;
+            isRewritten = true;
+            break;
+        }
+        ++m_simplificationCount[SIMPLIFY_CONTROL];
+      }
+    }
+    if (replacement >= 0) {
+      registers[instruction.dst].alias = replacement;
+      continue;
+    }
+
+    // Keep track of the constant values and of the bounds of the values,
+    // not counting NaN.  Max and Min modules output the value of their
+    // second source module if the first one is NaN.
+    RegisterInfo& info = registers[instruction.dst];
+    const RegisterInfo* a = (src[0] >= 0)? &registers[src[0]]: NULL;
+    const RegisterInfo* b = (src[1] >= 0)? &registers[src[1]]: NULL;
+    info.producer = (int)output.size ();
+    switch (instruction.opcode) {
+      case OP_CONST:
+        info.isConstant = true;
+        info.constantValue = param[0];
+        info.lowerBound = param[0];
+        info.upperBound = param[0];
+        break;
+      case OP_ADD:
+        info.lowerBound = a->lowerBound + b->lowerBound;
+        info.upperBound = a->upperBound + b->upperBound;
+        break;
+      case OP_MAX:
+        info.lowerBound = b->lowerBound;
+        info.upperBound = GetMax (a->upperBound, b->upperBound);
+        break;
+      case OP_MIN:
+        info.lowerBound = GetMin (a->lowerBound, b->lowerBound);
+        info.upperBound = b->upperBound;
+        break;
+      case OP_ABS:
+        if (a->lowerBound >= 0.0) {
+          info.lowerBound = a->lowerBound;
+          info.upperBound = a->upperBound;
+        } else if (a->upperBound <= 0.0) {
+          info.lowerBound = -a->upperBound;
+          info.upperBound = -a->lowerBound;
+        } else {
+          info.lowerBound = 0.0;
+          info.upperBound = GetMax (-a->lowerBound, a->upperBound);
+        }
+        break;
+      case OP_INVERT:
+        info.lowerBound = -a->upperBound;
+        info.upperBound = -a->lowerBound;
+        break;
+      case OP_SCALE_BIAS:
+        if (param[0] == 0.0) {
+          info.lowerBound = param[1];
+          info.upperBound = param[1];
+        } else if (param[0] > 0.0) {
+          info.lowerBound = a->lowerBound * param[0] + param[1];
+          info.upperBound = a->upperBound * param[0] + param[1];
+        } else {
+          info.lowerBound = a->upperBound * param[0] + param[1];
+          info.upperBound = a->lowerBound * param[0] + param[1];
+        }
+        break;
+      case OP_CLAMP:
+        info.lowerBound = GetClampedValue (a->lowerBound, param[0], param[1]);
+        info.upperBound = GetClampedValue (a->upperBound, param[0], param[1]);
+        break;
+      case OP_EXPONENT:
+        info.lowerBound = -1.0;
+        if (param[0] > 0.0 && a->lowerBound >= -3.0
+          && a->upperBound <= 1.0) {
+          info.upperBound = 1.0;
+        }
+        break;
+      case OP_SELECT:
+        if (param[2] <= 0.0) {
+          const RegisterInfo* c = &registers[src[2]];
+          info.lowerBound = GetMin (b->lowerBound, c->lowerBound);
+          info.upperBound = GetMax (b->upperBound, c->upperBound);
+        }
+        break;
+      default:
+        break;
+    }
+    if (!(info.lowerBound <= info.upperBound)) {
+      info.lowerBound = -HUGE_VAL;
+      info.upperBound = HUGE_VAL;
+    }
+    output.push_back (instruction);
+  }
+
+  // Remove the instructions whose output values are not used, and number
+  // the registers again.
+  Program& target = m_programs[program];
+  int result = target.result;
+  while (result < (int)registers.size ()
+    && registers[result].alias != result) {
+    result = registers[result].alias;
+  }
+  std::vector<bool> isUsed (target.registerCount, false);
+  isUsed[result] = true;
+  for (size_t k = output.size (); k-- > 0; ) {
+    if (isUsed[output[k].dst]) {
+      for (int i = 0; i < 3; i++) {
+        if (output[k].src[i] >= 0) {
+          isUsed[output[k].src[i]] = true;
+        }
+      }
+    }
+  }
+  std::vector<int> newRegister (target.registerCount, -1);
+  newRegister[X_REGISTER] = X_REGISTER;
+  newRegister[Y_REGISTER] = Y_REGISTER;
+  std::vector<Instruction> instructions;
+  int registerCount = 2;
+  for (size_t k = 0; k < output.size (); k++) {
+    Instruction instruction = output[k];
+    if (!isUsed[instruction.dst]) {
+      ++m_simplificationCount[SIMPLIFY_UNUSED];
+      continue;
+    }
+    instruction.dst = newRegister[instruction.dst] = registerCount++;
+    for (int i = 0; i < 3; i++) {
+      if (instruction.src[i] >= 0) {
+        instruction.src[i] = newRegister[instruction.src[i]];
+      }
+    }
+    instructions.push_back (instruction);
+  }
+  target.instructions.swap (instructions);
+  target.registerCount = registerCount;
+  target.result = newRegister[result];
+}
@@ -0,0 +1,435 @@
+// graphcompiler.h
+//
+// Copyright (C) 2026 libnoise2d contributors
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#ifndef NOISE_MODULE_GRAPHCOMPILER_H
+#define NOISE_MODULE_GRAPHCOMPILER_H
+
+#include <vector>
+#include "modulebase.h"
+
+namespace noise
+{
+
+  namespace module
+  {
+
+    /// @addtogroup libnoise
+    /// @{
+
+    /// @addtogroup modules
+    /// @{
+
+    /// @addtogroup miscmodules
+    /// @{
+
+    /// Noise module that outputs the values of a graph of noise modules
+    /// compiled into a flat program.
+    ///
+    /// Evaluating a graph calls GetValues() of each noise module, which in
+    /// turn calls GetValues() of its source modules.  Compile() instead
+    /// walks the graph once and turns it into a list of instructions that
+    /// operate on registers, each holding one value per input value of a
+    /// block.  GetValues() then runs the instructions block by block,
+    /// without recursion and with one loop per instruction.
+    ///
+    /// The following noise modules are compiled into instructions:
+    /// noise::module::Abs, noise::module::Add, noise::module::Blend,
+    /// noise::module::Cache, noise::module::Clamp, noise::module::Const,
+    /// noise::module::Displace, noise::module::Exponent,
+    /// noise::module::Invert, noise::module::Max, noise::module::Min,
+    /// noise::module::Multiply, noise::module::Power,
+    /// noise::module::RotatePoint, noise::module::ScaleBias,
+    /// noise::module::ScalePoint, noise::module::Select and
+    /// noise::module::TranslatePoint.  Transformer modules become
+    /// instructions on the coordinate registers.  All other noise modules,
+    /// such as the generator modules and classes derived from the noise
+    /// modules above, are called through their GetValues() method, together
+    /// with their source modules.
+    ///
+    /// A noise module that is reached several times with the same input
+    /// values, for example the source module of a noise::module::Cache
+    /// module used by two other modules, is generated only once.  Like
+    /// noise::module::Select::GetValues(), the source modules of a Select
+    /// module are compiled into separate programs that only run for the
+    /// input values that need them.
+    ///
+    /// Compile() then simplifies the instructions.  It folds instructions
+    /// whose operands are constant, turns Add and Multiply modules with a
+    /// constant source module into scale-and-bias instructions, cancels
+    /// pairs of Invert modules, removes Clamp modules whose source module
+    /// stays within the bounds and identity transformer modules, resolves
+    /// Blend and Select modules with a constant control value, and removes
+    /// the instructions whose output values are not used.
+    /// GetSimplificationCount() and GetEliminatedInstructionCount() report
+    /// what has been simplified.
+    ///
+    /// The output values are bit-identical to those of the compiled graph,
+    /// unless EnableReassociation() allows simplifications that round
+    /// differently.  The graph is read at compile time: call Compile() again
+    /// after changing the settings or the source modules of one of its noise
+    /// modules.  The noise modules called through GetValues() are read at
+    /// evaluation time, and GetValue (x, y, footprint) uses the graph
+    /// itself.
+    ///
+    /// This noise module requires one source module, which Compile()
+    /// connects.
+    class GraphCompiler: public Module
+    {
+
+      public:
+
+        /// Enumerates the simplifications that Compile() makes.
+        enum Simplification
+        {
+
+          /// An instruction whose operands are constant is replaced by its
+          /// output value.
+          SIMPLIFY_CONSTANT = 0,
+
+          /// An Add or Multiply module with a constant source module becomes
+          /// a scale-and-bias instruction, or a scale-and-bias instruction
+          /// absorbs the Invert or ScaleBias module that precedes it.
+          SIMPLIFY_AFFINE = 1,
+
+          /// An instruction that outputs its operand is removed, such as an
+          /// Invert module applied twice, a ScaleBias module with a scaling
+          /// factor of 1 and no bias, or a Clamp module whose source module
+          /// stays within its bounds.
+          SIMPLIFY_IDENTITY = 2,
+
+          /// A Blend or Select module with a constant control value no
+          /// longer evaluates its control module, nor the source module it
+          /// does not need.
+          SIMPLIFY_CONTROL = 3,
+
+          /// An instruction whose output values are not used is removed.
+          SIMPLIFY_UNUSED = 4,
+
+          /// Number of kinds of simplifications.
+          SIMPLIFICATION_COUNT = 5
+
+        };
+
+        /// Constructor.
+        GraphCompiler ();
+
+        /// Compiles a graph of noise modules.
+        ///
+        /// @param root The noise module whose output values this noise
+        /// module outputs.
+        ///
+        /// @throw noise::ExceptionNoModule A noise module of the graph
+        /// does not have all required source modules.
+        ///
+        /// The root module becomes the source module of this noise module,
+        /// so it must exist throughout the lifetime of this noise module
+        /// unless another graph replaces it.
+        void Compile (const Module& root);
+
+        /// Enables or disables simplifications that may change the output
+        /// values by rounding differently.
+        ///
+        /// @param enable Specifies whether to enable these simplifications.
+        ///
+        /// These simplifications merge chains of ScaleBias modules into one
+        /// scale-and-bias instruction, remove ScaleBias modules without a
+        /// scaling factor or bias, TranslatePoint modules without a
+        /// translation and RotatePoint modules without a rotation, and
+        /// replace a Blend module whose control value is -1 or 1 by one of
+        /// its source modules.  The output values may then differ in their
+        /// last bits or in the sign of zero, and a source module that is no
+        /// longer evaluated does not pass on infinity or NaN.
+        ///
+        /// This setting is read by Compile().  These simplifications are
+        /// disabled by default.
+        void EnableReassociation (bool enable = true)
+        {
+          m_reassociate = enable;
+        }
+
+        /// Returns the number of instructions that Compile() has eliminated
+        /// by simplifying the compiled graph.
+        ///
+        /// @returns The number of instructions before the simplifications
+        /// minus the number of instructions after them.
+        int GetEliminatedInstructionCount () const
+        {
+          return m_eliminatedInstructionCount;
+        }
+
+        /// Returns the number of instructions of the compiled graph.
+        ///
+        /// @returns The number of instructions, including those of the
+        /// programs of the source modules of Select modules.
+        int GetInstructionCount () const;
+
+        /// Returns the number of registers of the compiled graph.
+        ///
+        /// @returns The number of registers, including the coordinate
+        /// registers and those of the programs of the source modules of
+        /// Select modules.
+        int GetRegisterCount () const;
+
+        /// Returns how many times Compile() has made a kind of
+        /// simplification.
+        ///
+        /// @param simplification The kind of simplification.
+        ///
+        /// @returns The number of simplifications of that kind.
+        int GetSimplificationCount (Simplification simplification) const
+        {
+          assert (simplification >= 0
+            && simplification < SIMPLIFICATION_COUNT);
+
+          return m_simplificationCount[simplification];
+        }
+
+        virtual int GetSourceModuleCount () const
+        {
+          return 1;
+        }
+
+        virtual double GetValue (double x, double y) const;
+
+        virtual double GetValue (double x, double y, double footprint) const;
+
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
+
+        /// Determines whether Compile() makes simplifications that may
+        /// change the output values by rounding differently.
+        ///
+        /// @returns
+        /// - @a true if these simplifications are enabled.
+        /// - @a false if these simplifications are disabled.
+        bool IsReassociationEnabled () const
+        {
+          return m_reassociate;
+        }
+
+      protected:
+
+        /// Operations of the instructions.  @a dst is the register of the
+        /// result, @a src the registers of the operands, and @a param the
+        /// settings of the compiled noise module.
+        enum Opcode
+        {
+          /// dst = param[0].
+          OP_CONST,
+
+          /// dst = src[0] + src[1].
+          OP_ADD,
+
+          /// dst = src[0] * src[1].
+          OP_MULTIPLY,
+
+          /// dst = GetMax (src[0], src[1]).
+          OP_MAX,
+
+          /// dst = GetMin (src[0], src[1]).
+          OP_MIN,
+
+          /// dst = pow (src[0], src[1]).
+          OP_POWER,
+
+          /// dst = fabs (src[0]).
+          OP_ABS,
+
+          /// dst = -src[0].
+          OP_INVERT,
+
+          /// dst = src[0] * param[0] + param[1].
+          OP_SCALE_BIAS,
+
+          /// dst = src[0] clamped to param[0] .. param[1].
+          OP_CLAMP,
+
+          /// dst = pow (fabs ((src[0] + 1.0) / 2.0), param[0]) * 2.0 - 1.0.
+          OP_EXPONENT,
+
+          /// dst = src[0] * param[0], a coordinate of ScalePoint.
+          OP_SCALE,
+
+          /// dst = src[0] + param[0], a coordinate of TranslatePoint.
+          OP_TRANSLATE,
+
+          /// dst = (param[0] * src[0]) + (param[1] * src[1]), a coordinate
+          /// of RotatePoint.
+          OP_ROTATE,
+
+          /// dst = LinearInterp (src[0], src[1], (src[2] + 1.0) / 2.0).
+          OP_BLEND,
+
+          /// dst = LinearInterp (src[0], src[1], param[0]), a Blend or
+          /// Select module with a constant control value.
+          OP_LERP,
+
+          /// dst = output values of @a pModule at the coordinates src[0]
+          /// and src[1].
+          OP_MODULE,
+
+          /// dst = output values of @a program at the coordinates src[1]
+          /// and src[2], for the input values whose control value src[0]
+          /// needs source module param[3] of a Select module with the
+          /// bounds param[0] .. param[1] and the edge falloff param[2].
+          /// The other values of dst are undefined.
+          OP_GATHER,
+
+          /// dst = output value of a Select module with the control value
+          /// src[0], the source values src[1] and src[2] and the settings
+          /// of OP_GATHER.
+          OP_SELECT
+        };
+
+        /// An instruction of a program.
+        struct Instruction
+        {
+          Opcode opcode;
+          int dst;
+          int src[3];
+          double param[4];
+          const Module* pModule;
+          int program;
+        };
+
+        /// A list of instructions that reads the coordinates from the
+        /// registers X_REGISTER and Y_REGISTER and leaves its output values
+        /// in @a result.
+        struct Program
+        {
+          std::vector<Instruction> instructions;
+          int registerCount;
+          int result;
+
+          /// Position of the registers past the coordinate registers among
+          /// those of all programs, see RunProgram().
+          int registerOffset;
+        };
+
+        /// A noise module that has been compiled for the given coordinate
+        /// registers of a program, and the register of its output values.
+        struct CompiledNode
+        {
+          const Module* pModule;
+          int xRegister;
+          int yRegister;
+          int result;
+        };
+
+        /// What Simplify() knows about a register of a program.
+        struct RegisterInfo
+        {
+          /// The register that holds the same values, or this register.
+          int alias;
+
+          /// The index of the instruction that writes the register, or -1.
+          int producer;
+
+          /// Whether the register holds the same value for all input
+          /// values.
+          bool isConstant;
+
+          /// The value of a constant register.
+          double constantValue;
+
+          /// Bounds of the values of the register, not counting NaN.
+          double lowerBound;
+          double upperBound;
+        };
+
+        /// The registers that hold the coordinates of the input values.
+        enum
+        {
+          X_REGISTER = 0,
+          Y_REGISTER = 1
+        };
+
+        /// Appends an instruction to a program and returns the register of
+        /// its result.
+        int AddInstruction (int program, Opcode opcode, int src0 = -1,
+          int src1 = -1, int src2 = -1, double param0 = 0.0,
+          double param1 = 0.0, double param2 = 0.0, double param3 = 0.0);
+
+        /// Compiles a noise module for the given coordinate registers of a
+        /// program and returns the register of its output values.
+        int CompileModule (int program, const Module& module, int xRegister,
+          int yRegister);
+
+        /// Returns the output value of an instruction whose operands hold
+        /// the values @a operand.  This follows the same rules as
+        /// RunProgram().
+        static double EvaluateInstruction (const Instruction& instruction,
+          const double* operand);
+
+        /// Creates an empty program and returns its index.
+        int NewProgram ();
+
+        /// Runs a program for a block of up to
+        /// noise::module::BATCH_BLOCK_SIZE input values.  @a storage holds
+        /// the registers of all programs past their coordinate registers,
+        /// one after the other, each with room for @a stride values.
+        void RunProgram (int program, const double* xs, const double* ys,
+          double* out, size_t count, double* storage, size_t stride) const;
+
+        /// Runs a program for one input value and returns its output value.
+        /// @a storage holds the registers of all programs, including their
+        /// coordinate registers.
+        double RunProgramValue (int program, double x, double y,
+          double* storage) const;
+
+        /// Simplifies the compiled programs and removes those that are no
+        /// longer run.
+        void Simplify ();
+
+        /// Simplifies the instructions of a program, see Simplification.
+        void SimplifyProgram (int program);
+
+        /// The noise modules compiled so far by Compile(), per program.
+        std::vector<std::vector<CompiledNode> > m_compiledNodes;
+
+        /// Number of instructions eliminated by the simplifications.
+        int m_eliminatedInstructionCount;
+
+        /// The programs; the first one is that of the root module.
+        std::vector<Program> m_programs;
+
+        /// Number of registers of all programs past their coordinate
+        /// registers.
+        int m_storageRegisterCount;
+
+        /// Determines whether simplifications that may change the output
+        /// values are enabled.
+        bool m_reassociate;
+
+        /// Number of simplifications of each kind.
+        int m_simplificationCount[SIMPLIFICATION_COUNT];
+
+    };
+
+    /// @}
+
+    /// @}
+
+    /// @}
+
+  }
+
+}
+
+#endif
@@ -36,3 +36,21 @@ double Invert::GetValue (double x, double y) const
 
   return -(m_pSourceModule[0]->GetValue (x, y));
 }
+
+double Invert::GetValue (double x, double y, double footprint) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  return -(m_pSourceModule[0]->GetValue (x, y, footprint));
+}
+
+void Invert::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  m_pSourceModule[0]->GetValues (xs, ys, out, n);
+  for (size_t i = 0; i < n; i++) {
+    out[i] = -out[i];
+  }
+}
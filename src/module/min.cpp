@@ -40,3 +40,31 @@ double Min::GetValue (double x, double y) const
   double v1 = m_pSourceModule[1]->GetValue (x, y);
   return GetMin (v0, v1);
 }
+
+double Min::GetValue (double x, double y, double footprint) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  double v0 = m_pSourceModule[0]->GetValue (x, y, footprint);
+  double v1 = m_pSourceModule[1]->GetValue (x, y, footprint);
+  return GetMin (v0, v1);
+}
+
+void Min::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  double v1[BATCH_BLOCK_SIZE];
+  for (size_t i = 0; i < n; i += BATCH_BLOCK_SIZE) {
+    size_t count = GetMin (n - i, (size_t)BATCH_BLOCK_SIZE);
+    double* v0 = out + i;
+    m_pSourceModule[0]->GetValues (xs + i, ys + i, v0, count);
+    m_pSourceModule[1]->GetValues (xs + i, ys + i, v1, count);
+    for (size_t j = 0; j < count; j++) {
+      v0[j] = GetMin (v0[j], v1[j]);
+    }
+  }
+}
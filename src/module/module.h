@@ -30,14 +30,18 @@
 #include "cache.h"
 #include "checkerboard.h"
 #include "clamp.h"
+#include "codegenerator.h"
+#include "composite.h"
 #include "const.h"
 #include "curve.h"
 #include "cylinders.h"
 #include "displace.h"
 #include "exponent.h"
+#include "graphcompiler.h"
 #include "invert.h"
 #include "max.h"
 #include "min.h"
+#include "multifractal.h"
 #include "multiply.h"
 #include "perlin.h"
 #include "power.h"
@@ -46,10 +50,12 @@
 #include "scalebias.h"
 #include "scalepoint.h"
 #include "select.h"
+#include "simplex.h"
 #include "spheres.h"
 #include "terrace.h"
 #include "translatepoint.h"
 #include "turbulence.h"
+#include "vectorperlin.h"
 #include "voronoi.h"
 
 #endif
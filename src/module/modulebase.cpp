@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include "../misc.h"
 #include "modulebase.h"
 
 using namespace noise::module;
@@ -44,3 +45,34 @@ Module::~Module ()
 {
   delete[] m_pSourceModule;
 }
+
+double Module::GetValue (double x, double y, double footprint) const
+{
+  return GetValue (x, y);
+}
+
+void Module::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  for (size_t i = 0; i < n; i++) {
+    out[i] = GetValue (xs[i], ys[i]);
+  }
+}
+
+void Module::GetValueGrid (double x0, double y0, double dx, double dy,
+  size_t width, size_t height, double* out, size_t stride) const
+{
+  double xs[BATCH_BLOCK_SIZE];
+  double ys[BATCH_BLOCK_SIZE];
+  for (size_t j = 0; j < height; j++) {
+    double y = y0 + (double)j * dy;
+    for (size_t i0 = 0; i0 < width; i0 += BATCH_BLOCK_SIZE) {
+      size_t count = GetMin (width - i0, (size_t)BATCH_BLOCK_SIZE);
+      for (size_t i = 0; i < count; i++) {
+        xs[i] = x0 + (double)(i0 + i) * dx;
+        ys[i] = y;
+      }
+      GetValues (xs, ys, out + j * stride + i0, count);
+    }
+  }
+}
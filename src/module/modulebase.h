@@ -44,6 +44,11 @@ namespace noise
     /// @addtogroup modules
     /// @{
 
+    /// Number of samples a noise module processes at once within
+    /// noise::module::Module::GetValues().  Modules that require intermediate
+    /// buffers keep them on the stack with this size.
+    const int BATCH_BLOCK_SIZE = 256;
+
     /// Abstract base class for noise modules.
     ///
     /// A <i>noise module</i> is an object that calculates and outputs a value
@@ -210,6 +215,20 @@ namespace noise
     /// referenced in the protected @a m_pSourceModule array, mathematically
     /// combine those values, and return the combined value.
     ///
+    /// Optionally, override the GetValues() method to process a buffer of
+    /// input values at once.  Source module values should then be retrieved
+    /// via GetValues() as well, block by block using buffers of
+    /// noise::module::BATCH_BLOCK_SIZE values.
+    ///
+    /// Optionally, override GetValueGrid() if a regular grid of input
+    /// values can be generated faster than a buffer, or if the module
+    /// transforms the grid into another grid for its source module.
+    ///
+    /// Optionally, override GetValue (x, y, footprint) to pass the footprint
+    /// on to the source modules, or to leave out details finer than the
+    /// footprint.  Add a using-declaration for Module::GetValue otherwise, so
+    /// that the overload is not hidden by your GetValue() method.
+    ///
     /// When developing a noise module, you must ensure that your noise module
     /// does not modify any source module or control module connected to it; a
     /// noise module can only modify the output value from those source
@@ -295,6 +314,89 @@ namespace noise
         /// module, call the GetSourceModuleCount() method.
         virtual double GetValue (double x, double y) const = 0;
 
+        /// Generates an output value given the coordinates of the specified
+        /// input value and the footprint of the sample.
+        ///
+        /// @param x The @a x coordinate of the input value.
+        /// @param y The @a y coordinate of the input value.
+        /// @param footprint The distance between adjacent samples, in input
+        /// units.
+        ///
+        /// @returns The output value.
+        ///
+        /// @pre All source modules required by this noise module have been
+        /// passed to the SetSourceModule() method.
+        ///
+        /// Fractal generator modules leave out the octaves whose wavelength
+        /// is shorter than the footprint, because those octaves would only
+        /// alias.  Coarsely sampled regions, such as distant terrain tiles,
+        /// then need fewer octaves.  Transformer modules convert the
+        /// footprint to the input space of their source module.  All other
+        /// modules pass it on unchanged.  A footprint of 0.0 or less
+        /// requests full detail, the same as GetValue (x, y).
+        ///
+        /// The footprint is a parameter of the call and not a module
+        /// setting, so a noise module may be evaluated by several threads
+        /// at different footprints at once.
+        ///
+        /// The default implementation ignores the footprint and calls
+        /// GetValue (x, y).
+        virtual double GetValue (double x, double y, double footprint) const;
+
+        /// Generates output values for a whole buffer of input values.
+        ///
+        /// @param xs The @a x coordinates of the input values.
+        /// @param ys The @a y coordinates of the input values.
+        /// @param out The buffer receiving the output values.
+        /// @param n The number of input values.
+        ///
+        /// @pre All source modules required by this noise module have been
+        /// passed to the SetSourceModule() method.
+        /// @pre @a out does not overlap @a xs or @a ys.
+        ///
+        /// The result is identical to calling GetValue() for each input
+        /// value, but the virtual call is made once per buffer instead of
+        /// once per value.  This allows noise modules to process their
+        /// samples in tight loops that can be vectorised by the compiler.
+        ///
+        /// The default implementation calls GetValue() for each input value.
+        /// Derived modules should override this method if they can do
+        /// better.
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
+
+        /// Generates the output values of a regular grid of input values.
+        ///
+        /// @param x0 The @a x coordinate of the first grid column.
+        /// @param y0 The @a y coordinate of the first grid row.
+        /// @param dx The distance between two grid columns.
+        /// @param dy The distance between two grid rows.
+        /// @param width The number of grid columns.
+        /// @param height The number of grid rows.
+        /// @param out The buffer receiving the output values.
+        /// @param stride The distance between two rows in @a out.
+        ///
+        /// @pre All source modules required by this noise module have been
+        /// passed to the SetSourceModule() method.
+        /// @pre @a stride is at least @a width.
+        ///
+        /// For each row @a j and each column @a i, this method stores
+        /// GetValue (x0 + i * dx, y0 + j * dy) in out[j * stride + i].
+        ///
+        /// A grid is described by six numbers instead of two coordinate
+        /// buffers.  Transformer modules that keep the grid axis-aligned,
+        /// such as noise::module::ScalePoint, pass a transformed grid on to
+        /// their source module, and the fractal generator modules compute
+        /// each lattice point of an octave once for all adjacent samples.
+        /// The output values of a transformed grid may differ from those of
+        /// GetValue() in the last bits, because the grid origin and spacing
+        /// are transformed instead of each input value.
+        ///
+        /// The default implementation calls GetValues() row by row, in
+        /// blocks of noise::module::BATCH_BLOCK_SIZE input values.
+        virtual void GetValueGrid (double x0, double y0, double dx, double dy,
+          size_t width, size_t height, double* out, size_t stride) const;
+
         /// Connects a source module to this noise module.
         ///
         /// @param index An index value to assign to this source module.
@@ -0,0 +1,505 @@
+// multifractal.cpp
+//
+// Copyright (C) 2026 libnoise2d contributors
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "fractal.h"
+#include "multifractal.h"
+
+using namespace noise::module;
+
+namespace noise
+{
+
+  namespace module
+  {
+
+    namespace
+    {
+
+      // The arrays of the fused octave loops are indexed by the channels
+      // of MultiFractal: Perlin, Billow and RidgedMulti.  A channel with an
+      // octave count of 0 is left out.
+      const int FUSED_CHANNELS = 3;
+
+      // Returns the lattice seed of an octave, which decides whether two
+      // modules share the coherent-noise value of that octave.
+      inline int OctaveSeed (const FractalParams& params, int curOctave)
+      {
+        return (params.seed + curOctave) & params.seedMask;
+      }
+
+      // Fused octave loop of a single input value, specialised for a noise
+      // type, a noise quality and a lattice hash like FractalValue().  The
+      // result of each channel is bit-identical to FractalValue().
+      template <NoiseType TYPE, NoiseQuality QUALITY, HashType HASH>
+      void FusedFractalValue (const FractalParams* params,
+        const int* octaveCount, double x, double y, double* value)
+      {
+        PerlinSignal perlin (params[0]);
+        BillowSignal billow (params[1]);
+        RidgedSignal ridged (params[2]);
+        PerlinSignal::State perlinState;
+        BillowSignal::State billowState;
+        RidgedSignal::State ridgedState;
+        perlin.Init (perlinState);
+        billow.Init (billowState);
+        ridged.Init (ridgedState);
+
+        int maxOctaveCount = 0;
+        for (int k = 0; k < FUSED_CHANNELS; k++) {
+          value[k] = 0.0;
+          maxOctaveCount = GetMax (maxOctaveCount, octaveCount[k]);
+        }
+
+        // All fused channels have the same frequency and lacunarity.
+        const FractalParams& lead = (octaveCount[0] > 0)? params[0]:
+          ((octaveCount[1] > 0)? params[1]: params[2]);
+        x *= lead.frequency;
+        y *= lead.frequency;
+
+        for (int curOctave = 0; curOctave < maxOctaveCount; curOctave++) {
+          double nx = MakeInt32Range (x);
+          double ny = MakeInt32Range (y);
+
+          // Generate the coherent-noise value of each lattice seed once.
+          double signal[FUSED_CHANNELS];
+          int seed[FUSED_CHANNELS];
+          for (int k = 0; k < FUSED_CHANNELS; k++) {
+            if (curOctave >= octaveCount[k]) {
+              continue;
+            }
+            seed[k] = OctaveSeed (params[k], curOctave);
+            int shared = 0;
+            while (shared < k && !(curOctave < octaveCount[shared]
+              && seed[shared] == seed[k])) {
+              shared++;
+            }
+            if (shared < k) {
+              signal[k] = signal[shared];
+            } else if (HASH == HASH_PERMUTATION) {
+              signal[k] = Noise2D<TYPE, QUALITY> (nx, ny,
+                PermutationHash (params[k].pPermutationTables[curOctave]));
+            } else {
+              signal[k] = Noise2D<TYPE, QUALITY> (nx, ny,
+                ArithmeticHash (seed[k]));
+            }
+          }
+
+          if (curOctave < octaveCount[0]) {
+            value[0] += perlin.Octave (signal[0], curOctave, perlinState);
+          }
+          if (curOctave < octaveCount[1]) {
+            value[1] += billow.Octave (signal[1], curOctave, billowState);
+          }
+          if (curOctave < octaveCount[2]) {
+            value[2] += ridged.Octave (signal[2], curOctave, ridgedState);
+          }
+
+          // Prepare the next octave.
+          x *= lead.lacunarity;
+          y *= lead.lacunarity;
+        }
+
+        value[0] = perlin.Finish (value[0], params[0].norm);
+        value[1] = billow.Finish (value[1], params[1].norm);
+        value[2] = ridged.Finish (value[2], params[2].norm);
+      }
+
+      typedef void (*FusedKernelPtr) (const FractalParams* params,
+        const int* octaveCount, double x, double y, double* value);
+
+      // Returns the fused octave loop of a single input value, see
+      // GetFractalKernel().
+      FusedKernelPtr GetFusedFractalKernel (NoiseType noiseType,
+        NoiseQuality noiseQuality, HashType hashType)
+      {
+        // Indexed by the noise type, the noise quality and the lattice hash.
+        static const FusedKernelPtr kernels[3][3][2] = {
+          {
+            {&FusedFractalValue<TYPE_GRADIENT, QUALITY_FAST,
+               HASH_ARITHMETIC>,
+             &FusedFractalValue<TYPE_GRADIENT, QUALITY_FAST,
+               HASH_PERMUTATION>},
+            {&FusedFractalValue<TYPE_GRADIENT, QUALITY_STD,
+               HASH_ARITHMETIC>,
+             &FusedFractalValue<TYPE_GRADIENT, QUALITY_STD,
+               HASH_PERMUTATION>},
+            {&FusedFractalValue<TYPE_GRADIENT, QUALITY_BEST,
+               HASH_ARITHMETIC>,
+             &FusedFractalValue<TYPE_GRADIENT, QUALITY_BEST,
+               HASH_PERMUTATION>}
+          },
+          {
+            {&FusedFractalValue<TYPE_VALUE, QUALITY_FAST,
+               HASH_ARITHMETIC>,
+             &FusedFractalValue<TYPE_VALUE, QUALITY_FAST,
+               HASH_PERMUTATION>},
+            {&FusedFractalValue<TYPE_VALUE, QUALITY_STD,
+               HASH_ARITHMETIC>,
+             &FusedFractalValue<TYPE_VALUE, QUALITY_STD,
+               HASH_PERMUTATION>},
+            {&FusedFractalValue<TYPE_VALUE, QUALITY_BEST,
+               HASH_ARITHMETIC>,
+             &FusedFractalValue<TYPE_VALUE, QUALITY_BEST,
+               HASH_PERMUTATION>}
+          },
+          {
+            {&FusedFractalValue<TYPE_OPENSIMPLEX, QUALITY_FAST,
+               HASH_ARITHMETIC>,
+             &FusedFractalValue<TYPE_OPENSIMPLEX, QUALITY_FAST,
+               HASH_PERMUTATION>},
+            {&FusedFractalValue<TYPE_OPENSIMPLEX, QUALITY_STD,
+               HASH_ARITHMETIC>,
+             &FusedFractalValue<TYPE_OPENSIMPLEX, QUALITY_STD,
+               HASH_PERMUTATION>},
+            {&FusedFractalValue<TYPE_OPENSIMPLEX, QUALITY_BEST,
+               HASH_ARITHMETIC>,
+             &FusedFractalValue<TYPE_OPENSIMPLEX, QUALITY_BEST,
+               HASH_PERMUTATION>}
+          }
+        };
+        return kernels[noiseType][noiseQuality][hashType];
+      }
+
+      // Adds the contributions of an octave to a block of output values.
+      template <class Signal>
+      void AddOctave (const Signal& transform, const double* signal,
+        int curOctave, typename Signal::State* state, double* value,
+        size_t count)
+      {
+        for (size_t j = 0; j < count; j++) {
+          value[j] += transform.Octave (signal[j], curOctave, state[j]);
+        }
+      }
+
+      // Fused octave loop of a buffer of input values.  The result of each
+      // channel is bit-identical to FractalValues().
+      void FusedFractalValues (const FractalParams* params,
+        const int* octaveCount, const double* xs, const double* ys,
+        double** out, size_t n)
+      {
+        PerlinSignal perlin (params[0]);
+        BillowSignal billow (params[1]);
+        RidgedSignal ridged (params[2]);
+
+        int maxOctaveCount = 0;
+        for (int k = 0; k < FUSED_CHANNELS; k++) {
+          maxOctaveCount = GetMax (maxOctaveCount, octaveCount[k]);
+        }
+        const FractalParams& lead = (octaveCount[0] > 0)? params[0]:
+          ((octaveCount[1] > 0)? params[1]: params[2]);
+
+        double x[BATCH_BLOCK_SIZE];
+        double y[BATCH_BLOCK_SIZE];
+        double nx[BATCH_BLOCK_SIZE];
+        double ny[BATCH_BLOCK_SIZE];
+        double signal[FUSED_CHANNELS][BATCH_BLOCK_SIZE];
+        PerlinSignal::State perlinState[BATCH_BLOCK_SIZE];
+        BillowSignal::State billowState[BATCH_BLOCK_SIZE];
+        RidgedSignal::State ridgedState[BATCH_BLOCK_SIZE];
+
+        for (size_t i = 0; i < n; i += BATCH_BLOCK_SIZE) {
+          size_t count = GetMin (n - i, (size_t)BATCH_BLOCK_SIZE);
+          for (size_t j = 0; j < count; j++) {
+            x[j] = xs[i + j] * lead.frequency;
+            y[j] = ys[i + j] * lead.frequency;
+            perlin.Init (perlinState[j]);
+            billow.Init (billowState[j]);
+            ridged.Init (ridgedState[j]);
+          }
+          for (int k = 0; k < FUSED_CHANNELS; k++) {
+            if (octaveCount[k] > 0) {
+              for (size_t j = 0; j < count; j++) {
+                out[k][i + j] = 0.0;
+              }
+            }
+          }
+
+          for (int curOctave = 0; curOctave < maxOctaveCount; curOctave++) {
+            for (size_t j = 0; j < count; j++) {
+              nx[j] = MakeInt32Range (x[j]);
+              ny[j] = MakeInt32Range (y[j]);
+            }
+
+            // Generate the coherent-noise values of each lattice seed once.
+            const double* pSignal[FUSED_CHANNELS];
+            int seed[FUSED_CHANNELS];
+            for (int k = 0; k < FUSED_CHANNELS; k++) {
+              if (curOctave >= octaveCount[k]) {
+                continue;
+              }
+              seed[k] = OctaveSeed (params[k], curOctave);
+              int shared = 0;
+              while (shared < k && !(curOctave < octaveCount[shared]
+                && seed[shared] == seed[k])) {
+                shared++;
+              }
+              if (shared < k) {
+                pSignal[k] = pSignal[shared];
+              } else {
+                OctaveNoise2DBatch (params[k], curOctave, nx, ny, signal[k],
+                  count);
+                pSignal[k] = signal[k];
+              }
+            }
+
+            if (curOctave < octaveCount[0]) {
+              AddOctave (perlin, pSignal[0], curOctave, perlinState,
+                out[0] + i, count);
+            }
+            if (curOctave < octaveCount[1]) {
+              AddOctave (billow, pSignal[1], curOctave, billowState,
+                out[1] + i, count);
+            }
+            if (curOctave < octaveCount[2]) {
+              AddOctave (ridged, pSignal[2], curOctave, ridgedState,
+                out[2] + i, count);
+            }
+
+            // Prepare the next octave.
+            for (size_t j = 0; j < count; j++) {
+              x[j] *= lead.lacunarity;
+              y[j] *= lead.lacunarity;
+            }
+          }
+
+          for (size_t j = 0; j < count; j++) {
+            if (octaveCount[0] > 0) {
+              out[0][i + j] = perlin.Finish (out[0][i + j], params[0].norm);
+            }
+            if (octaveCount[1] > 0) {
+              out[1][i + j] = billow.Finish (out[1][i + j], params[1].norm);
+            }
+            if (octaveCount[2] > 0) {
+              out[2][i + j] = ridged.Finish (out[2][i + j], params[2].norm);
+            }
+          }
+        }
+      }
+
+    }
+
+  }
+
+}
+
+MultiFractal::Output::Output (const MultiFractal& owner, int channel):
+  Module (GetSourceModuleCount ()),
+  m_channel (channel),
+  m_pOwner  (&owner)
+{
+}
+
+double MultiFractal::Output::GetValue (double x, double y) const
+{
+  double value;
+  m_pOwner->GetCachedValues (m_channel, &x, &y, &value, 1);
+  return value;
+}
+
+double MultiFractal::Output::GetValue (double x, double y, double footprint)
+  const
+{
+  assert (m_pOwner->m_pModules[m_channel] != NULL);
+
+  return m_pOwner->m_pModules[m_channel]->GetValue (x, y, footprint);
+}
+
+void MultiFractal::Output::GetValues (const double* xs, const double* ys,
+  double* out, size_t n) const
+{
+  for (size_t i = 0; i < n; i += BATCH_BLOCK_SIZE) {
+    size_t count = GetMin (n - i, (size_t)BATCH_BLOCK_SIZE);
+    m_pOwner->GetCachedValues (m_channel, xs + i, ys + i, out + i, count);
+  }
+}
+
+MultiFractal::MultiFractal ():
+  m_billowOutput      (*this, BILLOW_CHANNEL),
+  m_cacheCount        (0),
+  m_perlinOutput      (*this, PERLIN_CHANNEL),
+  m_ridgedMultiOutput (*this, RIDGED_CHANNEL)
+{
+  for (int k = 0; k < CHANNEL_COUNT; k++) {
+    m_pModules[k] = NULL;
+  }
+}
+
+void MultiFractal::GetFusedParams (FractalParams params[CHANNEL_COUNT],
+  int octaveCount[CHANNEL_COUNT]) const
+{
+  const Perlin* pPerlin = static_cast<const Perlin*> (
+    m_pModules[PERLIN_CHANNEL]);
+  const Billow* pBillow = static_cast<const Billow*> (
+    m_pModules[BILLOW_CHANNEL]);
+  const RidgedMulti* pRidgedMulti = static_cast<const RidgedMulti*> (
+    m_pModules[RIDGED_CHANNEL]);
+
+  // Collect the modules whose octave loop can be fused: those without a
+  // lattice period, and without a tolerance that stops the octave loop of
+  // each input value on its own.
+  bool canFuse[CHANNEL_COUNT];
+  if (pPerlin != NULL) {
+    params[PERLIN_CHANNEL] = pPerlin->GetFractalParams ();
+    octaveCount[PERLIN_CHANNEL] = PerlinSignal (params[PERLIN_CHANNEL])
+      .OctaveCount (pPerlin->m_octaveCountTmp, params[PERLIN_CHANNEL].norm,
+      pPerlin->m_tolerance);
+  }
+  if (pBillow != NULL) {
+    params[BILLOW_CHANNEL] = pBillow->GetFractalParams ();
+    octaveCount[BILLOW_CHANNEL] = BillowSignal (params[BILLOW_CHANNEL])
+      .OctaveCount (pBillow->m_octaveCountTmp, params[BILLOW_CHANNEL].norm,
+      pBillow->m_tolerance);
+  }
+  if (pRidgedMulti != NULL) {
+    params[RIDGED_CHANNEL] = pRidgedMulti->GetFractalParams ();
+    octaveCount[RIDGED_CHANNEL] = pRidgedMulti->m_octaveCountTmp;
+  }
+  for (int k = 0; k < CHANNEL_COUNT; k++) {
+    canFuse[k] = m_pModules[k] != NULL && params[k].periodX <= 0
+      && params[k].periodY <= 0;
+  }
+  if (pRidgedMulti != NULL && pRidgedMulti->m_tolerance > 0.0) {
+    canFuse[RIDGED_CHANNEL] = false;
+  }
+
+  // The first module that can be fused leads; the others are fused if
+  // their coherent noise differs from that of the lead at most by the
+  // seeds.
+  int lead = 0;
+  while (lead < CHANNEL_COUNT && !canFuse[lead]) {
+    lead++;
+  }
+  int fusedCount = 0;
+  for (int k = 0; k < CHANNEL_COUNT; k++) {
+    if (canFuse[k] && (k == lead
+      || (params[k].frequency == params[lead].frequency
+      && params[k].lacunarity == params[lead].lacunarity
+      && params[k].noiseType == params[lead].noiseType
+      && params[k].noiseQuality == params[lead].noiseQuality
+      && (params[k].pPermutationTables == NULL)
+        == (params[lead].pPermutationTables == NULL)))) {
+      fusedCount++;
+    } else {
+      canFuse[k] = false;
+    }
+  }
+
+  // A single module is faster on its own, e.g. with its octaves in SIMD
+  // lanes.  The parameters of the channels left out are those of the lead,
+  // so that the fused loops can set up their signal policies.
+  for (int k = 0; k < CHANNEL_COUNT; k++) {
+    if (fusedCount < 2 || !canFuse[k]) {
+      octaveCount[k] = 0;
+      if (lead < CHANNEL_COUNT) {
+        params[k] = params[lead];
+      }
+    }
+  }
+}
+
+void MultiFractal::GenerateValues (const double* xs, const double* ys,
+  double* out[CHANNEL_COUNT], size_t n) const
+{
+  FractalParams params[CHANNEL_COUNT];
+  int octaveCount[CHANNEL_COUNT];
+  GetFusedParams (params, octaveCount);
+
+  // Generate the modules that are not fused on their own.
+  bool isFused = false;
+  for (int k = 0; k < CHANNEL_COUNT; k++) {
+    if (out[k] == NULL) {
+      octaveCount[k] = 0;
+    } else if (octaveCount[k] > 0) {
+      isFused = true;
+    } else if (m_pModules[k] != NULL) {
+      if (n == 1) {
+        out[k][0] = m_pModules[k]->GetValue (xs[0], ys[0]);
+      } else {
+        m_pModules[k]->GetValues (xs, ys, out[k], n);
+      }
+    }
+  }
+  if (!isFused) {
+    return;
+  }
+
+  if (n == 1) {
+    const FractalParams& lead = (octaveCount[0] > 0)? params[0]:
+      ((octaveCount[1] > 0)? params[1]: params[2]);
+    double value[CHANNEL_COUNT];
+    GetFusedFractalKernel (lead.noiseType, lead.noiseQuality,
+      (lead.pPermutationTables != NULL)? noise::HASH_PERMUTATION:
+      noise::HASH_ARITHMETIC) (params, octaveCount, xs[0], ys[0], value);
+    for (int k = 0; k < CHANNEL_COUNT; k++) {
+      if (octaveCount[k] > 0) {
+        out[k][0] = value[k];
+      }
+    }
+  } else {
+    FusedFractalValues (params, octaveCount, xs, ys, out, n);
+  }
+}
+
+void MultiFractal::GetCachedValues (int channel, const double* xs,
+  const double* ys, double* out, size_t n) const
+{
+  assert (m_pModules[channel] != NULL);
+
+  bool isCached = (n == m_cacheCount);
+  for (size_t i = 0; i < n && isCached; i++) {
+    isCached = (xs[i] == m_xCache[i] && ys[i] == m_yCache[i]);
+  }
+  if (!isCached) {
+    double* pValues[CHANNEL_COUNT];
+    for (int k = 0; k < CHANNEL_COUNT; k++) {
+      pValues[k] = m_valueCache[k];
+    }
+    GenerateValues (xs, ys, pValues, n);
+    for (size_t i = 0; i < n; i++) {
+      m_xCache[i] = xs[i];
+      m_yCache[i] = ys[i];
+    }
+    m_cacheCount = n;
+  }
+  for (size_t i = 0; i < n; i++) {
+    out[i] = m_valueCache[channel][i];
+  }
+}
+
+void MultiFractal::GetValue (double x, double y, double& perlinValue,
+  double& billowValue, double& ridgedMultiValue) const
+{
+  double* pValues[CHANNEL_COUNT];
+  pValues[PERLIN_CHANNEL] = &perlinValue;
+  pValues[BILLOW_CHANNEL] = &billowValue;
+  pValues[RIDGED_CHANNEL] = &ridgedMultiValue;
+  perlinValue = billowValue = ridgedMultiValue = 0.0;
+  GenerateValues (&x, &y, pValues, 1);
+}
+
+void MultiFractal::GetValues (const double* xs, const double* ys,
+  double* perlinOut, double* billowOut, double* ridgedMultiOut, size_t n)
+  const
+{
+  double* pValues[CHANNEL_COUNT];
+  pValues[PERLIN_CHANNEL] = perlinOut;
+  pValues[BILLOW_CHANNEL] = billowOut;
+  pValues[RIDGED_CHANNEL] = ridgedMultiOut;
+  GenerateValues (xs, ys, pValues, n);
+}
@@ -0,0 +1,311 @@
+// multifractal.h
+//
+// Copyright (C) 2026 libnoise2d contributors
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#ifndef NOISE_MODULE_MULTIFRACTAL_H
+#define NOISE_MODULE_MULTIFRACTAL_H
+
+#include "billow.h"
+#include "perlin.h"
+#include "ridgedmulti.h"
+
+namespace noise
+{
+
+  namespace module
+  {
+
+    /// @addtogroup libnoise
+    /// @{
+
+    /// @addtogroup modules
+    /// @{
+
+    /// @addtogroup miscmodules
+    /// @{
+
+    /// Generates the output values of a noise::module::Perlin, a
+    /// noise::module::Billow and a noise::module::RidgedMulti noise module
+    /// from one evaluation of their coherent noise.
+    ///
+    /// Terrain graphs often use these modules with the same frequency,
+    /// lacunarity, seed and noise type.  Each octave of the three modules
+    /// then generates the same coherent-noise value; the modules only
+    /// differ in how they turn it into their output value.
+    ///
+    /// An application connects its modules by calling SetPerlin(),
+    /// SetBillow() and SetRidgedMulti(), and uses the output modules
+    /// returned by GetPerlinOutput(), GetBillowOutput() and
+    /// GetRidgedMultiOutput() in their place in the graph.  Any of the
+    /// three modules may be left out.  The output values are bit-identical
+    /// to those of the connected modules.
+    ///
+    /// The coherent-noise value of an octave is shared by all modules with
+    /// the same frequency, lacunarity, noise type, noise quality and
+    /// lattice hash whose seed for that octave is the same.  The octave
+    /// counts may differ.  A module with a lattice period, a RidgedMulti
+    /// module with a tolerance and a module whose parameters do not match
+    /// those of the other modules are generated on their own.
+    ///
+    /// Like noise::module::Cache, this object keeps the output values of
+    /// the last input value passed to GetValue() of an output module, or
+    /// of the last block of up to noise::module::BATCH_BLOCK_SIZE input
+    /// values passed to GetValues().  On a miss, the output values of all
+    /// three modules are generated, so the other output modules find them
+    /// when the graph asks for the same input values.  The cache is
+    /// invalidated when a module is connected; connect it again after
+    /// changing its settings.  The cache makes the output modules unsafe to
+    /// use from several threads at once.
+    class MultiFractal
+    {
+
+      public:
+
+        /// Noise module that outputs the values of one of the modules
+        /// connected to a noise::module::MultiFractal object.
+        ///
+        /// This noise module does not require any source modules.
+        class Output: public Module
+        {
+
+          public:
+
+            /// Constructor.
+            ///
+            /// @param owner The object that generates the output values.
+            /// @param channel The module of @a owner to output.
+            Output (const MultiFractal& owner, int channel);
+
+            virtual int GetSourceModuleCount () const
+            {
+              return 0;
+            }
+
+            virtual double GetValue (double x, double y) const;
+
+            /// Generates an output value, leaving out the octaves whose
+            /// wavelength is shorter than the footprint.
+            ///
+            /// The footprint changes the octave count per input value, so
+            /// this method calls GetValue (x, y, footprint) of the
+            /// connected module without sharing its coherent noise.
+            virtual double GetValue (double x, double y, double footprint)
+              const;
+
+            virtual void GetValues (const double* xs, const double* ys,
+              double* out, size_t n) const;
+
+          protected:
+
+            /// The module of the owner to output.
+            int m_channel;
+
+            /// The object that generates the output values.
+            const MultiFractal* m_pOwner;
+
+        };
+
+        /// Constructor.
+        MultiFractal ();
+
+        /// Returns the output module of the billowy noise.
+        ///
+        /// @returns The noise module that outputs the values of the module
+        /// connected by SetBillow().
+        const Module& GetBillowOutput () const
+        {
+          return m_billowOutput;
+        }
+
+        /// Returns the output module of the Perlin noise.
+        ///
+        /// @returns The noise module that outputs the values of the module
+        /// connected by SetPerlin().
+        const Module& GetPerlinOutput () const
+        {
+          return m_perlinOutput;
+        }
+
+        /// Returns the output module of the ridged-multifractal noise.
+        ///
+        /// @returns The noise module that outputs the values of the module
+        /// connected by SetRidgedMulti().
+        const Module& GetRidgedMultiOutput () const
+        {
+          return m_ridgedMultiOutput;
+        }
+
+        /// Generates the output values of all connected modules for an
+        /// input value.
+        ///
+        /// @param x The @a x coordinate of the input value.
+        /// @param y The @a y coordinate of the input value.
+        /// @param perlinValue Receives the output value of the Perlin
+        /// module.
+        /// @param billowValue Receives the output value of the Billow
+        /// module.
+        /// @param ridgedMultiValue Receives the output value of the
+        /// RidgedMulti module.
+        ///
+        /// The output value of a module that is not connected is 0.0.  This
+        /// method does not use the cache.
+        void GetValue (double x, double y, double& perlinValue,
+          double& billowValue, double& ridgedMultiValue) const;
+
+        /// Generates the output values of all connected modules for a
+        /// buffer of input values.
+        ///
+        /// @param xs The @a x coordinates of the input values.
+        /// @param ys The @a y coordinates of the input values.
+        /// @param perlinOut The buffer receiving the output values of the
+        /// Perlin module, or NULL.
+        /// @param billowOut The buffer receiving the output values of the
+        /// Billow module, or NULL.
+        /// @param ridgedMultiOut The buffer receiving the output values of
+        /// the RidgedMulti module, or NULL.
+        /// @param n The number of input values.
+        ///
+        /// @pre The output buffers do not overlap @a xs or @a ys.
+        ///
+        /// The buffer of a module that is not connected is left unchanged.
+        /// This method does not use the cache.
+        void GetValues (const double* xs, const double* ys,
+          double* perlinOut, double* billowOut, double* ridgedMultiOut,
+          size_t n) const;
+
+        /// Connects the Billow noise module.
+        ///
+        /// @param billow The Billow noise module.
+        ///
+        /// This module must exist throughout the lifetime of this object
+        /// unless another module replaces it.
+        void SetBillow (const Billow& billow)
+        {
+          m_pModules[BILLOW_CHANNEL] = &billow;
+          m_cacheCount = 0;
+        }
+
+        /// Connects the Perlin noise module.
+        ///
+        /// @param perlin The Perlin noise module.
+        ///
+        /// This module must exist throughout the lifetime of this object
+        /// unless another module replaces it.
+        void SetPerlin (const Perlin& perlin)
+        {
+          m_pModules[PERLIN_CHANNEL] = &perlin;
+          m_cacheCount = 0;
+        }
+
+        /// Connects the RidgedMulti noise module.
+        ///
+        /// @param ridgedMulti The RidgedMulti noise module.
+        ///
+        /// This module must exist throughout the lifetime of this object
+        /// unless another module replaces it.
+        void SetRidgedMulti (const RidgedMulti& ridgedMulti)
+        {
+          m_pModules[RIDGED_CHANNEL] = &ridgedMulti;
+          m_cacheCount = 0;
+        }
+
+      protected:
+
+        friend class Output;
+
+        /// The modules whose output values are generated together.
+        enum
+        {
+          PERLIN_CHANNEL = 0,
+          BILLOW_CHANNEL = 1,
+          RIDGED_CHANNEL = 2,
+          CHANNEL_COUNT = 3
+        };
+
+        /// Returns the parameters of the octave loops of the connected
+        /// modules whose coherent noise can be shared.
+        ///
+        /// @a octaveCount receives the number of octaves of each of these
+        /// modules, and 0 for the other modules.  Modules are only shared
+        /// if at least two of them match.
+        void GetFusedParams (FractalParams params[CHANNEL_COUNT],
+          int octaveCount[CHANNEL_COUNT]) const;
+
+        /// Generates the output values of all connected modules for a
+        /// buffer of input values, see GetValues().
+        ///
+        /// The entries of @a out that are NULL and those of modules that
+        /// are not connected are ignored.
+        void GenerateValues (const double* xs, const double* ys,
+          double* out[CHANNEL_COUNT], size_t n) const;
+
+        /// Returns the output values of one module for a block of up to
+        /// noise::module::BATCH_BLOCK_SIZE input values, generating the
+        /// output values of all modules if the block is not cached.
+        void GetCachedValues (int channel, const double* xs,
+          const double* ys, double* out, size_t n) const;
+
+        /// The connected modules, NULL if not connected.  The channels
+        /// index them.
+        const Module* m_pModules[CHANNEL_COUNT];
+
+        /// Output module of the Billow module.
+        Output m_billowOutput;
+
+        /// Number of cached input values.
+        mutable size_t m_cacheCount;
+
+        /// Output module of the Perlin module.
+        Output m_perlinOutput;
+
+        /// Output module of the RidgedMulti module.
+        Output m_ridgedMultiOutput;
+
+        /// The cached output values of the modules.
+        mutable double m_valueCache[CHANNEL_COUNT][BATCH_BLOCK_SIZE];
+
+        /// @a x coordinates of the cached input values.
+        mutable double m_xCache[BATCH_BLOCK_SIZE];
+
+        /// @a y coordinates of the cached input values.
+        mutable double m_yCache[BATCH_BLOCK_SIZE];
+
+      private:
+
+        /// Copy constructor, not implemented.
+        ///
+        /// The output modules point to the object that owns them, so a copy
+        /// would output the values of the original object.
+        MultiFractal (const MultiFractal& multiFractal);
+
+        /// Assignment operator, not implemented.
+        const MultiFractal& operator= (const MultiFractal& multiFractal);
+
+    };
+
+    /// @}
+
+    /// @}
+
+    /// @}
+
+  }
+
+}
+
+#endif
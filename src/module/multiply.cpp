@@ -21,6 +21,7 @@
 // off every 'zig'.)
 //
 
+#include "../misc.h"
 #include "multiply.h"
 
 using namespace noise::module;
@@ -38,3 +39,30 @@ double Multiply::GetValue (double x, double y) const
   return m_pSourceModule[0]->GetValue (x, y)
        * m_pSourceModule[1]->GetValue (x, y);
 }
+
+double Multiply::GetValue (double x, double y, double footprint) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  return m_pSourceModule[0]->GetValue (x, y, footprint)
+       * m_pSourceModule[1]->GetValue (x, y, footprint);
+}
+
+void Multiply::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  double v1[BATCH_BLOCK_SIZE];
+  for (size_t i = 0; i < n; i += BATCH_BLOCK_SIZE) {
+    size_t count = GetMin (n - i, (size_t)BATCH_BLOCK_SIZE);
+    double* v0 = out + i;
+    m_pSourceModule[0]->GetValues (xs + i, ys + i, v0, count);
+    m_pSourceModule[1]->GetValues (xs + i, ys + i, v1, count);
+    for (size_t j = 0; j < count; j++) {
+      v0[j] *= v1[j];
+    }
+  }
+}
@@ -21,6 +21,7 @@
 // off every 'zig'.)
 //
 
+#include "fractal.h"
 #include "perlin.h"
 
 using namespace noise::module;
@@ -28,79 +29,186 @@ using namespace noise::module;
 Perlin::Perlin ():
   Module (GetSourceModuleCount ()),
   m_frequency       (DEFAULT_PERLIN_FREQUENCY   ),
+  m_hashType        (DEFAULT_PERLIN_HASH        ),
   m_lacunarity      (DEFAULT_PERLIN_LACUNARITY  ),
   m_noiseQuality    (DEFAULT_PERLIN_QUALITY     ),
   m_noiseType       (DEFAULT_PERLIN_TYPE        ),
   m_octaveCount     (DEFAULT_PERLIN_OCTAVE_COUNT),
   m_octaveCountTmp  (DEFAULT_PERLIN_OCTAVE_COUNT),
+  m_periodX         (DEFAULT_PERLIN_PERIOD),
+  m_periodY         (DEFAULT_PERLIN_PERIOD),
   m_persistence     (DEFAULT_PERLIN_PERSISTENCE ),
-  m_seed            (DEFAULT_PERLIN_SEED)
+  m_pFractalKernel     (NULL),
+  m_seed            (DEFAULT_PERLIN_SEED),
+  m_tolerance       (DEFAULT_PERLIN_TOLERANCE)
 {
     // m_norm is a normalizing factor to keep the signal in [-1.0,1.0]
     // The maximum signal amplitude can be calculated, since it is a geometric series
     m_norm = 1.0;//(1.0 - m_persistence) / (1.0-pow(m_persistence,m_octaveCount+1));
+    UpdateFractalKernel ();
+}
+
+void Perlin::UpdatePermutationTables ()
+{
+  if (m_hashType != HASH_PERMUTATION) {
+    m_permutationTables.clear ();
+    return;
+  }
+  m_permutationTables.resize (PERLIN_MAX_OCTAVE);
+  for (int curOctave = 0; curOctave < PERLIN_MAX_OCTAVE; curOctave++) {
+    m_permutationTables[curOctave].SetSeed ((m_seed + curOctave) & 0xffffffff);
+  }
+}
+
+FractalParams Perlin::GetFractalParams () const
+{
+  FractalParams params;
+  params.frequency          = m_frequency;
+  params.lacunarity         = m_lacunarity;
+  params.persistence        = m_persistence;
+  params.norm               = m_norm;
+  params.seed               = m_seed;
+  params.seedMask           = 0xffffffff;
+  params.periodX            = m_periodX;
+  params.periodY            = m_periodY;
+  params.noiseType          = m_noiseType;
+  params.noiseQuality       = m_noiseQuality;
+  params.pPermutationTables = m_permutationTables.empty ()? NULL:
+    &m_permutationTables[0];
+  params.pSpectralWeights   = NULL;
+  return params;
+}
+
+void Perlin::UpdateFractalKernel ()
+{
+  m_pFractalKernel = GetFractalKernel<PerlinSignal> (m_noiseType,
+    m_noiseQuality, m_hashType);
 }
 
 double Perlin::GetValue (double x, double y) const
 {
-  double value = 0.0;
-  double signal = 0.0;
-  double curPersistence = 1.0;
-  double nx, ny;
-  int seed;
-
-  x *= m_frequency;
-  y *= m_frequency;
-  
-  switch (m_noiseType)
-  {
-    case noise::TYPE_GRADIENT:
-    {
-        for (int curOctave = 0; curOctave < m_octaveCount; curOctave++)
-        {
-            // Make sure that these floating-point values have the same range as a 32-
-            // bit integer so that we can pass them to the coherent-noise functions.
-            nx = MakeInt32Range (x);
-            ny = MakeInt32Range (y);
-
-            // Get the coherent-noise value from the input value and add it to the
-            // final result.
-            seed = (m_seed + curOctave) & 0xffffffff;
-            signal = GradientCoherentNoise2D (nx, ny, seed, m_noiseQuality);
-            value += signal * curPersistence;
-
-            // Prepare the next octave.
-            x *= m_lacunarity;
-            y *= m_lacunarity;
-            curPersistence *= m_persistence;
-        }
-        break;
+  int skippedOctaves;
+  return m_pFractalKernel (GetFractalParams (), x, y, m_octaveCountTmp,
+    m_tolerance, skippedOctaves);
+}
+
+double Perlin::GetValue (double x, double y, double footprint) const
+{
+  int skippedOctaves;
+  return m_pFractalKernel (GetFractalParams (), x, y, FootprintOctaveCount (
+    m_frequency, m_lacunarity, m_octaveCountTmp, footprint), m_tolerance,
+    skippedOctaves);
+}
+
+double Perlin::GetValueSkipped (double x, double y, int& skippedOctaves) const
+{
+  return m_pFractalKernel (GetFractalParams (), x, y, m_octaveCountTmp,
+    m_tolerance, skippedOctaves);
+}
+
+double Perlin::GetValueDeriv (double x, double y, double& dx, double& dy)
+  const
+{
+  return FractalValueDeriv<PerlinSignal> (GetFractalParams (), x, y,
+    m_octaveCountTmp, dx, dy);
+}
+
+noise::int32 Perlin::GetValueFixed (int32 x, int32 y) const
+{
+  // The frequency of the octaves is kept in 64 bits, so that the scaled
+  // coordinates wrap around like 32-bit integers.
+  uint64 frequency = (uint64)ToFixed (m_frequency);
+  uint64 lacunarity = (uint64)ToFixed (m_lacunarity);
+  int64 persistence = ToFixed (m_persistence);
+  int64 curPersistence = FIXED_ONE;
+  int64 value = 0;
+
+  for (int curOctave = 0; curOctave < m_octaveCountTmp; curOctave++) {
+    int32 nx = ScaleFixed (x, frequency);
+    int32 ny = ScaleFixed (y, frequency);
+
+    // Get the coherent-noise value from the input value and add it to the
+    // final result.
+    int seed = (m_seed + curOctave) & 0xffffffff;
+    int64 signal;
+    if (m_noiseType == noise::TYPE_VALUE) {
+      signal = CoherentNoise2DFixed<ValueLatticeFixed> (nx, ny, seed,
+        m_noiseQuality);
+    } else {
+      signal = CoherentNoise2DFixed<GradientLatticeFixed> (nx, ny, seed,
+        m_noiseQuality);
+    }
+    value += (signal * curPersistence) >> FIXED_SHIFT;
+
+    // Prepare the next octave.
+    frequency = (frequency * lacunarity) >> FIXED_SHIFT;
+    curPersistence = (curPersistence * persistence) >> FIXED_SHIFT;
+  }
+
+  return (int32)((value * ToFixed (m_norm)) >> FIXED_SHIFT);
+}
+
+void Perlin::GetValuesFixed (const int32* xs, const int32* ys, int32* out,
+  size_t n) const
+{
+  int32 nx[BATCH_BLOCK_SIZE];
+  int32 ny[BATCH_BLOCK_SIZE];
+  int32 signal[BATCH_BLOCK_SIZE];
+  int64 value[BATCH_BLOCK_SIZE];
+
+  uint64 lacunarity = (uint64)ToFixed (m_lacunarity);
+  int64 persistence = ToFixed (m_persistence);
+  int64 norm = ToFixed (m_norm);
+
+  for (size_t i = 0; i < n; i += BATCH_BLOCK_SIZE) {
+    size_t count = GetMin (n - i, (size_t)BATCH_BLOCK_SIZE);
+    for (size_t j = 0; j < count; j++) {
+      value[j] = 0;
     }
-    case noise::TYPE_VALUE:
-    {
-        for (int curOctave = 0; curOctave < m_octaveCount; curOctave++)
-        {
-            // Make sure that these floating-point values have the same range as a 32-
-            // bit integer so that we can pass them to the coherent-noise functions.
-            nx = MakeInt32Range (x);
-            ny = MakeInt32Range (y);
-
-            // Get the coherent-noise value from the input value and add it to the
-            // final result.
-            seed = (m_seed + curOctave) & 0xffffffff;
-            signal = ValueCoherentNoise2D (nx, ny, seed, m_noiseQuality);
-            value += signal * curPersistence;
-
-            // Prepare the next octave.
-            x *= m_lacunarity;
-            y *= m_lacunarity;
-            curPersistence *= m_persistence;
-        }
-        break;
+
+    // See GetValues() and GetValueFixed().
+    uint64 frequency = (uint64)ToFixed (m_frequency);
+    int64 curPersistence = FIXED_ONE;
+    for (int curOctave = 0; curOctave < m_octaveCountTmp; curOctave++) {
+      for (size_t j = 0; j < count; j++) {
+        nx[j] = ScaleFixed (xs[i + j], frequency);
+        ny[j] = ScaleFixed (ys[i + j], frequency);
+      }
+
+      int seed = (m_seed + curOctave) & 0xffffffff;
+      if (m_noiseType == noise::TYPE_VALUE) {
+        ValueCoherentNoise2DFixedBatch (nx, ny, signal, count, seed,
+          m_noiseQuality);
+      } else {
+        GradientCoherentNoise2DFixedBatch (nx, ny, signal, count, seed,
+          m_noiseQuality);
+      }
+
+      for (size_t j = 0; j < count; j++) {
+        value[j] += (signal[j] * curPersistence) >> FIXED_SHIFT;
+      }
+
+      // Prepare the next octave.
+      frequency = (frequency * lacunarity) >> FIXED_SHIFT;
+      curPersistence = (curPersistence * persistence) >> FIXED_SHIFT;
+    }
+
+    for (size_t j = 0; j < count; j++) {
+      out[i + j] = (int32)((value[j] * norm) >> FIXED_SHIFT);
     }
   }
+}
 
-  
-  
-  return value*m_norm;
+void Perlin::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  FractalValues<PerlinSignal> (GetFractalParams (), m_pFractalKernel, xs, ys,
+    out, n, m_octaveCountTmp, m_tolerance);
+}
+
+void Perlin::GetValueGrid (double x0, double y0, double dx, double dy,
+  size_t width, size_t height, double* out, size_t stride) const
+{
+  FractalValueGrid<PerlinSignal> (GetFractalParams (), m_pFractalKernel, x0,
+    y0, dx, dy, width, height, out, stride, m_octaveCountTmp, m_tolerance);
 }
@@ -24,6 +24,7 @@
 #ifndef NOISE_MODULE_PERLIN_H
 #define NOISE_MODULE_PERLIN_H
 
+#include <vector>
 #include "modulebase.h"
 
 namespace noise
@@ -50,6 +51,10 @@ namespace noise
     /// Default number of octaves for the noise::module::Perlin noise module.
     const int DEFAULT_PERLIN_OCTAVE_COUNT = 6;
 
+    /// Default lattice period for the noise::module::Perlin noise module,
+    /// 0 for no period.
+    const int DEFAULT_PERLIN_PERIOD = 0;
+
     /// Default persistence value for the noise::module::Perlin noise module.
     const double DEFAULT_PERLIN_PERSISTENCE = 0.5;
 
@@ -59,12 +64,26 @@ namespace noise
     /// Default noise type for the noise::module::Perlin noise module.
     const noise::NoiseType DEFAULT_PERLIN_TYPE = TYPE_GRADIENT;
 
+    /// Default hash type for the noise::module::Perlin noise module.
+    const noise::HashType DEFAULT_PERLIN_HASH = HASH_ARITHMETIC;
+
     /// Default noise seed for the noise::module::Perlin noise module.
     const int DEFAULT_PERLIN_SEED = 0;
 
+    /// Default tolerance for the noise::module::Perlin noise module,
+    /// 0 to generate all
+    /// octaves.
+    const double DEFAULT_PERLIN_TOLERANCE = 0.0;
+
     /// Maximum number of octaves for the noise::module::Perlin noise module.
     const int PERLIN_MAX_OCTAVE = 30;
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    // Parameters of the octave loops shared by the fractal noise modules,
+    // see fractal.h.
+    struct FractalParams;
+#endif
+
     /// Noise module that outputs 3-dimensional Perlin noise.
     ///
     /// @image html moduleperlin.png
@@ -180,6 +199,9 @@ namespace noise
         /// The default persistence value is set to
         /// noise::module::DEFAULT_PERLIN_PERSISTENCE.
         ///
+        /// The default lattice periods are set to
+        /// noise::module::DEFAULT_PERLIN_PERIOD.
+        ///
         /// The default seed value is set to
         /// noise::module::DEFAULT_PERLIN_SEED.
         Perlin ();
@@ -192,6 +214,16 @@ namespace noise
           return m_frequency;
         }
 
+        /// Returns the lattice hash of the Perlin noise.
+        ///
+        /// @returns The lattice hash of the Perlin noise.
+        ///
+        /// See noise::HashType for definitions of the lattice hashes.
+        noise::HashType GetHashType () const
+        {
+          return m_hashType;
+        }
+
         /// Returns the lacunarity of the Perlin noise.
         ///
         /// @returns The lacunarity of the Perlin noise.
@@ -214,6 +246,17 @@ namespace noise
           return m_noiseQuality;
         }
 
+        /// Returns the type of the Perlin noise.
+        ///
+        /// @returns The type of the Perlin noise.
+        ///
+        /// See noise::NoiseType for definitions of the
+        /// coherent-noise types.
+        noise::NoiseType GetNoiseType () const
+        {
+          return m_noiseType;
+        }
+
         /// Returns the number of octaves that generate the Perlin noise.
         ///
         /// @returns The number of octaves that generate the Perlin noise.
@@ -225,6 +268,26 @@ namespace noise
           return m_octaveCount;
         }
 
+        /// Returns the lattice period of the first octave along the @a x
+        /// axis.
+        ///
+        /// @returns The period in lattice cells, or 0 if the Perlin noise
+        /// does not repeat along the @a x axis.
+        int GetPeriodX () const
+        {
+          return m_periodX;
+        }
+
+        /// Returns the lattice period of the first octave along the @a y
+        /// axis.
+        ///
+        /// @returns The period in lattice cells, or 0 if the Perlin noise
+        /// does not repeat along the @a y axis.
+        int GetPeriodY () const
+        {
+          return m_periodY;
+        }
+
         /// Returns the persistence value of the Perlin noise.
         ///
         /// @returns The persistence value of the Perlin noise.
@@ -243,6 +306,15 @@ namespace noise
           return m_seed;
         }
 
+        /// Returns the tolerance of the Perlin noise.
+        ///
+        /// @returns The largest change of the output value that leaving out
+        /// octaves may cause, or 0.0 if all octaves are generated.
+        double GetTolerance () const
+        {
+          return m_tolerance;
+        }
+
         virtual int GetSourceModuleCount () const
         {
           return 0;
@@ -250,6 +322,110 @@ namespace noise
 
         virtual double GetValue (double x, double y) const;
 
+        /// Generates an output value, leaving out the octaves whose
+        /// wavelength is shorter than the footprint.
+        ///
+        /// The wavelength of an octave is the reciprocal of its frequency.
+        /// The first octave is always generated, and at most as many octaves
+        /// as GetValue (x, y) generates.  See Module::GetValue (x, y,
+        /// footprint).
+        virtual double GetValue (double x, double y, double footprint) const;
+
+        /// Generates an output value and counts the octaves left out by the
+        /// tolerance.
+        ///
+        /// @param x The @a x coordinate of the input value.
+        /// @param y The @a y coordinate of the input value.
+        /// @param skippedOctaves Receives the number of octaves left out.
+        ///
+        /// @returns The output value, the same as GetValue (x, y).
+        ///
+        /// See SetTolerance().
+        double GetValueSkipped (double x, double y, int& skippedOctaves)
+          const;
+
+        /// Generates an output value and its partial derivatives.
+        ///
+        /// @param x The @a x coordinate of the input value.
+        /// @param y The @a y coordinate of the input value.
+        /// @param dx Receives the partial derivative with respect to @a x.
+        /// @param dy Receives the partial derivative with respect to @a y.
+        ///
+        /// @returns The output value, bit-identical to GetValue().
+        ///
+        /// The derivatives of the octaves are calculated analytically by
+        /// noise::GradientCoherentNoise2DDeriv() or
+        /// noise::ValueCoherentNoise2DDeriv() and combined by the chain
+        /// rule, so slopes and surface normals need a single evaluation
+        /// instead of three for finite differences.
+        double GetValueDeriv (double x, double y, double& dx, double& dy)
+          const;
+
+        /// Generates an output value from fixed-point coordinates.
+        ///
+        /// @param x The @a x coordinate of the input value, in Q16.16.
+        /// @param y The @a y coordinate of the input value, in Q16.16.
+        ///
+        /// @returns The output value, in Q16.16.
+        ///
+        /// This is an integer-only version of GetValue() for applications
+        /// that need the same output on every platform, compiler and
+        /// optimisation level, e.g. lockstep simulations.  The octaves are
+        /// generated by noise::GradientCoherentNoise2DFixed() or
+        /// noise::ValueCoherentNoise2DFixed(), and the frequency,
+        /// lacunarity, persistence and normalizing factor are rounded to 16
+        /// fractional bits.  The output stays close to GetValue (x /
+        /// 65536.0, y / 65536.0) as long as the scaled coordinates stay
+        /// within the 32-bit range; beyond that, they wrap around instead of
+        /// being folded by noise::MakeInt32Range().
+        ///
+        /// OpenSimplex noise has no fixed-point version, this method
+        /// generates gradient noise instead.  The lattice hash is always
+        /// noise::HASH_ARITHMETIC.
+        int32 GetValueFixed (int32 x, int32 y) const;
+
+        /// Generates the output values of a buffer of fixed-point input
+        /// values.
+        ///
+        /// @param xs The @a x coordinates of the input values, in Q16.16.
+        /// @param ys The @a y coordinates of the input values, in Q16.16.
+        /// @param out The buffer receiving the output values, in Q16.16.
+        /// @param n The number of input values.
+        ///
+        /// This method is equivalent to calling GetValueFixed() for each
+        /// input value, with the octaves generated by
+        /// noise::GradientCoherentNoise2DFixedBatch() or
+        /// noise::ValueCoherentNoise2DFixedBatch().
+        void GetValuesFixed (const int32* xs, const int32* ys, int32* out,
+          size_t n) const;
+
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
+
+        /// Generates the output values of a regular grid of input values.
+        ///
+        /// @param x0 The @a x coordinate of the first grid column.
+        /// @param y0 The @a y coordinate of the first grid row.
+        /// @param dx The distance between two grid columns.
+        /// @param dy The distance between two grid rows.
+        /// @param width The number of grid columns.
+        /// @param height The number of grid rows.
+        /// @param out The buffer receiving the output values.
+        /// @param stride The distance between two rows in @a out.
+        ///
+        /// @pre @a stride is at least @a width.
+        ///
+        /// For each row @a j and each column @a i, this method stores
+        /// GetValue (x0 + i * dx, y0 + j * dy) in out[j * stride + i].  The
+        /// results are bit-identical.
+        ///
+        /// Each octave is generated by noise::GradientCoherentNoise2DGrid()
+        /// or noise::ValueCoherentNoise2DGrid(), which compute each lattice
+        /// point once and reuse it for all samples in the adjacent cells.
+        virtual void GetValueGrid (double x0, double y0, double dx,
+          double dy, size_t width, size_t height, double* out,
+          size_t stride) const;
+
         /// Sets the frequency of the first octave.
         ///
         /// @param frequency The frequency of the first octave.
@@ -258,6 +434,20 @@ namespace noise
           m_frequency = frequency;
         }
 
+        /// Sets the lattice hash of the Perlin noise.
+        ///
+        /// @param hashType The lattice hash of the Perlin noise.
+        ///
+        /// See noise::HashType for definitions of the lattice hashes.  The
+        /// permutation-table hash builds one table per octave, which is
+        /// repeated whenever the seed changes.
+        void SetHashType (noise::HashType hashType)
+        {
+          m_hashType = hashType;
+          UpdatePermutationTables ();
+          UpdateFractalKernel ();
+        }
+
         /// Sets the lacunarity of the Perlin noise.
         ///
         /// @param lacunarity The lacunarity of the Perlin noise.
@@ -281,6 +471,7 @@ namespace noise
         void SetNoiseQuality (noise::NoiseQuality noiseQuality)
         {
           m_noiseQuality = noiseQuality;
+          UpdateFractalKernel ();
         }
         
         /// Sets the type of the Perlin noise.
@@ -292,6 +483,7 @@ namespace noise
         void SetNoiseType (noise::NoiseType noiseType)
         {
           m_noiseType = noiseType;
+          UpdateFractalKernel ();
         }
 
         /// Sets the number of octaves that generate the Perlin noise.
@@ -355,6 +547,30 @@ namespace noise
           m_octaveCountTmp = octaveCount;
         }
 
+        /// Sets the lattice periods of the first octave, so that the
+        /// Perlin noise tiles seamlessly.
+        ///
+        /// @param periodX The period along the @a x axis, in lattice cells.
+        /// @param periodY The period along the @a y axis, in lattice cells.
+        ///
+        /// The lattice coordinates of each octave are wrapped before they
+        /// are hashed.  The periods are scaled by the lacunarity from one
+        /// octave to the next and rounded to the nearest integer, so with
+        /// an integer lacunarity such as the default 2.0 the output repeats
+        /// every @a periodX / @a frequency units along the @a x axis and
+        /// every @a periodY / @a frequency units along the @a y axis.  A
+        /// period of 0 disables the wrap along its axis.
+        ///
+        /// OpenSimplex noise is never periodic.  While a period is set,
+        /// GetValues() and GetValueGrid() evaluate the input values one by
+        /// one instead of using the batch noise functions.
+        /// GetValueFixed() and GetValuesFixed() ignore the periods.
+        void SetPeriod (int periodX, int periodY)
+        {
+          m_periodX = periodX;
+          m_periodY = periodY;
+        }
+
         /// Sets the persistence value of the Perlin noise.
         ///
         /// @param persistence The persistence value of the Perlin noise.
@@ -374,13 +590,59 @@ namespace noise
         void SetSeed (int seed)
         {
           m_seed = seed;
+          UpdatePermutationTables ();
+        }
+
+        /// Sets the tolerance of the Perlin noise.
+        ///
+        /// @param tolerance The largest change of the output value that
+        /// leaving out octaves may cause, or 0.0 to generate all octaves.
+        ///
+        /// With a positive tolerance, the octave loop stops as soon as the
+        /// octaves left cannot change the output value by @a tolerance or
+        /// more, assuming coherent-noise values between -1.0 and +1.0.  The
+        /// amplitudes of the octaves only depend on the persistence, so the
+        /// same octaves are left out for all input values; GetValueSkipped()
+        /// reports how many.  GetValue(), GetValues() and GetValueGrid() honour
+        /// the tolerance; GetValueDeriv() and the fixed-point methods ignore
+        /// it.
+        void SetTolerance (double tolerance)
+        {
+          m_tolerance = tolerance;
         }
 
       protected:
 
+        // MultiFractal shares the octave loop of this module with other
+        // fractal modules.
+        friend class MultiFractal;
+
+        // CodeGenerator writes the octave loop with the settings as
+        // constants.
+        friend class CodeGenerator;
+
+        /// Builds the permutation tables of the octaves if the
+        /// permutation-table hash is used, or frees them otherwise.
+        ///
+        /// This method is called when the seed or the hash type changes.
+        void UpdatePermutationTables ();
+
+        /// Returns the parameters of the octave loops, see fractal.h.
+        FractalParams GetFractalParams () const;
+
+        /// Selects the octave loop of GetValue() for the current noise
+        /// type, noise quality and lattice hash.
+        ///
+        /// This method is called when one of them changes, so that
+        /// GetValue() does not need to branch on them.
+        void UpdateFractalKernel ();
+
         /// Frequency of the first octave.
         double m_frequency;
 
+        /// Lattice hash of the Perlin noise.
+        noise::HashType m_hashType;
+
         /// Frequency multiplier between successive octaves.
         double m_lacunarity;
         
@@ -400,12 +662,30 @@ namespace noise
         /// of Perlin noise. Can be used for subsampling.
         int m_octaveCountTmp;
 
+        /// Lattice period of the first octave along the @a x axis, or 0.
+        int m_periodX;
+
+        /// Lattice period of the first octave along the @a y axis, or 0.
+        int m_periodY;
+
         /// Persistence of the Perlin noise.
         double m_persistence;
 
+        /// Octave loop called by GetValue(), see UpdateFractalKernel().
+        double (*m_pFractalKernel) (const FractalParams& params, double x,
+          double y, int octaveCount, double tolerance, int& skippedOctaves);
+
+        /// Permutation tables of the octaves, or none if the arithmetic
+        /// hash is used.
+        std::vector<noise::PermutationTable> m_permutationTables;
+
         /// Seed value used by the Perlin-noise function.
         int m_seed;
 
+        /// Largest change of the output value that leaving out octaves may
+        /// cause, see SetTolerance().
+        double m_tolerance;
+
     };
 
     /// @}
@@ -21,6 +21,7 @@
 // off every 'zig'.)
 //
 
+#include "fractal.h"
 #include "ridgedmulti.h"
 #include <iostream>
 
@@ -29,15 +30,34 @@ using namespace noise::module;
 RidgedMulti::RidgedMulti ():
   Module (GetSourceModuleCount ()),
   m_frequency           (DEFAULT_RIDGED_FREQUENCY   ),
+  m_hashType            (DEFAULT_RIDGED_HASH        ),
   m_lacunarity          (DEFAULT_RIDGED_LACUNARITY  ),
   m_noiseQuality        (DEFAULT_RIDGED_QUALITY     ),
   m_noiseType           (DEFAULT_RIDGED_TYPE        ),
   m_norm                (1.0),
   m_octaveCount         (DEFAULT_RIDGED_OCTAVE_COUNT),
   m_octaveCountTmp      (DEFAULT_RIDGED_OCTAVE_COUNT),
-  m_seed                (DEFAULT_RIDGED_SEED)
+  m_periodX             (DEFAULT_RIDGED_PERIOD),
+  m_periodY             (DEFAULT_RIDGED_PERIOD),
+  m_pFractalKernel      (NULL),
+  m_seed                (DEFAULT_RIDGED_SEED),
+  m_tolerance           (DEFAULT_RIDGED_TOLERANCE)
 {
   CalcSpectralWeights ();
+  UpdateFractalKernel ();
+}
+
+void RidgedMulti::UpdatePermutationTables ()
+{
+  if (m_hashType != HASH_PERMUTATION) {
+    m_permutationTables.clear ();
+    return;
+  }
+  m_permutationTables.resize (RIDGED_MAX_OCTAVE);
+  for (int curOctave = 0; curOctave < RIDGED_MAX_OCTAVE; curOctave++) {
+    m_permutationTables[curOctave].SetSeed (
+      (m_seed + curOctave) & 0x7fffffff);
+  }
 }
 
 // Calculates the spectral weights for each octave.
@@ -53,115 +73,185 @@ void RidgedMulti::CalcSpectralWeights ()
     m_pSpectralWeights[i] = pow (frequency, -h);
     frequency *= m_lacunarity;
   }
+
+  // The fixed-point weights for h = 1.0, divided by the lacunarity octave
+  // by octave rather than calculated by pow(), so that they are the same on
+  // every platform.
+  uint64 lacunarity = (uint64)ToFixed (m_lacunarity);
+  uint64 weight = FIXED_ONE;
+  for (int i = 0; i < RIDGED_MAX_OCTAVE; i++) {
+    m_pSpectralWeightsFixed[i] = (int64)weight;
+    weight = (lacunarity != 0)? (weight << FIXED_SHIFT) / lacunarity: 0;
+  }
+}
+
+FractalParams RidgedMulti::GetFractalParams () const
+{
+  FractalParams params;
+  params.frequency          = m_frequency;
+  params.lacunarity         = m_lacunarity;
+  params.persistence        = 0.0;
+  params.norm               = m_norm;
+  params.seed               = m_seed;
+  params.seedMask           = 0x7fffffff;
+  params.periodX            = m_periodX;
+  params.periodY            = m_periodY;
+  params.noiseType          = m_noiseType;
+  params.noiseQuality       = m_noiseQuality;
+  params.pPermutationTables = m_permutationTables.empty ()? NULL:
+    &m_permutationTables[0];
+  params.pSpectralWeights   = m_pSpectralWeights;
+  return params;
+}
+
+void RidgedMulti::UpdateFractalKernel ()
+{
+  m_pFractalKernel = GetUnrolledFractalKernel<RidgedSignal> (m_noiseType,
+    m_noiseQuality, m_hashType, m_octaveCountTmp);
 }
 
-// Multifractal code originally written by F. Kenton "Doc Mojo" Musgrave,
-// 1998.  Modified by jas for use with libnoise.
 double RidgedMulti::GetValue (double x, double y) const
 {
-  x *= m_frequency;
-  y *= m_frequency;
+  int skippedOctaves;
+  return m_pFractalKernel (GetFractalParams (), x, y, m_octaveCountTmp,
+    m_tolerance, skippedOctaves);
+}
 
-  double signal = 0.0;
-  double value  = 0.0;
-  double weight = 1.0;
+double RidgedMulti::GetValue (double x, double y, double footprint) const
+{
+  int skippedOctaves;
+  return m_pFractalKernel (GetFractalParams (), x, y, FootprintOctaveCount (
+    m_frequency, m_lacunarity, m_octaveCountTmp, footprint), m_tolerance,
+    skippedOctaves);
+}
 
-  // These parameters should be user-defined; they may be exposed in a
-  // future version of libnoise.
-  double offset = 1.0;
-  double gain = 2.0;
-
-  switch (m_noiseType)
-  {
-    case noise::TYPE_GRADIENT:
-    {
-        for (int curOctave = 0; curOctave < m_octaveCountTmp; curOctave++)
-        {
-            // Make sure that these floating-point values have the same range as a 32-
-            // bit integer so that we can pass them to the coherent-noise functions.
-            double nx, ny;
-            nx = MakeInt32Range (x);
-            ny = MakeInt32Range (y);
-
-            // Get the coherent-noise value.
-            int seed = (m_seed + curOctave) & 0x7fffffff;
-            signal = GradientCoherentNoise2D (nx, ny, seed, m_noiseQuality);
-            
-            // Make the ridges.
-            signal = fabs (signal);
-            signal = offset - signal;
-
-            // Square the signal to increase the sharpness of the ridges.
-            signal *= signal;
-
-            // The weighting from the previous octave is applied to the signal.
-            // Larger values have higher weights, producing sharp points along the
-            // ridges.
-            signal *= weight;
-
-            // Weight successive contributions by the previous signal.
-            weight = signal * gain;
-            if (weight > 1.0) {
-            weight = 1.0;
-            }
-            if (weight < 0.0) {
-            weight = 0.0;
-            }
-
-            // Add the signal to the output value.
-            value += (signal * m_pSpectralWeights[curOctave]);
-
-            // Go to the next octave.
-            x *= m_lacunarity;
-            y *= m_lacunarity;
-        }
-        break;
+double RidgedMulti::GetValueSkipped (double x, double y, int& skippedOctaves)
+  const
+{
+  return m_pFractalKernel (GetFractalParams (), x, y, m_octaveCountTmp,
+    m_tolerance, skippedOctaves);
+}
+
+double RidgedMulti::GetValueDeriv (double x, double y, double& dx, double& dy)
+  const
+{
+  return FractalValueDeriv<RidgedSignal> (GetFractalParams (), x, y,
+    m_octaveCountTmp, dx, dy);
+}
+
+noise::int32 RidgedMulti::GetValueFixed (int32 x, int32 y) const
+{
+  // See Perlin::GetValueFixed().
+  uint64 frequency = (uint64)ToFixed (m_frequency);
+  uint64 lacunarity = (uint64)ToFixed (m_lacunarity);
+  int64 value  = 0;
+  int64 weight = FIXED_ONE;
+
+  // Offset 1.0 and gain 2.0, as in GetValue().
+  const int64 offset = FIXED_ONE;
+  const int64 gain = 2;
+
+  for (int curOctave = 0; curOctave < m_octaveCountTmp; curOctave++) {
+    int32 nx = ScaleFixed (x, frequency);
+    int32 ny = ScaleFixed (y, frequency);
+
+    // Get the coherent-noise value.
+    int seed = (m_seed + curOctave) & 0x7fffffff;
+    int64 signal;
+    if (m_noiseType == noise::TYPE_VALUE) {
+      signal = CoherentNoise2DFixed<ValueLatticeFixed> (nx, ny, seed,
+        m_noiseQuality);
+    } else {
+      signal = CoherentNoise2DFixed<GradientLatticeFixed> (nx, ny, seed,
+        m_noiseQuality);
+    }
+
+    // Make the ridges, square the signal and apply the weighting from the
+    // previous octave, see GetValue().
+    signal = offset - ((signal < 0)? -signal: signal);
+    signal = (signal * signal) >> FIXED_SHIFT;
+    signal = (signal * weight) >> FIXED_SHIFT;
+
+    // Weight successive contributions by the previous signal.
+    weight = GetMin (GetMax (signal * gain, (int64)0), (int64)FIXED_ONE);
+
+    // Add the signal to the output value.
+    value += (signal * m_pSpectralWeightsFixed[curOctave]) >> FIXED_SHIFT;
+
+    // Go to the next octave.
+    frequency = (frequency * lacunarity) >> FIXED_SHIFT;
+  }
+
+  return (int32)(-((value * ToFixed (m_norm)) >> FIXED_SHIFT));
+}
+
+void RidgedMulti::GetValuesFixed (const int32* xs, const int32* ys,
+  int32* out, size_t n) const
+{
+  int32 nx[BATCH_BLOCK_SIZE];
+  int32 ny[BATCH_BLOCK_SIZE];
+  int32 signal[BATCH_BLOCK_SIZE];
+  int64 value[BATCH_BLOCK_SIZE];
+  int64 weight[BATCH_BLOCK_SIZE];
+
+  uint64 lacunarity = (uint64)ToFixed (m_lacunarity);
+  int64 norm = ToFixed (m_norm);
+  const int64 offset = FIXED_ONE;
+  const int64 gain = 2;
+
+  for (size_t i = 0; i < n; i += BATCH_BLOCK_SIZE) {
+    size_t count = GetMin (n - i, (size_t)BATCH_BLOCK_SIZE);
+    for (size_t j = 0; j < count; j++) {
+      value[j] = 0;
+      weight[j] = FIXED_ONE;
     }
-    case noise::TYPE_VALUE:
-    {
-        for (int curOctave = 0; curOctave < m_octaveCountTmp; curOctave++)
-        {
-            // Make sure that these floating-point values have the same range as a 32-
-            // bit integer so that we can pass them to the coherent-noise functions.
-            double nx, ny;
-            nx = MakeInt32Range (x);
-            ny = MakeInt32Range (y);
-
-            // Get the coherent-noise value.
-            int seed = (m_seed + curOctave) & 0x7fffffff;
-            signal = ValueCoherentNoise2D (nx, ny, seed, m_noiseQuality);
-            
-            // Make the ridges.
-            signal = fabs (signal);
-            signal = offset - signal;
-
-            // Square the signal to increase the sharpness of the ridges.
-            signal *= signal;
-
-            // The weighting from the previous octave is applied to the signal.
-            // Larger values have higher weights, producing sharp points along the
-            // ridges.
-            signal *= weight;
-
-            // Weight successive contributions by the previous signal.
-            weight = signal * gain;
-            if (weight > 1.0) {
-            weight = 1.0;
-            }
-            if (weight < 0.0) {
-            weight = 0.0;
-            }
-
-            // Add the signal to the output value.
-            value += (signal * m_pSpectralWeights[curOctave]);
-
-            // Go to the next octave.
-            x *= m_lacunarity;
-            y *= m_lacunarity;
-        }
-        break;
+
+    // See GetValues() and GetValueFixed().
+    uint64 frequency = (uint64)ToFixed (m_frequency);
+    for (int curOctave = 0; curOctave < m_octaveCountTmp; curOctave++) {
+      for (size_t j = 0; j < count; j++) {
+        nx[j] = ScaleFixed (xs[i + j], frequency);
+        ny[j] = ScaleFixed (ys[i + j], frequency);
+      }
+
+      int seed = (m_seed + curOctave) & 0x7fffffff;
+      if (m_noiseType == noise::TYPE_VALUE) {
+        ValueCoherentNoise2DFixedBatch (nx, ny, signal, count, seed,
+          m_noiseQuality);
+      } else {
+        GradientCoherentNoise2DFixedBatch (nx, ny, signal, count, seed,
+          m_noiseQuality);
+      }
+
+      for (size_t j = 0; j < count; j++) {
+        int64 s = signal[j];
+        s = offset - ((s < 0)? -s: s);
+        s = (s * s) >> FIXED_SHIFT;
+        s = (s * weight[j]) >> FIXED_SHIFT;
+        weight[j] = GetMin (GetMax (s * gain, (int64)0), (int64)FIXED_ONE);
+        value[j] += (s * m_pSpectralWeightsFixed[curOctave]) >> FIXED_SHIFT;
+      }
+
+      // Go to the next octave.
+      frequency = (frequency * lacunarity) >> FIXED_SHIFT;
+    }
+
+    for (size_t j = 0; j < count; j++) {
+      out[i + j] = (int32)(-((value[j] * norm) >> FIXED_SHIFT));
     }
   }
-  
-  return (value*m_norm*-1.0);
+}
+
+void RidgedMulti::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  FractalValues<RidgedSignal> (GetFractalParams (), m_pFractalKernel, xs, ys,
+    out, n, m_octaveCountTmp, m_tolerance);
+}
+
+void RidgedMulti::GetValueGrid (double x0, double y0, double dx, double dy,
+  size_t width, size_t height, double* out, size_t stride) const
+{
+  FractalValueGrid<RidgedSignal> (GetFractalParams (), m_pFractalKernel, x0,
+    y0, dx, dy, width, height, out, stride, m_octaveCountTmp, m_tolerance);
 }
@@ -22,6 +22,7 @@
 //
 
 #include "../mathconsts.h"
+#include "../misc.h"
 #include "rotatepoint.h"
 
 using namespace noise::module;
@@ -41,6 +42,15 @@ double RotatePoint::GetValue (double x, double y) const
   return m_pSourceModule[0]->GetValue (nx, ny);
 }
 
+double RotatePoint::GetValue (double x, double y, double footprint) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  double nx = (m_x1Matrix * x) + (m_y1Matrix * y);
+  double ny = (m_x2Matrix * x) + (m_y2Matrix * y);
+  return m_pSourceModule[0]->GetValue (nx, ny, footprint);
+}
+
 void RotatePoint::SetAngles (double xAngle, double yAngle,
   double zAngle)
 {
@@ -66,3 +76,35 @@ void RotatePoint::SetAngles (double xAngle, double yAngle,
   m_yAngle = yAngle;
   m_zAngle = zAngle;
 }
+
+void RotatePoint::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  double nx[BATCH_BLOCK_SIZE];
+  double ny[BATCH_BLOCK_SIZE];
+  for (size_t i = 0; i < n; i += BATCH_BLOCK_SIZE) {
+    size_t count = GetMin (n - i, (size_t)BATCH_BLOCK_SIZE);
+    const double* x = xs + i;
+    const double* y = ys + i;
+    for (size_t j = 0; j < count; j++) {
+      nx[j] = (m_x1Matrix * x[j]) + (m_y1Matrix * y[j]);
+      ny[j] = (m_x2Matrix * x[j]) + (m_y2Matrix * y[j]);
+    }
+    m_pSourceModule[0]->GetValues (nx, ny, out + i, count);
+  }
+}
+
+void RotatePoint::GetValueGrid (double x0, double y0, double dx, double dy,
+  size_t width, size_t height, double* out, size_t stride) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  if (m_y1Matrix != 0.0 || m_x2Matrix != 0.0) {
+    Module::GetValueGrid (x0, y0, dx, dy, width, height, out, stride);
+    return;
+  }
+  m_pSourceModule[0]->GetValueGrid (m_x1Matrix * x0, m_y2Matrix * y0,
+    m_x1Matrix * dx, m_y2Matrix * dy, width, height, out, stride);
+}
@@ -94,6 +94,22 @@ namespace noise
 
         virtual double GetValue (double x, double y) const;
 
+        virtual double GetValue (double x, double y, double footprint) const;
+
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
+
+        /// Generates the output values of a regular grid of input values.
+        ///
+        /// If the rotation matrix maps the axes of the grid exactly onto
+        /// themselves, as with the default angles, the source module
+        /// receives the rotated grid.  Otherwise the rotated input values
+        /// no longer form an axis-aligned grid, and they are generated row
+        /// by row like Module::GetValueGrid().
+        virtual void GetValueGrid (double x0, double y0, double dx,
+          double dy, size_t width, size_t height, double* out,
+          size_t stride) const;
+
         /// Returns the rotation angle around the @a x axis to apply to the
         /// input value.
         ///
@@ -174,6 +190,10 @@ namespace noise
 
       protected:
 
+        // GraphCompiler and CodeGenerator compile the rotation matrix.
+        friend class GraphCompiler;
+        friend class CodeGenerator;
+
         /// An entry within the 3x3 rotation matrix used for rotating the
         /// input value.
         double m_x1Matrix;
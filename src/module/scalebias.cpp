@@ -38,3 +38,21 @@ double ScaleBias::GetValue (double x, double y) const
 
   return m_pSourceModule[0]->GetValue (x, y) * m_scale + m_bias;
 }
+
+double ScaleBias::GetValue (double x, double y, double footprint) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  return m_pSourceModule[0]->GetValue (x, y, footprint) * m_scale + m_bias;
+}
+
+void ScaleBias::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  m_pSourceModule[0]->GetValues (xs, ys, out, n);
+  for (size_t i = 0; i < n; i++) {
+    out[i] = out[i] * m_scale + m_bias;
+  }
+}
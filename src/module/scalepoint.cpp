@@ -21,6 +21,7 @@
 // off every 'zig'.)
 //
 
+#include "../misc.h"
 #include "scalepoint.h"
 
 using namespace noise::module;
@@ -38,3 +39,39 @@ double ScalePoint::GetValue (double x, double y) const
 
   return m_pSourceModule[0]->GetValue (x * m_xScale, y * m_yScale);
 }
+
+double ScalePoint::GetValue (double x, double y, double footprint) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  return m_pSourceModule[0]->GetValue (x * m_xScale, y * m_yScale,
+    footprint * GetMax (fabs (m_xScale), fabs (m_yScale)));
+}
+
+void ScalePoint::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  double nx[BATCH_BLOCK_SIZE];
+  double ny[BATCH_BLOCK_SIZE];
+  for (size_t i = 0; i < n; i += BATCH_BLOCK_SIZE) {
+    size_t count = GetMin (n - i, (size_t)BATCH_BLOCK_SIZE);
+    const double* x = xs + i;
+    const double* y = ys + i;
+    for (size_t j = 0; j < count; j++) {
+      nx[j] = x[j] * m_xScale;
+      ny[j] = y[j] * m_yScale;
+    }
+    m_pSourceModule[0]->GetValues (nx, ny, out + i, count);
+  }
+}
+
+void ScalePoint::GetValueGrid (double x0, double y0, double dx, double dy,
+  size_t width, size_t height, double* out, size_t stride) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  m_pSourceModule[0]->GetValueGrid (x0 * m_xScale, y0 * m_yScale,
+    dx * m_xScale, dy * m_yScale, width, height, out, stride);
+}
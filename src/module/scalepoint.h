@@ -84,6 +84,26 @@ namespace noise
 
         virtual double GetValue (double x, double y) const;
 
+        /// Generates an output value with the footprint scaled like the
+        /// coordinates.
+        ///
+        /// The source module receives the footprint multiplied by the
+        /// larger absolute scaling factor, so that it does not add details
+        /// that alias along either axis.
+        virtual double GetValue (double x, double y, double footprint) const;
+
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
+
+        /// Generates the output values of a regular grid of input values
+        /// from the scaled grid of the source module.
+        ///
+        /// Scaling keeps the grid regular, so the origin and the spacing of
+        /// the grid are scaled and the source module receives a grid.
+        virtual void GetValueGrid (double x0, double y0, double dx,
+          double dy, size_t width, size_t height, double* out,
+          size_t stride) const;
+
         /// Returns the scaling factor applied to the @a x coordinate of the
         /// input value.
         ///
@@ -22,6 +22,7 @@
 //
 
 #include "../interp.h"
+#include "../misc.h"
 #include "select.h"
 
 using namespace noise::module;
@@ -91,6 +92,168 @@ double Select::GetValue (double x, double y) const
   }
 }
 
+double Select::GetValue (double x, double y, double footprint) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+
+  double controlValue = m_pSourceModule[2]->GetValue (x, y, footprint);
+  double alpha;
+  if (m_edgeFalloff > 0.0) {
+    if (controlValue < (m_lowerBound - m_edgeFalloff)) {
+      return m_pSourceModule[0]->GetValue (x, y, footprint);
+
+    } else if (controlValue < (m_lowerBound + m_edgeFalloff)) {
+      double lowerCurve = (m_lowerBound - m_edgeFalloff);
+      double upperCurve = (m_lowerBound + m_edgeFalloff);
+      alpha = SCurve3 (
+        (controlValue - lowerCurve) / (upperCurve - lowerCurve));
+      return LinearInterp (m_pSourceModule[0]->GetValue (x, y, footprint),
+        m_pSourceModule[1]->GetValue (x, y, footprint),
+        alpha);
+
+    } else if (controlValue < (m_upperBound - m_edgeFalloff)) {
+      return m_pSourceModule[1]->GetValue (x, y, footprint);
+
+    } else if (controlValue < (m_upperBound + m_edgeFalloff)) {
+      double lowerCurve = (m_upperBound - m_edgeFalloff);
+      double upperCurve = (m_upperBound + m_edgeFalloff);
+      alpha = SCurve3 (
+        (controlValue - lowerCurve) / (upperCurve - lowerCurve));
+      return LinearInterp (m_pSourceModule[1]->GetValue (x, y, footprint),
+        m_pSourceModule[0]->GetValue (x, y, footprint),
+        alpha);
+
+    } else {
+      return m_pSourceModule[0]->GetValue (x, y, footprint);
+    }
+  } else {
+    if (controlValue < m_lowerBound || controlValue > m_upperBound) {
+      return m_pSourceModule[0]->GetValue (x, y, footprint);
+    } else {
+      return m_pSourceModule[1]->GetValue (x, y, footprint);
+    }
+  }
+}
+
+void Select::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+
+  // How the output value is combined from the source modules.
+  enum SelectMode
+  {
+    SELECT_SOURCE_0,
+    SELECT_SOURCE_1,
+    BLEND_SOURCE_0_1,
+    BLEND_SOURCE_1_0
+  };
+
+  SelectMode mode[BATCH_BLOCK_SIZE];
+  double alpha[BATCH_BLOCK_SIZE];
+  double v1[BATCH_BLOCK_SIZE];
+  double xGather[BATCH_BLOCK_SIZE];
+  double yGather[BATCH_BLOCK_SIZE];
+  double vGather[BATCH_BLOCK_SIZE];
+  size_t index[BATCH_BLOCK_SIZE];
+
+  for (size_t i = 0; i < n; i += BATCH_BLOCK_SIZE) {
+    size_t count = GetMin (n - i, (size_t)BATCH_BLOCK_SIZE);
+    const double* x = xs + i;
+    const double* y = ys + i;
+    double* v0 = out + i;
+
+    // Decide for each input value which source modules contribute to the
+    // output value.  This follows the same rules as GetValue().
+    m_pSourceModule[2]->GetValues (x, y, alpha, count);
+    for (size_t j = 0; j < count; j++) {
+      double controlValue = alpha[j];
+      if (m_edgeFalloff > 0.0) {
+        if (controlValue < (m_lowerBound - m_edgeFalloff)) {
+          mode[j] = SELECT_SOURCE_0;
+        } else if (controlValue < (m_lowerBound + m_edgeFalloff)) {
+          double lowerCurve = (m_lowerBound - m_edgeFalloff);
+          double upperCurve = (m_lowerBound + m_edgeFalloff);
+          alpha[j] = SCurve3 (
+            (controlValue - lowerCurve) / (upperCurve - lowerCurve));
+          mode[j] = BLEND_SOURCE_0_1;
+        } else if (controlValue < (m_upperBound - m_edgeFalloff)) {
+          mode[j] = SELECT_SOURCE_1;
+        } else if (controlValue < (m_upperBound + m_edgeFalloff)) {
+          double lowerCurve = (m_upperBound - m_edgeFalloff);
+          double upperCurve = (m_upperBound + m_edgeFalloff);
+          alpha[j] = SCurve3 (
+            (controlValue - lowerCurve) / (upperCurve - lowerCurve));
+          mode[j] = BLEND_SOURCE_1_0;
+        } else {
+          mode[j] = SELECT_SOURCE_0;
+        }
+      } else {
+        if (controlValue < m_lowerBound || controlValue > m_upperBound) {
+          mode[j] = SELECT_SOURCE_0;
+        } else {
+          mode[j] = SELECT_SOURCE_1;
+        }
+      }
+    }
+
+    // Only retrieve the output values of the source modules that are
+    // actually needed.  Gather the corresponding input values, evaluate
+    // them at once and scatter the results back.
+    size_t gatherCount = 0;
+    for (size_t j = 0; j < count; j++) {
+      if (mode[j] != SELECT_SOURCE_1) {
+        index  [gatherCount] = j;
+        xGather[gatherCount] = x[j];
+        yGather[gatherCount] = y[j];
+        ++gatherCount;
+      }
+    }
+    if (gatherCount > 0) {
+      m_pSourceModule[0]->GetValues (xGather, yGather, vGather, gatherCount);
+      for (size_t k = 0; k < gatherCount; k++) {
+        v0[index[k]] = vGather[k];
+      }
+    }
+
+    gatherCount = 0;
+    for (size_t j = 0; j < count; j++) {
+      if (mode[j] != SELECT_SOURCE_0) {
+        index  [gatherCount] = j;
+        xGather[gatherCount] = x[j];
+        yGather[gatherCount] = y[j];
+        ++gatherCount;
+      }
+    }
+    if (gatherCount > 0) {
+      m_pSourceModule[1]->GetValues (xGather, yGather, vGather, gatherCount);
+      for (size_t k = 0; k < gatherCount; k++) {
+        v1[index[k]] = vGather[k];
+      }
+    }
+
+    for (size_t j = 0; j < count; j++) {
+      switch (mode[j]) {
+        case SELECT_SOURCE_0:
+          break;
+        case SELECT_SOURCE_1:
+          v0[j] = v1[j];
+          break;
+        case BLEND_SOURCE_0_1:
+          v0[j] = LinearInterp (v0[j], v1[j], alpha[j]);
+          break;
+        case BLEND_SOURCE_1_0:
+          v0[j] = LinearInterp (v1[j], v0[j], alpha[j]);
+          break;
+      }
+    }
+  }
+}
+
 void Select::SetBounds (double lowerBound, double upperBound)
 {
   assert (lowerBound < upperBound);
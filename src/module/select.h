@@ -171,6 +171,11 @@ namespace noise
 
         virtual double GetValue (double x, double y) const;
 
+        virtual double GetValue (double x, double y, double footprint) const;
+
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
+
         /// Sets the lower and upper bounds of the selection range.
         ///
         /// @param lowerBound The lower bound.
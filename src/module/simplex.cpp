@@ -0,0 +1,117 @@
+// simplex.cpp
+//
+// Copyright (C) 2026 libnoise2d contributors
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "../misc.h"
+#include "../noisegenscalar.h"
+#include "simplex.h"
+
+using namespace noise::module;
+
+Simplex::Simplex ():
+  Module (GetSourceModuleCount ()),
+  m_frequency       (DEFAULT_SIMPLEX_FREQUENCY   ),
+  m_lacunarity      (DEFAULT_SIMPLEX_LACUNARITY  ),
+  m_octaveCount     (DEFAULT_SIMPLEX_OCTAVE_COUNT),
+  m_octaveCountTmp  (DEFAULT_SIMPLEX_OCTAVE_COUNT),
+  m_persistence     (DEFAULT_SIMPLEX_PERSISTENCE ),
+  m_seed            (DEFAULT_SIMPLEX_SEED)
+{
+}
+
+double Simplex::FractalKernel (double x, double y, int octaveCount) const
+{
+  double value = 0.0;
+  double curPersistence = 1.0;
+  double nx, ny;
+  int seed;
+
+  x *= m_frequency;
+  y *= m_frequency;
+
+  for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+
+    // Make sure that these floating-point values have the same range as a 32-
+    // bit integer so that we can pass them to the noise functions.
+    nx = MakeInt32Range (x);
+    ny = MakeInt32Range (y);
+
+    // Get the simplex-noise value from the input value and add it to the
+    // final result.
+    seed = (m_seed + curOctave) & 0xffffffff;
+    value += SimplexNoise2D (nx, ny, seed) * curPersistence;
+
+    // Prepare the next octave.
+    x *= m_lacunarity;
+    y *= m_lacunarity;
+    curPersistence *= m_persistence;
+  }
+
+  return value;
+}
+
+double Simplex::GetValue (double x, double y) const
+{
+  return FractalKernel (x, y, m_octaveCountTmp);
+}
+
+double Simplex::GetValue (double x, double y, double footprint) const
+{
+  return FractalKernel (x, y, FootprintOctaveCount (m_frequency,
+    m_lacunarity, m_octaveCountTmp, footprint));
+}
+
+void Simplex::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  double x[BATCH_BLOCK_SIZE];
+  double y[BATCH_BLOCK_SIZE];
+  double nx[BATCH_BLOCK_SIZE];
+  double ny[BATCH_BLOCK_SIZE];
+  double signal[BATCH_BLOCK_SIZE];
+
+  for (size_t i = 0; i < n; i += BATCH_BLOCK_SIZE) {
+    size_t count = GetMin (n - i, (size_t)BATCH_BLOCK_SIZE);
+    double* value = out + i;
+    for (size_t j = 0; j < count; j++) {
+      x[j] = xs[i + j] * m_frequency;
+      y[j] = ys[i + j] * m_frequency;
+      value[j] = 0.0;
+    }
+
+    double curPersistence = 1.0;
+    for (int curOctave = 0; curOctave < m_octaveCountTmp; curOctave++) {
+      for (size_t j = 0; j < count; j++) {
+        nx[j] = MakeInt32Range (x[j]);
+        ny[j] = MakeInt32Range (y[j]);
+      }
+
+      int seed = (m_seed + curOctave) & 0xffffffff;
+      SimplexNoise2DBatch (nx, ny, signal, count, seed);
+
+      for (size_t j = 0; j < count; j++) {
+        value[j] += signal[j] * curPersistence;
+
+        // Prepare the next octave.
+        x[j] *= m_lacunarity;
+        y[j] *= m_lacunarity;
+      }
+      curPersistence *= m_persistence;
+    }
+  }
+}
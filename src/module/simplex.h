@@ -0,0 +1,278 @@
+// simplex.h
+//
+// Copyright (C) 2026 libnoise2d contributors
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#ifndef NOISE_MODULE_SIMPLEX_H
+#define NOISE_MODULE_SIMPLEX_H
+
+#include "modulebase.h"
+
+namespace noise
+{
+
+  namespace module
+  {
+
+    /// @addtogroup libnoise
+    /// @{
+
+    /// @addtogroup modules
+    /// @{
+
+    /// @addtogroup generatormodules
+    /// @{
+
+    /// Default frequency for the noise::module::Simplex noise module.
+    const double DEFAULT_SIMPLEX_FREQUENCY = 1.0;
+
+    /// Default lacunarity for the noise::module::Simplex noise module.
+    const double DEFAULT_SIMPLEX_LACUNARITY = 2.0;
+
+    /// Default number of octaves for the noise::module::Simplex noise module.
+    const int DEFAULT_SIMPLEX_OCTAVE_COUNT = 6;
+
+    /// Default persistence value for the noise::module::Simplex noise
+    /// module.
+    const double DEFAULT_SIMPLEX_PERSISTENCE = 0.5;
+
+    /// Default noise seed for the noise::module::Simplex noise module.
+    const int DEFAULT_SIMPLEX_SEED = 0;
+
+    /// Maximum number of octaves for the noise::module::Simplex noise module.
+    const int SIMPLEX_MAX_OCTAVE = 30;
+
+    /// Noise module that outputs 2-dimensional fractal simplex noise.
+    ///
+    /// This noise module sums octaves of simplex noise in the same way as
+    /// noise::module::Perlin sums octaves of gradient-coherent noise, and
+    /// has the same frequency, lacunarity, persistence and octave
+    /// parameters.  It can replace a noise::module::Perlin module in an
+    /// existing graph.
+    ///
+    /// Each octave is generated by noise::SimplexNoise2D(), which only
+    /// evaluates the three corners of a triangle instead of the four
+    /// corners of a square and needs no S-curve.  The noise also shows
+    /// fewer axis-aligned artifacts than gradient-coherent noise.
+    ///
+    /// This noise module outputs values that usually range from -1.0 to
+    /// +1.0, but there are no guarantees that all output values will exist
+    /// within that range.
+    ///
+    /// This noise module does not require any source modules.
+    class Simplex: public Module
+    {
+
+      public:
+
+        /// Constructor.
+        ///
+        /// The default frequency is set to
+        /// noise::module::DEFAULT_SIMPLEX_FREQUENCY.
+        ///
+        /// The default lacunarity is set to
+        /// noise::module::DEFAULT_SIMPLEX_LACUNARITY.
+        ///
+        /// The default number of octaves is set to
+        /// noise::module::DEFAULT_SIMPLEX_OCTAVE_COUNT.
+        ///
+        /// The default persistence value is set to
+        /// noise::module::DEFAULT_SIMPLEX_PERSISTENCE.
+        ///
+        /// The default seed value is set to
+        /// noise::module::DEFAULT_SIMPLEX_SEED.
+        Simplex ();
+
+        /// Returns the frequency of the first octave.
+        ///
+        /// @returns The frequency of the first octave.
+        double GetFrequency () const
+        {
+          return m_frequency;
+        }
+
+        /// Returns the lacunarity of the simplex noise.
+        ///
+        /// @returns The lacunarity of the simplex noise.
+        ///
+        /// The lacunarity is the frequency multiplier between successive
+        /// octaves.
+        double GetLacunarity () const
+        {
+          return m_lacunarity;
+        }
+
+        /// Returns the number of octaves that generate the simplex noise.
+        ///
+        /// @returns The number of octaves that generate the simplex noise.
+        int GetOctaveCount () const
+        {
+          return m_octaveCount;
+        }
+
+        /// Returns the persistence value of the simplex noise.
+        ///
+        /// @returns The persistence value of the simplex noise.
+        double GetPersistence () const
+        {
+          return m_persistence;
+        }
+
+        /// Returns the seed value used by the simplex-noise function.
+        ///
+        /// @returns The seed value.
+        int GetSeed () const
+        {
+          return m_seed;
+        }
+
+        virtual int GetSourceModuleCount () const
+        {
+          return 0;
+        }
+
+        virtual double GetValue (double x, double y) const;
+
+        /// Generates an output value, leaving out the octaves whose
+        /// wavelength is shorter than the footprint.
+        ///
+        /// The wavelength of an octave is the reciprocal of its frequency.
+        /// The first octave is always generated, and at most as many octaves
+        /// as GetValue (x, y) generates.  See Module::GetValue (x, y,
+        /// footprint).
+        virtual double GetValue (double x, double y, double footprint) const;
+
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
+
+        /// Sets the frequency of the first octave.
+        ///
+        /// @param frequency The frequency of the first octave.
+        void SetFrequency (double frequency)
+        {
+          m_frequency = frequency;
+        }
+
+        /// Sets the lacunarity of the simplex noise.
+        ///
+        /// @param lacunarity The lacunarity of the simplex noise.
+        ///
+        /// For best results, set the lacunarity to a number between 1.5 and
+        /// 3.5.
+        void SetLacunarity (double lacunarity)
+        {
+          m_lacunarity = lacunarity;
+        }
+
+        /// Sets the number of octaves that generate the simplex noise.
+        ///
+        /// @param octaveCount The number of octaves that generate the
+        /// simplex noise.
+        ///
+        /// @pre The number of octaves ranges from 1 to
+        /// noise::module::SIMPLEX_MAX_OCTAVE.
+        ///
+        /// @throw noise::ExceptionInvalidParam An invalid parameter was
+        /// specified; see the preconditions for more information.
+        void SetOctaveCount (int octaveCount)
+        {
+          if (octaveCount < 1 || octaveCount > SIMPLEX_MAX_OCTAVE) {
+            throw noise::ExceptionInvalidParam ();
+          }
+          m_octaveCount = octaveCount;
+          m_octaveCountTmp = octaveCount;
+        }
+
+        /// Sets the number of octaves that generate the simplex noise,
+        /// but only temporary.  The maximum number of octaves is given by
+        /// SetOctaveCount.
+        ///
+        /// @param octaveCount The number of octaves that generate the
+        /// subsampled simplex noise.
+        ///
+        /// @pre The number of octaves ranges from 1 to
+        /// noise::module::SIMPLEX_MAX_OCTAVE.
+        ///
+        /// @throw noise::ExceptionInvalidParam An invalid parameter was
+        /// specified; see the preconditions for more information.
+        void SetOctaveCountTmp (int octaveCount)
+        {
+          if (octaveCount < 1 || octaveCount > SIMPLEX_MAX_OCTAVE) {
+            throw noise::ExceptionInvalidParam ();
+          }
+          m_octaveCountTmp = octaveCount;
+        }
+
+        /// Sets the persistence value of the simplex noise.
+        ///
+        /// @param persistence The persistence value of the simplex noise.
+        ///
+        /// For best results, set the persistence to a number between 0.0 and
+        /// 1.0.
+        void SetPersistence (double persistence)
+        {
+          m_persistence = persistence;
+        }
+
+        /// Sets the seed value used by the simplex-noise function.
+        ///
+        /// @param seed The seed value.
+        void SetSeed (int seed)
+        {
+          m_seed = seed;
+        }
+
+      protected:
+
+        // CodeGenerator writes the octave loop with the settings as
+        // constants.
+        friend class CodeGenerator;
+
+        /// Octave loop of GetValue(), over the first @a octaveCount octaves.
+        double FractalKernel (double x, double y, int octaveCount) const;
+
+        /// Frequency of the first octave.
+        double m_frequency;
+
+        /// Frequency multiplier between successive octaves.
+        double m_lacunarity;
+
+        /// Total number of octaves that generate the simplex noise.
+        int m_octaveCount;
+
+        /// Number of octaves used for temporary subsampling.
+        int m_octaveCountTmp;
+
+        /// Persistence of the simplex noise.
+        double m_persistence;
+
+        /// Seed value used by the simplex-noise function.
+        int m_seed;
+
+    };
+
+    /// @}
+
+    /// @}
+
+    /// @}
+
+  }
+
+}
+
+#endif
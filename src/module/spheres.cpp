@@ -31,15 +31,22 @@ Spheres::Spheres ():
 {
 }
 
-double Spheres::GetValue (double x, double y, double z) const
+double Spheres::GetValue (double x, double y) const
 {
   x *= m_frequency;
   y *= m_frequency;
-  z *= m_frequency;
 
-  double distFromCenter = sqrt (x * x + y * y + z * z);
+  double distFromCenter = sqrt (x * x + y * y);
   double distFromSmallerSphere = distFromCenter - floor (distFromCenter);
   double distFromLargerSphere = 1.0 - distFromSmallerSphere;
   double nearestDist = GetMin (distFromSmallerSphere, distFromLargerSphere);
   return 1.0 - (nearestDist * 4.0); // Puts it in the -1.0 to +1.0 range.
 }
+
+void Spheres::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  for (size_t i = 0; i < n; i++) {
+    out[i] = Spheres::GetValue (xs[i], ys[i]);
+  }
+}
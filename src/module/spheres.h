@@ -94,7 +94,12 @@ namespace noise
           return 0;
         }
 
-        virtual double GetValue (double x, double y, double z) const;
+        using Module::GetValue;
+
+        virtual double GetValue (double x, double y) const;
+
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
 
         /// Sets the frequenct of the concentric spheres.
         ///
@@ -80,9 +80,21 @@ double Terrace::GetValue (double x, double y) const
   assert (m_pSourceModule[0] != NULL);
   assert (m_controlPointCount >= 2);
 
-  // Get the output value from the source module.
-  double sourceModuleValue = m_pSourceModule[0]->GetValue (x, y);
+  // Get the output value from the source module and map it onto the
+  // terrace-forming curve.
+  return GetTerraceValue (m_pSourceModule[0]->GetValue (x, y));
+}
+
+double Terrace::GetValue (double x, double y, double footprint) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_controlPointCount >= 2);
+
+  return GetTerraceValue (m_pSourceModule[0]->GetValue (x, y, footprint));
+}
 
+double Terrace::GetTerraceValue (double sourceModuleValue) const
+{
   // Find the first element in the control point array that has a value
   // larger than the output value from the source module.
   int indexPos;
@@ -121,6 +133,18 @@ double Terrace::GetValue (double x, double y) const
   return LinearInterp (value0, value1, alpha);
 }
 
+void Terrace::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_controlPointCount >= 2);
+
+  m_pSourceModule[0]->GetValues (xs, ys, out, n);
+  for (size_t i = 0; i < n; i++) {
+    out[i] = GetTerraceValue (out[i]);
+  }
+}
+
 void Terrace::InsertAtPos (int insertionPos, double value)
 {
   // Make room for the new control point at the specified position within
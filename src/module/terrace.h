@@ -162,6 +162,11 @@ namespace noise
 
     	  virtual double GetValue (double x, double y) const;
 
+    	  virtual double GetValue (double x, double y, double footprint) const;
+
+    	  virtual void GetValues (const double* xs, const double* ys,
+    	    double* out, size_t n) const;
+
 	      /// Creates a number of equally-spaced control points that range from
         /// -1 to +1.
 	      ///
@@ -183,6 +188,14 @@ namespace noise
 
     	protected:
 
+	      /// Maps an output value from the source module onto the
+	      /// terrace-forming curve.
+	      ///
+	      /// @param sourceModuleValue The output value from the source module.
+	      ///
+	      /// @returns The mapped value.
+	      double GetTerraceValue (double sourceModuleValue) const;
+
 	      /// Determines the array index in which to insert the control point
 	      /// into the internal control point array.
 	      ///
@@ -84,6 +84,20 @@ namespace noise
 
         virtual double GetValue (double x, double y) const;
 
+        virtual double GetValue (double x, double y, double footprint) const;
+
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
+
+        /// Generates the output values of a regular grid of input values
+        /// from the translated grid of the source module.
+        ///
+        /// Translating keeps the grid regular, so the origin of the grid
+        /// is translated and the source module receives a grid.
+        virtual void GetValueGrid (double x0, double y0, double dx,
+          double dy, size_t width, size_t height, double* out,
+          size_t stride) const;
+
         /// Returns the translation amount to apply to the @a x coordinate of
         /// the input value.
         ///
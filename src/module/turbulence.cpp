@@ -21,66 +21,118 @@
 // off every 'zig'.)
 //
 
+#include "../misc.h"
+#include "../noisegenscalar.h"
 #include "turbulence.h"
 
 using namespace noise::module;
 
 Turbulence::Turbulence ():
   Module (GetSourceModuleCount ()),
-  m_power (DEFAULT_TURBULENCE_POWER)
+  m_power (DEFAULT_TURBULENCE_POWER),
+  m_tolerance (DEFAULT_TURBULENCE_TOLERANCE)
 {
   SetSeed (DEFAULT_TURBULENCE_SEED);
   SetFrequency (DEFAULT_TURBULENCE_FREQUENCY);
   SetRoughness (DEFAULT_TURBULENCE_ROUGHNESS);
 }
 
+int Turbulence::GetEffectiveRoughness (double footprint) const
+{
+  int octaveCount = FootprintOctaveCount (m_distortModule.GetFrequency (),
+    m_distortModule.GetLacunarity (), m_distortModule.GetOctaveCount (),
+    footprint);
+
+  // The octaves of the displacement are those of the Perlin noise scaled
+  // by the power.
+  return ToleranceOctaveCount (m_distortModule.GetPersistence (),
+    m_distortModule.GetNorm () * m_power, octaveCount,
+    GetMax (m_tolerance, footprint));
+}
+
 double Turbulence::GetFrequency () const
 {
-  // Since each noise::module::Perlin noise module has the same frequency, it
-  // does not matter which module we use to retrieve the frequency.
-  return m_xDistortModule.GetFrequency ();
+  return m_distortModule.GetFrequency ();
 }
 
 int Turbulence::GetSeed () const
 {
-  return m_xDistortModule.GetSeed ();
+  return m_distortModule.GetSeed ();
 }
 
 double Turbulence::GetValue (double x, double y) const
 {
   assert (m_pSourceModule[0] != NULL);
 
-  // Get the values from the three noise::module::Perlin noise modules and
-  // add each value to each coordinate of the input value.  There are also
-  // some offsets added to the coordinates of the input values.  This prevents
-  // the distortion modules from returning zero if the (x, y) coordinates,
-  // when multiplied by the frequency, are near an integer boundary.  This is
-  // due to a property of gradient coherent noise, which returns zero at
-  // integer boundaries.
-  double x0, y0;
-  double x1, y1;
-  double x2, y2;
-  x0 = x + (12414.0 / 65536.0);
-  y0 = y + (65124.0 / 65536.0);
-  x1 = x + (26519.0 / 65536.0);
-  y1 = y + (18128.0 / 65536.0);
-  x2 = x + (53820.0 / 65536.0);
-  y2 = y + (11213.0 / 65536.0);
-  double xDistort = x + (m_xDistortModule.GetValue (x0, y0)
-    * m_power);
-  double yDistort = y + (m_yDistortModule.GetValue (x1, y1)
-    * m_power);
+  // Get the displacements of both coordinates from the Perlin noise and add
+  // them to the input value.  The Perlin noise is evaluated at an offset
+  // input value.  This prevents it from returning zero if the (x, y)
+  // coordinates, when multiplied by the frequency, are near an integer
+  // boundary.  This is due to a property of gradient coherent noise, which
+  // returns zero at integer boundaries.  Both channels use the same offset,
+  // so that they share their lattice cells; their seeds differ.
+  double x0 = x + (12414.0 / 65536.0);
+  double y0 = y + (65124.0 / 65536.0);
+  double xDistort, yDistort;
+  m_distortModule.GenerateValue (x0, y0, GetEffectiveRoughness (),
+    xDistort, yDistort);
+  xDistort = x + (xDistort * m_power);
+  yDistort = y + (yDistort * m_power);
 
   // Retrieve the output value at the offsetted input value instead of the
   // original input value.
   return m_pSourceModule[0]->GetValue (xDistort, yDistort);
 }
 
+double Turbulence::GetValue (double x, double y, double footprint) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  double x0 = x + (12414.0 / 65536.0);
+  double y0 = y + (65124.0 / 65536.0);
+  double xDistort, yDistort;
+  m_distortModule.GenerateValue (x0, y0, GetEffectiveRoughness (footprint),
+    xDistort, yDistort);
+  xDistort = x + (xDistort * m_power);
+  yDistort = y + (yDistort * m_power);
+
+  return m_pSourceModule[0]->GetValue (xDistort, yDistort, footprint);
+}
+
 void Turbulence::SetSeed (int seed)
 {
-  // Set the seed of each noise::module::Perlin noise modules.  To prevent any
-  // sort of weird artifacting, use a slightly different seed for each noise
-  // module.
-  m_xDistortModule.SetSeed (seed    );
-  m_yDistortModule.SetSeed (seed + 1);
+  // To prevent any sort of weird artifacting, the y displacement uses a
+  // slightly different seed than the x displacement.
+  m_distortModule.SetSeed (seed);
+}
+
+void Turbulence::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  // See GetValue() for the offset added to the input values.
+  double xOffset[BATCH_BLOCK_SIZE];
+  double yOffset[BATCH_BLOCK_SIZE];
+  double xDistort[BATCH_BLOCK_SIZE];
+  double yDistort[BATCH_BLOCK_SIZE];
+  int octaveCount = GetEffectiveRoughness ();
+  for (size_t i = 0; i < n; i += BATCH_BLOCK_SIZE) {
+    size_t count = GetMin (n - i, (size_t)BATCH_BLOCK_SIZE);
+    const double* x = xs + i;
+    const double* y = ys + i;
+
+    for (size_t j = 0; j < count; j++) {
+      xOffset[j] = x[j] + (12414.0 / 65536.0);
+      yOffset[j] = y[j] + (65124.0 / 65536.0);
+    }
+    m_distortModule.GenerateValues (xOffset, yOffset, xDistort, yDistort,
+      count, octaveCount);
+
+    for (size_t j = 0; j < count; j++) {
+      xDistort[j] = x[j] + (xDistort[j] * m_power);
+      yDistort[j] = y[j] + (yDistort[j] * m_power);
+    }
+    m_pSourceModule[0]->GetValues (xDistort, yDistort, out + i, count);
+  }
 }
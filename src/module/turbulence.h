@@ -24,7 +24,7 @@
 #ifndef NOISE_MODULE_TURBULENCE_H
 #define NOISE_MODULE_TURBULENCE_H
 
-#include "perlin.h"
+#include "vectorperlin.h"
 
 namespace noise
 {
@@ -53,6 +53,10 @@ namespace noise
     /// Default noise seed for the noise::module::Turbulence noise module.
     const int DEFAULT_TURBULENCE_SEED = DEFAULT_PERLIN_SEED;
 
+    /// Default tolerance for the noise::module::Turbulence noise module,
+    /// 0 to generate all octaves of the displacement.
+    const double DEFAULT_TURBULENCE_TOLERANCE = 0.0;
+
     /// Noise module that randomly displaces the input value before
     /// returning the output value from a source module.
     ///
@@ -78,6 +82,9 @@ namespace noise
     /// amount, which produces more "kinky" changes.  To specify the
     /// roughness, call the SetRoughness() method.
     ///
+    /// The octaves of the displacement whose contribution is too small to
+    /// be seen can be left out, see SetTolerance().
+    ///
     /// Use of this noise module may require some trial and error.  Assuming
     /// that you are using a generator module as the source module, you
     /// should first:
@@ -106,9 +113,10 @@ namespace noise
     /// are generating values for textures, you can use this noise module to
     /// produce realistic marble-like or "oily" textures.
     ///
-    /// Internally, there are three noise::module::Perlin noise modules
-    /// that displace the input value; one for the @a x and one for the @a y
-    /// coordinate.
+    /// Internally, a noise::module::VectorPerlin object displaces the input
+    /// value; its channel 0 displaces the @a x and its channel 1 the @a y
+    /// coordinate.  Both channels are evaluated at the same offset input
+    /// value, so they share their lattice cells.
     ///
     /// This noise module requires one source module.
     class Turbulence: public Module
@@ -129,8 +137,28 @@ namespace noise
         ///
         /// The default seed value is set to
         /// noise::module::DEFAULT_TURBULENCE_SEED.
+        ///
+        /// The default tolerance is set to
+        /// noise::module::DEFAULT_TURBULENCE_TOLERANCE.
         Turbulence ();
 
+        /// Returns the number of octaves of the displacement that are
+        /// generated for a footprint.
+        ///
+        /// @param footprint The spacing of the input values, 0 for a
+        /// single input value.
+        ///
+        /// @returns The number of octaves, at least 1 and at most the
+        /// roughness.
+        ///
+        /// The octaves whose wavelength is shorter than the footprint are
+        /// left out, and so are the octaves that together cannot displace
+        /// the input value by the footprint or by the tolerance, whichever
+        /// is larger.  The remaining octaves are generated by GetValue()
+        /// and GetValues(), which use a footprint of 0, and by
+        /// GetValue (x, y, footprint).
+        int GetEffectiveRoughness (double footprint = 0.0) const;
+
         /// Returns the frequency of the turbulence.
         ///
         /// @returns The frequency of the turbulence.
@@ -139,6 +167,16 @@ namespace noise
         /// displacement amount changes.
         double GetFrequency () const;
 
+        /// Returns the noise type of the turbulence.
+        ///
+        /// @returns The noise type of the turbulence.
+        ///
+        /// See noise::NoiseType for definitions of the noise types.
+        noise::NoiseType GetNoiseType () const
+        {
+          return m_distortModule.GetNoiseType ();
+        }
+
         /// Returns the power of the turbulence.
         ///
         /// @returns The power of the turbulence.
@@ -160,16 +198,17 @@ namespace noise
         /// displacement amount, which produces more "kinky" changes.
         int GetRoughnessCount () const
         {
-          return m_xDistortModule.GetOctaveCount ();
+          return m_distortModule.GetOctaveCount ();
         }
 
-        /// Returns the seed value of the internal Perlin-noise modules that
-        /// are used to displace the input values.
+        /// Returns the seed value of the internal Perlin noise that is used
+        /// to displace the input values.
         ///
         /// @returns The seed value.
         ///
-        /// Internally, there are three noise::module::Perlin noise modules
-        /// that displace the input value; one for the @a x and one for the @a y coordinate.  
+        /// Internally, a noise::module::VectorPerlin object displaces the
+        /// input value; its channel 0 displaces the @a x and its channel 1
+        /// the @a y coordinate.
         int GetSeed () const;
 
         virtual int GetSourceModuleCount () const
@@ -177,8 +216,23 @@ namespace noise
           return 1;
         }
 
+        /// Returns the tolerance of the displacement.
+        ///
+        /// @returns The tolerance of the displacement.
+        ///
+        /// See SetTolerance().
+        double GetTolerance () const
+        {
+          return m_tolerance;
+        }
+
         virtual double GetValue (double x, double y) const;
 
+        virtual double GetValue (double x, double y, double footprint) const;
+
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
+
         /// Sets the frequency of the turbulence.
         ///
         /// @param frequency The frequency of the turbulence.
@@ -187,9 +241,19 @@ namespace noise
         /// displacement amount changes.
         void SetFrequency (double frequency)
         {
-          // Set the frequency of each Perlin-noise module.
-          m_xDistortModule.SetFrequency (frequency);
-          m_yDistortModule.SetFrequency (frequency);
+          m_distortModule.SetFrequency (frequency);
+        }
+
+        /// Sets the noise type of the turbulence.
+        ///
+        /// @param noiseType The noise type of the turbulence.
+        ///
+        /// See noise::NoiseType for definitions of the noise types.  With
+        /// noise::TYPE_OPENSIMPLEX, the displacement has no preferred
+        /// directions, and a lower roughness often gives the same detail.
+        void SetNoiseType (noise::NoiseType noiseType)
+        {
+          m_distortModule.SetNoiseType (noiseType);
         }
 
         /// Sets the power of the turbulence.
@@ -212,16 +276,32 @@ namespace noise
         /// the displacement amount.  High values roughly change the
         /// displacement amount, which produces more "kinky" changes.
         ///
-        /// Internally, there are three noise::module::Perlin noise modules
-        /// that displace the input value; one for the @a x and one for the
-        /// @a y coordinate. The roughness value is equal to
-        /// the number of octaves used by the noise::module::Perlin noise
-        /// modules.
+        /// Internally, a noise::module::VectorPerlin object displaces the
+        /// input value.  The roughness value is equal to the number of
+        /// octaves of its Perlin noise.
         void SetRoughness (int roughness)
         {
-          // Set the octave count for each Perlin-noise module.
-          m_xDistortModule.SetOctaveCount (roughness);
-          m_yDistortModule.SetOctaveCount (roughness);
+          m_distortModule.SetOctaveCount (roughness);
+        }
+
+        /// Sets the tolerance of the displacement.
+        ///
+        /// @param tolerance The largest displacement of the input value, in
+        /// input units, that may be left out.
+        ///
+        /// The octaves of the displacement are weighted by the powers of
+        /// its persistence and scaled by the power, so the last octaves
+        /// can only move the input value by a known distance.  The trailing
+        /// octaves that together cannot move it by @a tolerance or more
+        /// are not generated.  Set the tolerance to the size of an output
+        /// pixel in input units to leave out the octaves that cannot be
+        /// seen.
+        ///
+        /// A tolerance of 0, the default, generates all octaves, so the
+        /// output values are unchanged.  See GetEffectiveRoughness().
+        void SetTolerance (double tolerance)
+        {
+          m_tolerance = tolerance;
         }
 
         /// Sets the seed value of the internal noise modules that are used to
@@ -229,24 +309,27 @@ namespace noise
         ///
         /// @param seed The seed value.
         ///
-        /// Internally, there are three noise::module::Perlin noise modules
-        /// that displace the input value; one for the @a x and one for the @a y
-        /// coordinate.  This noise module assigns the
-        /// following seed values to the noise::module::Perlin noise modules:
-        /// - It assigns the seed value (@a seed + 0) to the @a x noise module.
-        /// - It assigns the seed value (@a seed + 1) to the @a y noise module.
+        /// Internally, a noise::module::VectorPerlin object displaces the
+        /// input value.  Its channels use the following seed values:
+        /// - The seed value (@a seed + 0) displaces the @a x coordinate.
+        /// - The seed value (@a seed + 1) displaces the @a y coordinate.
         void SetSeed (int seed);
 
       protected:
 
+        // CodeGenerator writes the displacement with the settings as
+        // constants.
+        friend class CodeGenerator;
+
         /// The power (scale) of the displacement.
         double m_power;
 
-        /// Noise module that displaces the @a x coordinate.
-        Perlin m_xDistortModule;
+        /// The largest displacement that may be left out.
+        double m_tolerance;
 
-        /// Noise module that displaces the @a y coordinate.
-        Perlin m_yDistortModule;
+        /// Perlin noise that displaces the @a x coordinate (channel 0) and
+        /// the @a y coordinate (channel 1).
+        VectorPerlin m_distortModule;
 
     };
 
@@ -0,0 +1,229 @@
+// vectorperlin.cpp
+//
+// Copyright (C) 2026 libnoise2d contributors
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "fractal.h"
+#include "vectorperlin.h"
+
+using namespace noise::module;
+
+namespace noise
+{
+
+  namespace module
+  {
+
+    namespace
+    {
+
+      // Octave loop of both channels for a single input value, specialised
+      // for a noise type and a noise quality like FractalValue().  Each
+      // channel is bit-identical to FractalValue() with PerlinSignal.
+      template <NoiseType TYPE, NoiseQuality QUALITY>
+      double PairFractalValue (const FractalParams& params, double x,
+        double y, int octaveCount, double& value1)
+      {
+        double value0 = 0.0;
+        double amplitude = 1.0;
+        value1 = 0.0;
+        x *= params.frequency;
+        y *= params.frequency;
+
+        // With enough octaves, evaluating the octaves of each channel in
+        // parallel SIMD lanes is faster than sharing the lattice cells.
+        if (TYPE != TYPE_OPENSIMPLEX && UseOctaveNoise2D (octaveCount)) {
+          double signals0[OCTAVE_LANES];
+          double signals1[OCTAVE_LANES];
+          OctaveNoise2D<TYPE, QUALITY> (x, y, params.lacunarity, params.seed,
+            params.seedMask, octaveCount, signals0);
+          OctaveNoise2D<TYPE, QUALITY> (x, y, params.lacunarity,
+            params.seed + 1, params.seedMask, octaveCount, signals1);
+          for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+            value0 += signals0[curOctave] * amplitude;
+            value1 += signals1[curOctave] * amplitude;
+            amplitude *= params.persistence;
+          }
+          value1 *= params.norm;
+          return value0 * params.norm;
+        }
+
+        for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+          double nx = MakeInt32Range (x);
+          double ny = MakeInt32Range (y);
+          double signal1;
+          double signal0 = Noise2DPair<TYPE, QUALITY> (nx, ny,
+            ArithmeticHash ((params.seed + curOctave) & params.seedMask),
+            ArithmeticHash ((params.seed + 1 + curOctave) & params.seedMask),
+            signal1);
+          value0 += signal0 * amplitude;
+          value1 += signal1 * amplitude;
+
+          // Prepare the next octave.
+          amplitude *= params.persistence;
+          x *= params.lacunarity;
+          y *= params.lacunarity;
+        }
+
+        value1 *= params.norm;
+        return value0 * params.norm;
+      }
+
+    }
+
+  }
+
+}
+
+VectorPerlin::VectorPerlin ():
+  m_frequency    (DEFAULT_PERLIN_FREQUENCY   ),
+  m_lacunarity   (DEFAULT_PERLIN_LACUNARITY  ),
+  m_noiseQuality (DEFAULT_PERLIN_QUALITY     ),
+  m_noiseType    (DEFAULT_PERLIN_TYPE        ),
+  m_octaveCount  (DEFAULT_PERLIN_OCTAVE_COUNT),
+  m_pPairKernel  (NULL),
+  m_persistence  (DEFAULT_PERLIN_PERSISTENCE ),
+  m_seed         (DEFAULT_PERLIN_SEED)
+{
+  UpdatePairKernel ();
+}
+
+FractalParams VectorPerlin::GetFractalParams () const
+{
+  FractalParams params;
+  params.frequency          = m_frequency;
+  params.lacunarity         = m_lacunarity;
+  params.persistence        = m_persistence;
+  params.norm               = GetNorm ();
+  params.seed               = m_seed;
+  params.seedMask           = 0xffffffff;
+  params.periodX            = 0;
+  params.periodY            = 0;
+  params.noiseType          = m_noiseType;
+  params.noiseQuality       = m_noiseQuality;
+  params.pPermutationTables = NULL;
+  params.pSpectralWeights   = NULL;
+  return params;
+}
+
+void VectorPerlin::UpdatePairKernel ()
+{
+  // Indexed by the noise type and the noise quality.
+  static const PairKernelPtr kernels[3][3] = {
+    {&PairFractalValue<TYPE_GRADIENT, QUALITY_FAST>,
+     &PairFractalValue<TYPE_GRADIENT, QUALITY_STD>,
+     &PairFractalValue<TYPE_GRADIENT, QUALITY_BEST>},
+    {&PairFractalValue<TYPE_VALUE, QUALITY_FAST>,
+     &PairFractalValue<TYPE_VALUE, QUALITY_STD>,
+     &PairFractalValue<TYPE_VALUE, QUALITY_BEST>},
+    {&PairFractalValue<TYPE_OPENSIMPLEX, QUALITY_FAST>,
+     &PairFractalValue<TYPE_OPENSIMPLEX, QUALITY_STD>,
+     &PairFractalValue<TYPE_OPENSIMPLEX, QUALITY_BEST>}
+  };
+  m_pPairKernel = kernels[m_noiseType][m_noiseQuality];
+}
+
+void VectorPerlin::GetValue (double x, double y, double& value0,
+  double& value1) const
+{
+  GenerateValue (x, y, m_octaveCount, value0, value1);
+}
+
+void VectorPerlin::GetValue (double x, double y, double footprint,
+  double& value0, double& value1) const
+{
+  GenerateValue (x, y, FootprintOctaveCount (m_frequency, m_lacunarity,
+    m_octaveCount, footprint), value0, value1);
+}
+
+void VectorPerlin::GetValues (const double* xs, const double* ys,
+  double* out0, double* out1, size_t n) const
+{
+  GenerateValues (xs, ys, out0, out1, n, m_octaveCount);
+}
+
+void VectorPerlin::GenerateValue (double x, double y, int octaveCount,
+  double& value0, double& value1) const
+{
+  value0 = m_pPairKernel (GetFractalParams (), x, y, octaveCount, value1);
+}
+
+void VectorPerlin::GenerateValues (const double* xs, const double* ys,
+  double* out0, double* out1, size_t n, int octaveCount) const
+{
+  FractalParams params = GetFractalParams ();
+
+  double x[BATCH_BLOCK_SIZE];
+  double y[BATCH_BLOCK_SIZE];
+  double nx[BATCH_BLOCK_SIZE];
+  double ny[BATCH_BLOCK_SIZE];
+  double signal0[BATCH_BLOCK_SIZE];
+  double signal1[BATCH_BLOCK_SIZE];
+
+  for (size_t i = 0; i < n; i += BATCH_BLOCK_SIZE) {
+    size_t count = GetMin (n - i, (size_t)BATCH_BLOCK_SIZE);
+    double* value0 = out0 + i;
+    double* value1 = out1 + i;
+    for (size_t j = 0; j < count; j++) {
+      x[j] = xs[i + j] * params.frequency;
+      y[j] = ys[i + j] * params.frequency;
+      value0[j] = 0.0;
+      value1[j] = 0.0;
+    }
+
+    // See FractalValues().
+    double amplitude = 1.0;
+    for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+      for (size_t j = 0; j < count; j++) {
+        nx[j] = MakeInt32Range (x[j]);
+        ny[j] = MakeInt32Range (y[j]);
+      }
+
+      int seed0 = (params.seed + curOctave) & params.seedMask;
+      int seed1 = (params.seed + 1 + curOctave) & params.seedMask;
+      switch (m_noiseType) {
+        case noise::TYPE_GRADIENT:
+          GradientCoherentNoise2DPair (nx, ny, signal0, signal1, count,
+            seed0, seed1, m_noiseQuality);
+          break;
+        case noise::TYPE_VALUE:
+          ValueCoherentNoise2DPair (nx, ny, signal0, signal1, count, seed0,
+            seed1, m_noiseQuality);
+          break;
+        case noise::TYPE_OPENSIMPLEX:
+          OpenSimplexNoise2DBatch (nx, ny, signal0, count, seed0);
+          OpenSimplexNoise2DBatch (nx, ny, signal1, count, seed1);
+          break;
+      }
+
+      for (size_t j = 0; j < count; j++) {
+        value0[j] += signal0[j] * amplitude;
+        value1[j] += signal1[j] * amplitude;
+
+        // Prepare the next octave.
+        x[j] *= params.lacunarity;
+        y[j] *= params.lacunarity;
+      }
+      amplitude *= params.persistence;
+    }
+
+    for (size_t j = 0; j < count; j++) {
+      value0[j] *= params.norm;
+      value1[j] *= params.norm;
+    }
+  }
+}
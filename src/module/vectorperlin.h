@@ -0,0 +1,329 @@
+// vectorperlin.h
+//
+// Copyright (C) 2026 libnoise2d contributors
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#ifndef NOISE_MODULE_VECTORPERLIN_H
+#define NOISE_MODULE_VECTORPERLIN_H
+
+#include "perlin.h"
+
+namespace noise
+{
+
+  namespace module
+  {
+
+    /// @addtogroup libnoise
+    /// @{
+
+    /// @addtogroup modules
+    /// @{
+
+    /// @addtogroup generatormodules
+    /// @{
+
+    /// Generates two channels of Perlin noise, such as the two components of
+    /// a displacement vector, in one pass.
+    ///
+    /// Channel 0 outputs the same values as a noise::module::Perlin module
+    /// with the same frequency, lacunarity, noise type, noise quality,
+    /// persistence and seed after a call to its SetOctaveCount() method.
+    /// Channel 1 outputs those of the same Perlin module with the seed
+    /// value (@a seed + 1).
+    ///
+    /// Both channels are evaluated at the same input value, so each octave
+    /// finds the lattice cell, the S-curves and the distances to the
+    /// lattice points once for both seeds, see
+    /// noise::GradientCoherentNoise2DPair().  This is cheaper than two
+    /// Perlin modules; noise::module::Turbulence uses it to displace the
+    /// @a x and @a y coordinates of its input value.
+    ///
+    /// The lattice hash is always noise::HASH_ARITHMETIC; there is no
+    /// lattice period and no tolerance.
+    ///
+    /// This object is not a noise module; it has no source modules and is
+    /// queried through its own GetValue() and GetValues() methods.
+    class VectorPerlin
+    {
+
+      public:
+
+        /// Constructor.
+        ///
+        /// The default frequency, lacunarity, number of octaves,
+        /// persistence value, noise quality, noise type and seed value are
+        /// those of noise::module::Perlin.
+        VectorPerlin ();
+
+        /// Returns the frequency of the first octave.
+        ///
+        /// @returns The frequency of the first octave.
+        double GetFrequency () const
+        {
+          return m_frequency;
+        }
+
+        /// Returns the lacunarity of the Perlin noise.
+        ///
+        /// @returns The lacunarity of the Perlin noise.
+        ///
+        /// The lacunarity is the frequency multiplier between successive
+        /// octaves.
+        double GetLacunarity () const
+        {
+          return m_lacunarity;
+        }
+
+        /// Returns the quality of the Perlin noise.
+        ///
+        /// @returns The quality of the Perlin noise.
+        ///
+        /// See noise::NoiseQuality for definitions of the various
+        /// coherent-noise qualities.
+        noise::NoiseQuality GetNoiseQuality () const
+        {
+          return m_noiseQuality;
+        }
+
+        /// Returns the type of the Perlin noise.
+        ///
+        /// @returns The type of the Perlin noise.
+        ///
+        /// See noise::NoiseType for definitions of the
+        /// coherent-noise types.
+        noise::NoiseType GetNoiseType () const
+        {
+          return m_noiseType;
+        }
+
+        /// Returns the number of octaves that generate the Perlin noise.
+        ///
+        /// @returns The number of octaves that generate the Perlin noise.
+        int GetOctaveCount () const
+        {
+          return m_octaveCount;
+        }
+
+        /// Returns the persistence value of the Perlin noise.
+        ///
+        /// @returns The persistence value of the Perlin noise.
+        double GetPersistence () const
+        {
+          return m_persistence;
+        }
+
+        /// Returns the seed value of channel 0.
+        ///
+        /// @returns The seed value of channel 0.
+        ///
+        /// Channel 1 uses the seed value (@a seed + 1).
+        int GetSeed () const
+        {
+          return m_seed;
+        }
+
+        /// Generates the output values of both channels for an input value.
+        ///
+        /// @param x The @a x coordinate of the input value.
+        /// @param y The @a y coordinate of the input value.
+        /// @param value0 Receives the output value of channel 0.
+        /// @param value1 Receives the output value of channel 1.
+        void GetValue (double x, double y, double& value0, double& value1)
+          const;
+
+        /// Generates the output values of both channels for an input value,
+        /// leaving out the octaves whose wavelength is shorter than the
+        /// footprint.
+        ///
+        /// @param x The @a x coordinate of the input value.
+        /// @param y The @a y coordinate of the input value.
+        /// @param footprint The spacing of the input values.
+        /// @param value0 Receives the output value of channel 0.
+        /// @param value1 Receives the output value of channel 1.
+        ///
+        /// See noise::module::Module::GetValue (x, y, footprint).
+        void GetValue (double x, double y, double footprint, double& value0,
+          double& value1) const;
+
+        /// Generates the output values of both channels for a buffer of
+        /// input values.
+        ///
+        /// @param xs The @a x coordinates of the input values.
+        /// @param ys The @a y coordinates of the input values.
+        /// @param out0 The buffer receiving the output values of channel 0.
+        /// @param out1 The buffer receiving the output values of channel 1.
+        /// @param n The number of input values.
+        ///
+        /// @pre The output buffers do not overlap @a xs or @a ys.
+        void GetValues (const double* xs, const double* ys, double* out0,
+          double* out1, size_t n) const;
+
+        /// Sets the frequency of the first octave.
+        ///
+        /// @param frequency The frequency of the first octave.
+        void SetFrequency (double frequency)
+        {
+          m_frequency = frequency;
+        }
+
+        /// Sets the lacunarity of the Perlin noise.
+        ///
+        /// @param lacunarity The lacunarity of the Perlin noise.
+        ///
+        /// The lacunarity is the frequency multiplier between successive
+        /// octaves.
+        void SetLacunarity (double lacunarity)
+        {
+          m_lacunarity = lacunarity;
+        }
+
+        /// Sets the quality of the Perlin noise.
+        ///
+        /// @param noiseQuality The quality of the Perlin noise.
+        ///
+        /// See noise::NoiseQuality for definitions of the various
+        /// coherent-noise qualities.
+        void SetNoiseQuality (noise::NoiseQuality noiseQuality)
+        {
+          m_noiseQuality = noiseQuality;
+          UpdatePairKernel ();
+        }
+
+        /// Sets the type of the Perlin noise.
+        ///
+        /// @param noiseType The type of the Perlin noise.
+        ///
+        /// See noise::NoiseType for definitions of the
+        /// coherent-noise types.
+        void SetNoiseType (noise::NoiseType noiseType)
+        {
+          m_noiseType = noiseType;
+          UpdatePairKernel ();
+        }
+
+        /// Sets the number of octaves that generate the Perlin noise.
+        ///
+        /// @param octaveCount The number of octaves that generate the Perlin
+        /// noise.
+        ///
+        /// @pre The number of octaves ranges from 1 to
+        /// noise::module::PERLIN_MAX_OCTAVE.
+        ///
+        /// @throw noise::ExceptionInvalidParam An invalid parameter was
+        /// specified; see the preconditions for more information.
+        void SetOctaveCount (int octaveCount)
+        {
+          if (octaveCount < 1 || octaveCount > PERLIN_MAX_OCTAVE) {
+            throw noise::ExceptionInvalidParam ();
+          }
+          m_octaveCount = octaveCount;
+        }
+
+        /// Sets the persistence value of the Perlin noise.
+        ///
+        /// @param persistence The persistence value of the Perlin noise.
+        ///
+        /// The output values are normalised by (1 - @a persistence).
+        void SetPersistence (double persistence)
+        {
+          m_persistence = persistence;
+        }
+
+        /// Sets the seed value of channel 0.
+        ///
+        /// @param seed The seed value of channel 0.
+        ///
+        /// Channel 1 uses the seed value (@a seed + 1).
+        void SetSeed (int seed)
+        {
+          m_seed = seed;
+        }
+
+      protected:
+
+        // Turbulence chooses the number of octaves of its displacement, and
+        // CodeGenerator writes them with the settings as constants.
+        friend class Turbulence;
+        friend class CodeGenerator;
+
+        /// Octave loop of both channels for a single input value,
+        /// specialised for a noise type and a noise quality.
+        typedef double (*PairKernelPtr) (const FractalParams& params,
+          double x, double y, int octaveCount, double& value1);
+
+        /// Generates the output values of both channels for an input value
+        /// from the first @a octaveCount octaves, see GetValue().
+        void GenerateValue (double x, double y, int octaveCount,
+          double& value0, double& value1) const;
+
+        /// Generates the output values of both channels for a buffer of
+        /// input values from the first @a octaveCount octaves, see
+        /// GetValues().
+        void GenerateValues (const double* xs, const double* ys,
+          double* out0, double* out1, size_t n, int octaveCount) const;
+
+        /// Returns the parameters of the octave loop of channel 0.
+        FractalParams GetFractalParams () const;
+
+        /// Returns the factor that scales the sum of the octaves, so that
+        /// the output values usually range from -1.0 to +1.0.
+        double GetNorm () const
+        {
+          return 1.0 - m_persistence;
+        }
+
+        /// Selects the octave loop for the noise type and the noise quality.
+        void UpdatePairKernel ();
+
+        /// Frequency of the first octave.
+        double m_frequency;
+
+        /// Frequency multiplier between successive octaves.
+        double m_lacunarity;
+
+        /// Quality of the Perlin noise.
+        noise::NoiseQuality m_noiseQuality;
+
+        /// Type of the Perlin noise.
+        noise::NoiseType m_noiseType;
+
+        /// Total number of octaves that generate the Perlin noise.
+        int m_octaveCount;
+
+        /// Octave loop of both channels for a single input value.
+        PairKernelPtr m_pPairKernel;
+
+        /// Persistence of the Perlin noise.
+        double m_persistence;
+
+        /// Seed value of channel 0.
+        int m_seed;
+
+    };
+
+    /// @}
+
+    /// @}
+
+    /// @}
+
+  }
+
+}
+
+#endif
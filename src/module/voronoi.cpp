@@ -22,6 +22,7 @@
 //
 
 #include "../mathconsts.h"
+#include "../noisegenscalar.h"
 #include "voronoi.h"
 
 using namespace noise::module;
@@ -31,6 +32,8 @@ Voronoi::Voronoi ():
   m_displacement   (DEFAULT_VORONOI_DISPLACEMENT),
   m_enableDistance (false                       ),
   m_frequency      (DEFAULT_VORONOI_FREQUENCY   ),
+  m_periodX        (DEFAULT_VORONOI_PERIOD      ),
+  m_periodY        (DEFAULT_VORONOI_PERIOD      ),
   m_seed           (DEFAULT_VORONOI_SEED        )
 {
 }
@@ -57,9 +60,12 @@ double Voronoi::GetValue (double x, double y) const
         for (int xCur = xInt - 2; xCur <= xInt + 2; xCur++) {
 
         // Calculate the position and distance to the seed point inside of
-        // this unit cube.
-        double xPos = xCur + ValueNoise2D (xCur, yCur, m_seed    );
-        double yPos = yCur + ValueNoise2D (xCur, yCur, m_seed + 1);
+        // this unit cube.  With a period, the seed point of the wrapped
+        // cube is moved into this cube.
+        int xWrap = WrapLattice (xCur, m_periodX);
+        int yWrap = WrapLattice (yCur, m_periodY);
+        double xPos = xCur + ValueNoise2D (xWrap, yWrap, m_seed    );
+        double yPos = yCur + ValueNoise2D (xWrap, yWrap, m_seed + 1);
         double xDist = xPos - x;
         double yDist = yPos - y;
         double dist = xDist * xDist + yDist * yDist;
@@ -87,6 +93,14 @@ double Voronoi::GetValue (double x, double y) const
 
   // Return the calculated distance with the displacement value applied.
   return value + (m_displacement * (double)ValueNoise2D (
-    (int)(floor (xCandidate)),
-    (int)(floor (yCandidate))));
+    WrapLattice ((int)(floor (xCandidate)), m_periodX),
+    WrapLattice ((int)(floor (yCandidate)), m_periodY)));
+}
+
+void Voronoi::GetValues (const double* xs, const double* ys, double* out,
+  size_t n) const
+{
+  for (size_t i = 0; i < n; i++) {
+    out[i] = Voronoi::GetValue (xs[i], ys[i]);
+  }
 }
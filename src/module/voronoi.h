@@ -49,6 +49,10 @@ namespace noise
     /// noise module.
     const double DEFAULT_VORONOI_FREQUENCY = 1.0;
 
+    /// Default period of the seed points for the noise::module::Voronoi
+    /// noise module, 0 for no period.
+    const int DEFAULT_VORONOI_PERIOD = 0;
+
     /// Default seed of the noise function for the noise::module::Voronoi
     /// noise module.
     const int DEFAULT_VORONOI_SEED = 0;
@@ -101,6 +105,9 @@ namespace noise
         /// The default frequency is set to
         /// noise::module::DEFAULT_VORONOI_FREQUENCY.
         ///
+        /// The default periods are set to
+        /// noise::module::DEFAULT_VORONOI_PERIOD.
+        ///
         /// The default seed value is set to
         /// noise::module::DEFAULT_VORONOI_SEED.
         Voronoi ();
@@ -146,6 +153,24 @@ namespace noise
           return m_frequency;
         }
 
+        /// Returns the period of the seed points along the @a x axis.
+        ///
+        /// @returns The period in unit cells, or 0 if the Voronoi cells do
+        /// not repeat along the @a x axis.
+        int GetPeriodX () const
+        {
+          return m_periodX;
+        }
+
+        /// Returns the period of the seed points along the @a y axis.
+        ///
+        /// @returns The period in unit cells, or 0 if the Voronoi cells do
+        /// not repeat along the @a y axis.
+        int GetPeriodY () const
+        {
+          return m_periodY;
+        }
+
         virtual int GetSourceModuleCount () const
         {
           return 0;
@@ -178,8 +203,13 @@ namespace noise
           return m_enableDistance;
         }
 
+        using Module::GetValue;
+
         virtual double GetValue (double x, double y) const;
 
+        virtual void GetValues (const double* xs, const double* ys,
+          double* out, size_t n) const;
+
         /// Sets the displacement value of the Voronoi cells.
         ///
         /// @param displacement The displacement value of the Voronoi cells.
@@ -204,6 +234,23 @@ namespace noise
           m_frequency = frequency;
         }
 
+        /// Sets the periods of the seed points, so that the Voronoi cells
+        /// tile seamlessly.
+        ///
+        /// @param periodX The period along the @a x axis, in unit cells.
+        /// @param periodY The period along the @a y axis, in unit cells.
+        ///
+        /// The seed point and the random value of a unit cell are repeated
+        /// every @a periodX cells along the @a x axis and every @a periodY
+        /// cells along the @a y axis, so the output repeats every
+        /// @a periodX / @a frequency and @a periodY / @a frequency units.  A
+        /// period of 0 disables the wrap along its axis.
+        void SetPeriod (int periodX, int periodY)
+        {
+          m_periodX = periodX;
+          m_periodY = periodY;
+        }
+
         /// Sets the seed value used by the Voronoi cells
         ///
         /// @param seed The seed value.
@@ -228,6 +275,12 @@ namespace noise
         /// Frequency of the seed points.
         double m_frequency;
 
+        /// Period of the seed points along the @a x axis, or 0.
+        int m_periodX;
+
+        /// Period of the seed points along the @a y axis, or 0.
+        int m_periodY;
+
         /// Seed value used by the coherent-noise function to determine the
         /// positions of the seed points.
         int m_seed;
@@ -22,42 +22,123 @@
 //
 
 #include "noisegen.h"
+#include "noisegenimpl.h"
+#include "noisegenscalar.h"
 #include "interp.h"
 #include "vectortable.h"
-#include "xxhash.h"
 
 #include <cmath>
 
+#if defined(NOISE_USE_SIMD) && defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
 using namespace noise;
 
-const double SQRT1_2 = 1.0 / std::sqrt(2.0);
-
-// Specifies the version of the coherent-noise functions to use.
-// - Set to 2 to use the current version.
-// - Set to 1 to use the flawed version from the original version of libnoise.
-// If your application requires coherent-noise values that were generated by
-// an earlier version of libnoise, change this constant to the appropriate
-// value and recompile libnoise.
-#define NOISE_VERSION 2
-
-// These constants control certain parameters that all coherent-noise
-// functions require.
-#if (NOISE_VERSION == 1)
-// Constants used by the original version of libnoise.
-// Because X_NOISE_GEN is not relatively prime to the other values, and
-// Z_NOISE_GEN is close to 256 (the number of random gradient vectors),
-// patterns show up in high-frequency coherent noise.
-const int X_NOISE_GEN = 1;
-const int Y_NOISE_GEN = 31337;
-const int SEED_NOISE_GEN = 1013;
-const int SHIFT_NOISE_GEN = 13;
+// Queries the CPU for the best supported SIMD instruction set.  Only
+// instruction sets the operating system saves on context switches are
+// taken into account.
+static SimdLevel DetectSimdLevel ()
+{
+#if defined(NOISE_USE_SIMD) && defined(__GNUC__)
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx512f")) {
+    return SIMD_AVX512;
+  } else if (__builtin_cpu_supports ("avx2")) {
+    return SIMD_AVX2;
+  } else if (__builtin_cpu_supports ("sse2")) {
+    return SIMD_SSE2;
+  }
+  return SIMD_NONE;
+#elif defined(NOISE_USE_SIMD) && defined(_MSC_VER)
+  int info[4];
+  __cpuid (info, 0);
+  int maxLeaf = info[0];
+  __cpuid (info, 1);
+  bool hasSse2 = (info[3] & (1 << 26)) != 0;
+  bool hasAvx  = (info[2] & (1 << 28)) != 0;
+  unsigned long long xcr0 = 0;
+  if (info[2] & (1 << 27)) {
+    xcr0 = _xgetbv (0);
+  }
+  if (maxLeaf >= 7 && hasAvx && (xcr0 & 0x06) == 0x06) {
+    __cpuidex (info, 7, 0);
+    if ((info[1] & (1 << 16)) && (xcr0 & 0xe6) == 0xe6) {
+      return SIMD_AVX512;
+    } else if (info[1] & (1 << 5)) {
+      return SIMD_AVX2;
+    }
+  }
+  return hasSse2? SIMD_SSE2: SIMD_NONE;
 #else
-// Constants used by the current version of libnoise.
-const int X_NOISE_GEN = 1619;
-const int Y_NOISE_GEN = 31337;
-const int SEED_NOISE_GEN = 1013;
-const int SHIFT_NOISE_GEN = 8;
+  return SIMD_NONE;
 #endif
+}
+
+// Maximum SIMD level set by the application.
+static SimdLevel g_simdLevelLimit = SIMD_AVX512;
+
+SimdLevel noise::GetSupportedSimdLevel ()
+{
+  static const SimdLevel supportedLevel = DetectSimdLevel ();
+  return supportedLevel;
+}
+
+SimdLevel noise::GetSimdLevel ()
+{
+  SimdLevel supportedLevel = GetSupportedSimdLevel ();
+  return (g_simdLevelLimit < supportedLevel)? g_simdLevelLimit: supportedLevel;
+}
+
+void noise::SetSimdLevel (SimdLevel simdLevel)
+{
+  g_simdLevelLimit = simdLevel;
+}
+
+PermutationTable::PermutationTable (int seed)
+{
+  SetSeed (seed);
+}
+
+void PermutationTable::SetSeed (int seed)
+{
+  m_seed = seed;
+
+  // Shuffle the numbers 0 to 255 (Fisher-Yates), drawing the random numbers
+  // from the integer-noise function so that the permutation of a seed is
+  // the same on every platform.
+  for (int i = 0; i < 256; i++) {
+    m_permutation[i] = (uint8)i;
+  }
+  for (int i = 255; i > 0; i--) {
+    int j = IntValueNoise2D (i, 0, seed) % (i + 1);
+    uint8 swap = m_permutation[i];
+    m_permutation[i] = m_permutation[j];
+    m_permutation[j] = swap;
+  }
+  for (int i = 0; i < 256; i++) {
+    m_permutation[i + 256] = m_permutation[i];
+  }
+}
+
+// Returns the batch kernels of the SIMD level in use, or NULL if the scalar
+// functions should be used.
+static const simd::KernelTable* GetKernelTable ()
+{
+#ifdef NOISE_USE_SIMD
+  switch (GetSimdLevel ()) {
+    case SIMD_AVX512:
+      return &simd::AVX512_KERNELS;
+    case SIMD_AVX2:
+      return &simd::AVX2_KERNELS;
+    case SIMD_SSE2:
+      return &simd::SSE2_KERNELS;
+    case SIMD_NONE:
+      break;
+  }
+#endif
+  return NULL;
+}
 
 double noise::GradientCoherentNoise2D (double x, double y, int seed,
   NoiseQuality noiseQuality)
@@ -102,22 +183,357 @@ double noise::GradientCoherentNoise2D (double x, double y, int seed,
   return LinearInterp (ix0, ix1, ys);
 }
 
+void noise::GradientCoherentNoise2DBatch (const double* x, const double* y,
+  double* out, size_t n, int seed, NoiseQuality noiseQuality)
+{
+  const simd::KernelTable* kernels = GetKernelTable ();
+  if (kernels != NULL) {
+    kernels->gradientCoherentNoise2D (x, y, out, n, seed, noiseQuality);
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    out[i] = GradientCoherentNoise2D (x[i], y[i], seed, noiseQuality);
+  }
+}
+
+// Evaluates a grid of coherent noise, see GradientCoherentNoise2DGrid().
+// The columns are processed in blocks.  Each block records the lattice
+// columns its cells use.  The lattice points of a lattice row are computed
+// only when the rows move to another lattice cell, together with the data
+// of the left and right corners of each column.  When the rows move to the
+// next cell, the upper corners become the lower ones.
+template <class Lattice, class Hash>
+static void CoherentNoise2DGrid (const double* x, size_t width,
+  const double* y, size_t height, double* out, size_t stride,
+  const Hash& hash, NoiseQuality noiseQuality)
+{
+  const size_t BLOCK_SIZE = 256;
+  const int SIZE = Lattice::SIZE;
+
+  // Per column: S-curve value, distances to the left and right lattice
+  // columns and their index into the lattice columns of the block.
+  double xs[BLOCK_SIZE];
+  double xvPoint[BLOCK_SIZE * 2];
+  int latticeIndex[BLOCK_SIZE * 2];
+
+  // Lattice columns of the block, the data of one lattice row and the
+  // corner data of the columns for the lower and upper lattice row.
+  int lattice[BLOCK_SIZE * 2];
+  double corners[BLOCK_SIZE * 2 * SIZE];
+  double columnsBuffer0[BLOCK_SIZE * 2 * SIZE];
+  double columnsBuffer1[BLOCK_SIZE * 2 * SIZE];
+
+  for (size_t i0 = 0; i0 < width; i0 += BLOCK_SIZE) {
+    size_t count = (width - i0 < BLOCK_SIZE)? width - i0: BLOCK_SIZE;
+
+    int latticeCount = 0;
+    int prevX0 = 0;
+    for (size_t i = 0; i < count; i++) {
+      double fx = x[i0 + i];
+      int x0 = (fx > 0.0? (int)fx: (int)fx - 1);
+      int x1 = x0 + 1;
+      if (i == 0 || x0 != prevX0) {
+        if (latticeCount == 0 || lattice[latticeCount - 1] != x0) {
+          lattice[latticeCount++] = x0;
+        }
+        lattice[latticeCount++] = x1;
+        prevX0 = x0;
+      }
+      latticeIndex[i * 2    ] = latticeCount - 2;
+      latticeIndex[i * 2 + 1] = latticeCount - 1;
+      xs[i] = MapToSCurve (fx - (double)x0, noiseQuality);
+      xvPoint[i * 2    ] = fx - (double)x0;
+      xvPoint[i * 2 + 1] = fx - (double)x1;
+    }
+
+    double* columns0 = columnsBuffer0;
+    double* columns1 = columnsBuffer1;
+    bool hasColumns = false;
+    int columnsY0 = 0;
+    for (size_t j = 0; j < height; j++) {
+      double fy = y[j];
+      int y0 = (fy > 0.0? (int)fy: (int)fy - 1);
+      int y1 = y0 + 1;
+      double ys = MapToSCurve (fy - (double)y0, noiseQuality);
+      double yvPoint0 = fy - (double)y0;
+      double yvPoint1 = fy - (double)y1;
+
+      if (!hasColumns || y0 != columnsY0) {
+        for (int iy = y0; iy <= y1; iy++) {
+          if (iy == y0 && hasColumns && y0 == columnsY0 + 1) {
+            double* swap = columns0;
+            columns0 = columns1;
+            columns1 = swap;
+            continue;
+          }
+          double* columns = (iy == y0)? columns0: columns1;
+          for (int k = 0; k < latticeCount; k++) {
+            Lattice::Corner (hash, lattice[k], iy, corners + k * SIZE);
+          }
+          for (size_t k = 0; k < count * 2; k++) {
+            Lattice::Column (corners + latticeIndex[k] * SIZE, xvPoint[k],
+              columns + k * SIZE);
+          }
+        }
+        hasColumns = true;
+        columnsY0 = y0;
+      }
+
+      double* row = out + j * stride + i0;
+      for (size_t i = 0; i < count; i++) {
+        double n0, n1, ix0, ix1;
+        n0  = Lattice::Value (columns0 + (i * 2    ) * SIZE, yvPoint0);
+        n1  = Lattice::Value (columns0 + (i * 2 + 1) * SIZE, yvPoint0);
+        ix0 = LinearInterp (n0, n1, xs[i]);
+        n0  = Lattice::Value (columns1 + (i * 2    ) * SIZE, yvPoint1);
+        n1  = Lattice::Value (columns1 + (i * 2 + 1) * SIZE, yvPoint1);
+        ix1 = LinearInterp (n0, n1, xs[i]);
+        row[i] = LinearInterp (ix0, ix1, ys);
+      }
+    }
+  }
+}
+
+void noise::GradientCoherentNoise2DGrid (const double* x, size_t width,
+  const double* y, size_t height, double* out, size_t stride, int seed,
+  NoiseQuality noiseQuality)
+{
+  CoherentNoise2DGrid<GradientLattice> (x, width, y, height, out, stride,
+    ArithmeticHash (seed), noiseQuality);
+}
+
+void noise::GradientCoherentNoise2DGrid (const double* x, size_t width,
+  const double* y, size_t height, double* out, size_t stride,
+  const PermutationTable& table, NoiseQuality noiseQuality)
+{
+  CoherentNoise2DGrid<GradientLattice> (x, width, y, height, out, stride,
+    PermutationHash (table), noiseQuality);
+}
+
+void noise::ValueCoherentNoise2DGrid (const double* x, size_t width,
+  const double* y, size_t height, double* out, size_t stride, int seed,
+  NoiseQuality noiseQuality)
+{
+  CoherentNoise2DGrid<ValueLattice> (x, width, y, height, out, stride,
+    ArithmeticHash (seed), noiseQuality);
+}
+
+void noise::ValueCoherentNoise2DGrid (const double* x, size_t width,
+  const double* y, size_t height, double* out, size_t stride,
+  const PermutationTable& table, NoiseQuality noiseQuality)
+{
+  CoherentNoise2DGrid<ValueLattice> (x, width, y, height, out, stride,
+    PermutationHash (table), noiseQuality);
+}
+
+double noise::GradientCoherentNoise2D (double x, double y,
+  const PermutationTable& table, NoiseQuality noiseQuality)
+{
+  return CoherentNoise2D<GradientLattice> (x, y, PermutationHash (table),
+    noiseQuality);
+}
+
+void noise::GradientCoherentNoise2DBatch (const double* x, const double* y,
+  double* out, size_t n, const PermutationTable& table,
+  NoiseQuality noiseQuality)
+{
+  PermutationHash hash (table);
+  for (size_t i = 0; i < n; i++) {
+    out[i] = CoherentNoise2D<GradientLattice> (x[i], y[i], hash,
+      noiseQuality);
+  }
+}
+
+void noise::GradientCoherentNoise2DSeeds (const double* x, const double* y,
+  const int* seeds, double* out, size_t n, NoiseQuality noiseQuality)
+{
+  const simd::KernelTable* kernels = GetKernelTable ();
+  if (kernels != NULL) {
+    kernels->gradientCoherentNoise2DSeeds (x, y, seeds, out, n, noiseQuality);
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    out[i] = GradientCoherentNoise2D (x[i], y[i], seeds[i], noiseQuality);
+  }
+}
+
+void noise::GradientCoherentNoise2DPair (const double* x, const double* y,
+  double* out0, double* out1, size_t n, int seed0, int seed1,
+  NoiseQuality noiseQuality)
+{
+  const simd::KernelTable* kernels = GetKernelTable ();
+  if (kernels != NULL) {
+    kernels->gradientCoherentNoise2DPair (x, y, out0, out1, n, seed0, seed1,
+      noiseQuality);
+    return;
+  }
+  ArithmeticHash hash0 (seed0);
+  ArithmeticHash hash1 (seed1);
+  for (size_t i = 0; i < n; i++) {
+    out0[i] = CoherentNoise2DPair<GradientLattice> (x[i], y[i], hash0, hash1,
+      noiseQuality, out1[i]);
+  }
+}
+
+double noise::ValueCoherentNoise2D (double x, double y,
+  const PermutationTable& table, NoiseQuality noiseQuality)
+{
+  return CoherentNoise2D<ValueLattice> (x, y, PermutationHash (table),
+    noiseQuality);
+}
+
+double noise::GradientCoherentNoise2DDeriv (double x, double y,
+  double& dx, double& dy, int seed, NoiseQuality noiseQuality)
+{
+  return CoherentNoise2DDeriv<GradientLattice> (x, y, ArithmeticHash (seed),
+    noiseQuality, dx, dy);
+}
+
+double noise::GradientCoherentNoise2DDeriv (double x, double y,
+  double& dx, double& dy, const PermutationTable& table,
+  NoiseQuality noiseQuality)
+{
+  return CoherentNoise2DDeriv<GradientLattice> (x, y,
+    PermutationHash (table), noiseQuality, dx, dy);
+}
+
+double noise::ValueCoherentNoise2DDeriv (double x, double y,
+  double& dx, double& dy, int seed, NoiseQuality noiseQuality)
+{
+  return CoherentNoise2DDeriv<ValueLattice> (x, y, ArithmeticHash (seed),
+    noiseQuality, dx, dy);
+}
+
+double noise::ValueCoherentNoise2DDeriv (double x, double y,
+  double& dx, double& dy, const PermutationTable& table,
+  NoiseQuality noiseQuality)
+{
+  return CoherentNoise2DDeriv<ValueLattice> (x, y, PermutationHash (table),
+    noiseQuality, dx, dy);
+}
+
+void noise::ValueCoherentNoise2DBatch (const double* x, const double* y,
+  double* out, size_t n, const PermutationTable& table,
+  NoiseQuality noiseQuality)
+{
+  PermutationHash hash (table);
+  for (size_t i = 0; i < n; i++) {
+    out[i] = CoherentNoise2D<ValueLattice> (x[i], y[i], hash, noiseQuality);
+  }
+}
+
+void noise::ValueCoherentNoise2DSeeds (const double* x, const double* y,
+  const int* seeds, double* out, size_t n, NoiseQuality noiseQuality)
+{
+  const simd::KernelTable* kernels = GetKernelTable ();
+  if (kernels != NULL) {
+    kernels->valueCoherentNoise2DSeeds (x, y, seeds, out, n, noiseQuality);
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    out[i] = ValueCoherentNoise2D (x[i], y[i], seeds[i], noiseQuality);
+  }
+}
+
+void noise::ValueCoherentNoise2DPair (const double* x, const double* y,
+  double* out0, double* out1, size_t n, int seed0, int seed1,
+  NoiseQuality noiseQuality)
+{
+  const simd::KernelTable* kernels = GetKernelTable ();
+  if (kernels != NULL) {
+    kernels->valueCoherentNoise2DPair (x, y, out0, out1, n, seed0, seed1,
+      noiseQuality);
+    return;
+  }
+  ArithmeticHash hash0 (seed0);
+  ArithmeticHash hash1 (seed1);
+  for (size_t i = 0; i < n; i++) {
+    out0[i] = CoherentNoise2DPair<ValueLattice> (x[i], y[i], hash0, hash1,
+      noiseQuality, out1[i]);
+  }
+}
+
+double noise::GradientCoherentNoise2DPeriodic (double x, double y,
+  int periodX, int periodY, int seed, NoiseQuality noiseQuality)
+{
+  return CoherentNoise2D<GradientLattice> (x, y,
+    PeriodicHash<ArithmeticHash> (ArithmeticHash (seed), periodX, periodY),
+    noiseQuality);
+}
+
+double noise::GradientCoherentNoise2DPeriodic (double x, double y,
+  int periodX, int periodY, const PermutationTable& table,
+  NoiseQuality noiseQuality)
+{
+  return CoherentNoise2D<GradientLattice> (x, y,
+    PeriodicHash<PermutationHash> (PermutationHash (table), periodX,
+      periodY), noiseQuality);
+}
+
+double noise::ValueCoherentNoise2DPeriodic (double x, double y,
+  int periodX, int periodY, int seed, NoiseQuality noiseQuality)
+{
+  return CoherentNoise2D<ValueLattice> (x, y,
+    PeriodicHash<ArithmeticHash> (ArithmeticHash (seed), periodX, periodY),
+    noiseQuality);
+}
+
+double noise::ValueCoherentNoise2DPeriodic (double x, double y,
+  int periodX, int periodY, const PermutationTable& table,
+  NoiseQuality noiseQuality)
+{
+  return CoherentNoise2D<ValueLattice> (x, y,
+    PeriodicHash<PermutationHash> (PermutationHash (table), periodX,
+      periodY), noiseQuality);
+}
+
+int32 noise::GradientCoherentNoise2DFixed (int32 x, int32 y, int seed,
+  NoiseQuality noiseQuality)
+{
+  return CoherentNoise2DFixed<GradientLatticeFixed> (x, y, seed,
+    noiseQuality);
+}
+
+void noise::GradientCoherentNoise2DFixedBatch (const int32* x,
+  const int32* y, int32* out, size_t n, int seed, NoiseQuality noiseQuality)
+{
+  const simd::KernelTable* kernels = GetKernelTable ();
+  if (kernels != NULL) {
+    kernels->gradientCoherentNoise2DFixed (x, y, out, n, seed, noiseQuality);
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    out[i] = CoherentNoise2DFixed<GradientLatticeFixed> (x[i], y[i], seed,
+      noiseQuality);
+  }
+}
+
+int32 noise::ValueCoherentNoise2DFixed (int32 x, int32 y, int seed,
+  NoiseQuality noiseQuality)
+{
+  return CoherentNoise2DFixed<ValueLatticeFixed> (x, y, seed, noiseQuality);
+}
+
+void noise::ValueCoherentNoise2DFixedBatch (const int32* x, const int32* y,
+  int32* out, size_t n, int seed, NoiseQuality noiseQuality)
+{
+  const simd::KernelTable* kernels = GetKernelTable ();
+  if (kernels != NULL) {
+    kernels->valueCoherentNoise2DFixed (x, y, out, n, seed, noiseQuality);
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    out[i] = CoherentNoise2DFixed<ValueLatticeFixed> (x[i], y[i], seed,
+      noiseQuality);
+  }
+}
+
 double noise::GradientNoise2D (double fx, double fy, int ix,
   int iy, int seed)
 {
-  // Randomly generate a gradient vector given the integer coordinates of the
-  // input value.  This implementation generates a random number and uses it
-  // as an index into a normalized-vector lookup table.
-  int vectorIndex = (
-      X_NOISE_GEN    * ix
-    + Y_NOISE_GEN    * iy
-    + SEED_NOISE_GEN * seed)
-    & 0xffffffff;
-  vectorIndex ^= (vectorIndex >> SHIFT_NOISE_GEN);
-  vectorIndex &= 0xff;
-
-  double xvGradient = g_randomVectors[(vectorIndex << 1)    ];
-  double yvGradient = g_randomVectors[(vectorIndex << 1) + 1];
+  const double* gradient = GetGradientVector (ix, iy, seed);
+  double xvGradient = gradient[0];
+  double yvGradient = gradient[1];
 
   // Set up us another vector equal to the distance between the two vectors
   // passed to this function.
@@ -133,15 +549,92 @@ double noise::GradientNoise2D (double fx, double fy, int ix,
 
 int noise::IntValueNoise2D (int x, int y, int seed)
 {
-  // All constants are primes and must remain prime in order for this noise
-  // function to work correctly.
-  int n = (
-      X_NOISE_GEN    * x
-    + Y_NOISE_GEN    * y
-    + SEED_NOISE_GEN * seed)
-    & 0x7fffffff;
-  n = (n >> 13) ^ n;
-  return (n * (n * n * 60493 + 19990303) + 1376312589) & 0x7fffffff;
+  return IntValueHash (x, y, seed);
+}
+
+double noise::SimplexNoise2D (double x, double y, int seed)
+{
+  int i, j;
+  double x0, y0;
+  bool lower = SimplexCell (x, y, i, j, x0, y0);
+
+  // The middle corner is offset along x in the lower triangle, else along
+  // y.
+  int i1 = lower? 1: 0;
+  int j1 = 1 - i1;
+
+  // Distances to the middle and the last corner.
+  double x1 = (x0 - (double)i1) + SIMPLEX_UNSKEW;
+  double y1 = (y0 - (double)j1) + SIMPLEX_UNSKEW;
+  double x2 = (x0 - 1.0) + (2.0 * SIMPLEX_UNSKEW);
+  double y2 = (y0 - 1.0) + (2.0 * SIMPLEX_UNSKEW);
+
+  // Sum the contributions of the three corners.
+  double n0 = SimplexCorner (GetGradientVector (i, j, seed),
+    SIMPLEX_RADIUS2, x0, y0);
+  double n1 = SimplexCorner (GetGradientVector (i + i1, j + j1, seed),
+    SIMPLEX_RADIUS2, x1, y1);
+  double n2 = SimplexCorner (GetGradientVector (i + 1, j + 1, seed),
+    SIMPLEX_RADIUS2, x2, y2);
+  return ((n0 + n1) + n2) * SIMPLEX_SCALE;
+}
+
+void noise::SimplexNoise2DBatch (const double* x, const double* y,
+  double* out, size_t n, int seed)
+{
+  const simd::KernelTable* kernels = GetKernelTable ();
+  if (kernels != NULL) {
+    kernels->simplexNoise2D (x, y, out, n, seed);
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    out[i] = SimplexNoise2D (x[i], y[i], seed);
+  }
+}
+
+double noise::OpenSimplexNoise2D (double x, double y, int seed)
+{
+  return OpenSimplex2D (x, y, ArithmeticHash (seed));
+}
+
+double noise::OpenSimplexNoise2D (double x, double y,
+  const PermutationTable& table)
+{
+  return OpenSimplex2D (x, y, PermutationHash (table));
+}
+
+double noise::OpenSimplexNoise2DDeriv (double x, double y, double& dx,
+  double& dy, int seed)
+{
+  return OpenSimplex2D (x, y, ArithmeticHash (seed), &dx, &dy);
+}
+
+double noise::OpenSimplexNoise2DDeriv (double x, double y, double& dx,
+  double& dy, const PermutationTable& table)
+{
+  return OpenSimplex2D (x, y, PermutationHash (table), &dx, &dy);
+}
+
+void noise::OpenSimplexNoise2DBatch (const double* x, const double* y,
+  double* out, size_t n, int seed)
+{
+  const simd::KernelTable* kernels = GetKernelTable ();
+  if (kernels != NULL) {
+    kernels->openSimplexNoise2D (x, y, out, n, seed);
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    out[i] = OpenSimplexNoise2D (x[i], y[i], seed);
+  }
+}
+
+void noise::OpenSimplexNoise2DBatch (const double* x, const double* y,
+  double* out, size_t n, const PermutationTable& table)
+{
+  PermutationHash hash (table);
+  for (size_t i = 0; i < n; i++) {
+    out[i] = OpenSimplex2D (x[i], y[i], hash);
+  }
 }
 
 double noise::ValueCoherentNoise2D (double x, double y, int seed,
@@ -185,21 +678,35 @@ double noise::ValueCoherentNoise2D (double x, double y, int seed,
   ix1  = LinearInterp (n0, n1, xs);
   return LinearInterp (ix0, ix1, ys);
 }
-#ifdef VALUE_NOISE_USE_XXHASH
-    #include <cstdint>
-#endif
+
+void noise::IntValueNoise2DBatch (const int* x, const int* y, int* out,
+  size_t n, int seed)
+{
+  const simd::KernelTable* kernels = GetKernelTable ();
+  if (kernels != NULL) {
+    kernels->intValueNoise2D (x, y, out, n, seed);
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    out[i] = IntValueNoise2D (x[i], y[i], seed);
+  }
+}
+
+void noise::ValueCoherentNoise2DBatch (const double* x, const double* y,
+  double* out, size_t n, int seed, NoiseQuality noiseQuality)
+{
+  const simd::KernelTable* kernels = GetKernelTable ();
+  if (kernels != NULL) {
+    kernels->valueCoherentNoise2D (x, y, out, n, seed, noiseQuality);
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    out[i] = ValueCoherentNoise2D (x[i], y[i], seed, noiseQuality);
+  }
+}
+
 double noise::ValueNoise2D (int x, int y, int seed)
 {
-    #ifdef VALUE_NOISE_USE_XXHASH
-        constexpr auto FACTOR = 2.0 / 4294967296.0;
-  
-        std::uint64_t pos = 0u;
-        pos = std::uint64_t(x) << 32 | std::uint32_t(y);
-        auto hash = XXH32(&pos, 8, seed);
-  
-        return 1.0 - (double(hash) * FACTOR);
-    #else
-        return 1.0 - ((double)IntValueNoise2D (x, y,seed) / 1073741824.0);
-    #endif
+  return ValueHash (x, y, seed);
 }
 
@@ -25,6 +25,7 @@
 #define NOISE_NOISEGEN_H
 
 #include <math.h>
+#include <stddef.h>
 #include "basictypes.h"
 
 namespace noise
@@ -60,8 +61,8 @@ namespace noise
 
   };
   
-  /// Enumerates the noise type, which is either value noise or gradient
-  /// noise.
+  /// Enumerates the noise type, which is gradient noise, value noise or
+  /// OpenSimplex noise.
   enum NoiseType
   {
 
@@ -75,8 +76,128 @@ namespace noise
     /// maximum amplitude can be calculated.
     TYPE_VALUE = 1,
 
+    /// Generates OpenSimplex noise (see OpenSimplexNoise2D()), which is
+    /// smoother and more isotropic than gradient noise.  Often one octave
+    /// less gives the same visual detail.  The noise quality has no effect
+    /// on OpenSimplex noise.
+    TYPE_OPENSIMPLEX = 2,
+
+  };
+
+  /// Enumerates the hash functions that map the integer coordinates of a
+  /// lattice point to its gradient vector or value.
+  enum HashType
+  {
+
+    /// Arithmetic hash of the coordinates and the seed, using a few integer
+    /// multiplications.  This is the hash of the original libnoise.
+    HASH_ARITHMETIC = 0,
+
+    /// Lookups in a permutation table that is built once per seed, as in
+    /// Ken Perlin's improved noise.  See noise::PermutationTable.
+    HASH_PERMUTATION = 1
+
   };
 
+  /// Enumerates the SIMD instruction sets used by the batch noise
+  /// functions.
+  enum SimdLevel
+  {
+
+    /// Plain scalar code.
+    SIMD_NONE = 0,
+
+    /// SSE2, two samples per instruction.
+    SIMD_SSE2 = 1,
+
+    /// AVX2, four samples per instruction.
+    SIMD_AVX2 = 2,
+
+    /// AVX-512, eight samples per instruction.
+    SIMD_AVX512 = 3
+
+  };
+
+  /// Permutation table of the lattice hash noise::HASH_PERMUTATION.
+  ///
+  /// The table holds a permutation of the numbers 0 to 255 that is derived
+  /// from a seed.  The hash of a lattice point is found by two dependent
+  /// table lookups instead of the integer multiplications of the arithmetic
+  /// hash.  Building a table takes some time, so it should be built once
+  /// per seed and passed to the noise functions.
+  ///
+  /// Lattice points whose coordinates differ by a multiple of 256 get the
+  /// same hash, so the noise repeats every 256 units.
+  class PermutationTable
+  {
+
+    public:
+
+      /// Constructor.
+      ///
+      /// @param seed The seed the permutation is derived from.
+      PermutationTable (int seed = 0);
+
+      /// Returns the seed the permutation is derived from.
+      ///
+      /// @returns The seed value.
+      int GetSeed () const
+      {
+        return m_seed;
+      }
+
+      /// Returns the hash of a lattice point.
+      ///
+      /// @param ix The integer @a x coordinate of the lattice point.
+      /// @param iy The integer @a y coordinate of the lattice point.
+      ///
+      /// @returns The hash, ranging from 0 to 255.
+      int Hash (int ix, int iy) const
+      {
+        return m_permutation[m_permutation[ix & 0xff] + (iy & 0xff)];
+      }
+
+      /// Rebuilds the permutation from a new seed.
+      ///
+      /// @param seed The seed the permutation is derived from.
+      void SetSeed (int seed);
+
+    private:
+
+      /// The seed the permutation is derived from.
+      int m_seed;
+
+      /// The permutation, stored twice so that the second lookup needs no
+      /// wrap-around.
+      uint8 m_permutation[512];
+
+  };
+
+  /// Returns the best SIMD instruction set supported by the CPU.
+  ///
+  /// @returns The supported SIMD level.
+  ///
+  /// The CPU is queried once at the first call.  If libnoise was built
+  /// without SIMD support (see the @a USE_SIMD build option), this function
+  /// returns noise::SIMD_NONE.
+  SimdLevel GetSupportedSimdLevel ();
+
+  /// Returns the SIMD instruction set used by the batch noise functions.
+  ///
+  /// @returns The SIMD level in use.
+  ///
+  /// This is the supported SIMD level, limited by SetSimdLevel().
+  SimdLevel GetSimdLevel ();
+
+  /// Limits the SIMD instruction set used by the batch noise functions.
+  ///
+  /// @param simdLevel The maximum SIMD level to use.
+  ///
+  /// By default, the best supported instruction set is used.  Limiting it
+  /// is useful for benchmarking or to compare the results of the different
+  /// code paths.  Levels beyond the supported level are ignored.
+  void SetSimdLevel (SimdLevel simdLevel);
+
   /// Generates a gradient-coherent-noise value from the coordinates of a
   /// two-dimensional input value.
   ///
@@ -94,6 +215,288 @@ namespace noise
   double GradientCoherentNoise2D (double x, double y, int seed = 0,
     NoiseQuality noiseQuality = QUALITY_STD);
 
+  /// Generates a gradient-coherent-noise value from the coordinates of a
+  /// two-dimensional input value, using the permutation-table hash.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param table The permutation table of the seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated gradient-coherent-noise value.
+  ///
+  /// The return value ranges from -1.0 to +1.0.
+  ///
+  /// This function uses the same gradient vectors as the arithmetic hash,
+  /// but selects them by noise::PermutationTable::Hash().
+  double GradientCoherentNoise2D (double x, double y,
+    const PermutationTable& table, NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates a gradient-coherent-noise value and its partial derivatives
+  /// from the coordinates of a two-dimensional input value.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param dx Receives the partial derivative with respect to @a x.
+  /// @param dy Receives the partial derivative with respect to @a y.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated gradient-coherent-noise value.
+  ///
+  /// The return value is bit-identical to GradientCoherentNoise2D().  The
+  /// derivatives are calculated analytically, using the derivatives of the
+  /// S-curves (see SCurve3Deriv() and SCurve5Deriv()), so a surface normal
+  /// or a slope costs one evaluation instead of three for finite
+  /// differences.
+  ///
+  /// With noise::QUALITY_FAST, the derivatives are discontinuous at the
+  /// integer boundaries.
+  double GradientCoherentNoise2DDeriv (double x, double y, double& dx,
+    double& dy, int seed = 0, NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates a gradient-coherent-noise value and its partial derivatives,
+  /// using the permutation-table hash.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param dx Receives the partial derivative with respect to @a x.
+  /// @param dy Receives the partial derivative with respect to @a y.
+  /// @param table The permutation table of the seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated gradient-coherent-noise value.
+  double GradientCoherentNoise2DDeriv (double x, double y, double& dx,
+    double& dy, const PermutationTable& table,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates gradient-coherent-noise values for a buffer of
+  /// two-dimensional input values.
+  ///
+  /// @param x The @a x coordinates of the input values.
+  /// @param y The @a y coordinates of the input values.
+  /// @param out The buffer receiving the generated values.
+  /// @param n The number of input values.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @pre The coordinates have been passed through MakeInt32Range().
+  ///
+  /// This function is equivalent to calling GradientCoherentNoise2D() for
+  /// each input value.  It processes several input values per instruction
+  /// using the SIMD instruction set given by GetSimdLevel().  Hashing, the
+  /// gradient lookup, the S-curves and the interpolation are evaluated in
+  /// the same order as in the scalar function, without fused
+  /// multiply-adds, so that the results are bit-identical to the scalar
+  /// path.  If the scalar path is compiled with floating-point contraction
+  /// or fast-math options, results may differ by a few units in the last
+  /// place (less than 1.0e-15.)
+  void GradientCoherentNoise2DBatch (const double* x, const double* y,
+    double* out, size_t n, int seed = 0,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates gradient-coherent-noise values for a buffer of
+  /// two-dimensional input values, using the permutation-table hash.
+  ///
+  /// @param x The @a x coordinates of the input values.
+  /// @param y The @a y coordinates of the input values.
+  /// @param out The buffer receiving the generated values.
+  /// @param n The number of input values.
+  /// @param table The permutation table of the seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @pre The coordinates have been passed through MakeInt32Range().
+  ///
+  /// This function is equivalent to calling GradientCoherentNoise2D() for
+  /// each input value.  There are no SIMD kernels for the
+  /// permutation-table hash.
+  void GradientCoherentNoise2DBatch (const double* x, const double* y,
+    double* out, size_t n, const PermutationTable& table,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates gradient-coherent-noise values for a buffer of
+  /// two-dimensional input values, with one seed per input value.
+  ///
+  /// @param x The @a x coordinates of the input values.
+  /// @param y The @a y coordinates of the input values.
+  /// @param seeds The random number seeds of the input values.
+  /// @param out The buffer receiving the generated values.
+  /// @param n The number of input values.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @pre The coordinates have been passed through MakeInt32Range().
+  ///
+  /// This function is equivalent to calling GradientCoherentNoise2D() for
+  /// each input value with its seed, and uses the SIMD instruction set
+  /// given by GetSimdLevel() like GradientCoherentNoise2DBatch().  It lets
+  /// the fractal noise modules evaluate the octaves of a single input value
+  /// in parallel, one octave per lane.
+  void GradientCoherentNoise2DSeeds (const double* x, const double* y,
+    const int* seeds, double* out, size_t n,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates two channels of gradient-coherent-noise values for a buffer of
+  /// two-dimensional input values, one channel per seed.
+  ///
+  /// @param x The @a x coordinates of the input values.
+  /// @param y The @a y coordinates of the input values.
+  /// @param out0 The buffer receiving the values of @a seed0.
+  /// @param out1 The buffer receiving the values of @a seed1.
+  /// @param n The number of input values.
+  /// @param seed0 The random number seed of the first channel.
+  /// @param seed1 The random number seed of the second channel.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @pre The coordinates have been passed through MakeInt32Range().
+  ///
+  /// This function is equivalent to calling GradientCoherentNoise2DBatch() once
+  /// per seed, and uses the SIMD instruction set given by GetSimdLevel().
+  /// Both channels share the lattice cells, the S-curves and the
+  /// distances to the lattice points, so vector-valued noise, such as the
+  /// displacement of noise::module::Turbulence, costs less than two calls.
+  void GradientCoherentNoise2DPair (const double* x, const double* y,
+    double* out0, double* out1, size_t n, int seed0, int seed1,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates gradient-coherent-noise values for a grid of
+  /// two-dimensional input values.
+  ///
+  /// @param x The @a x coordinates of the grid columns.
+  /// @param width The number of grid columns.
+  /// @param y The @a y coordinates of the grid rows.
+  /// @param height The number of grid rows.
+  /// @param out The buffer receiving the generated values.
+  /// @param stride The distance between two rows in @a out.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @pre The coordinates have been passed through MakeInt32Range().
+  ///
+  /// @pre @a stride is at least @a width.
+  ///
+  /// For each row @a j and each column @a i, this function stores
+  /// GradientCoherentNoise2D (x[i], y[j], seed, noiseQuality) in
+  /// out[j * stride + i].  The results are bit-identical.
+  ///
+  /// Neighbouring values of a raster usually fall into the same lattice
+  /// cell.  This function computes the gradient vector of each lattice
+  /// point only once per block of columns and reuses it for all values
+  /// in the adjacent cells.  The S-curve values of the columns are also
+  /// only computed once.
+  void GradientCoherentNoise2DGrid (const double* x, size_t width,
+    const double* y, size_t height, double* out, size_t stride,
+    int seed = 0, NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates gradient-coherent-noise values for a grid of
+  /// two-dimensional input values, using the permutation-table hash.
+  ///
+  /// @param x The @a x coordinates of the grid columns.
+  /// @param width The number of grid columns.
+  /// @param y The @a y coordinates of the grid rows.
+  /// @param height The number of grid rows.
+  /// @param out The buffer receiving the generated values.
+  /// @param stride The distance between two rows in @a out.
+  /// @param table The permutation table of the seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @pre The coordinates have been passed through MakeInt32Range().
+  ///
+  /// @pre @a stride is at least @a width.
+  ///
+  /// See the seed based GradientCoherentNoise2DGrid().
+  void GradientCoherentNoise2DGrid (const double* x, size_t width,
+    const double* y, size_t height, double* out, size_t stride,
+    const PermutationTable& table, NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates a periodic gradient-coherent-noise value from the
+  /// coordinates of a two-dimensional input value.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param periodX The period along the @a x axis, in lattice cells.
+  /// @param periodY The period along the @a y axis, in lattice cells.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated gradient-coherent-noise value.
+  ///
+  /// The return value ranges from -1.0 to +1.0.
+  ///
+  /// Same as GradientCoherentNoise2D(), except that the integer
+  /// coordinates of the lattice points are wrapped modulo the periods
+  /// before hashing.  The noise therefore repeats every @a periodX units
+  /// along the @a x axis and every @a periodY units along the @a y axis, so
+  /// a square of that size can be tiled without seams.  A period of 0 or
+  /// less disables the wrap along its axis.
+  double GradientCoherentNoise2DPeriodic (double x, double y, int periodX,
+    int periodY, int seed = 0, NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates a periodic gradient-coherent-noise value from the
+  /// coordinates of a two-dimensional input value, using the
+  /// permutation-table hash.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param periodX The period along the @a x axis, in lattice cells.
+  /// @param periodY The period along the @a y axis, in lattice cells.
+  /// @param table The permutation table of the seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated gradient-coherent-noise value.
+  double GradientCoherentNoise2DPeriodic (double x, double y, int periodX,
+    int periodY, const PermutationTable& table,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Number of fractional bits of the fixed-point coordinates and values
+  /// used by the fixed-point noise functions (Q16.16.)
+  const int FIXED_SHIFT = 16;
+
+  /// The value 1.0 in fixed point.
+  const int32 FIXED_ONE = 1 << FIXED_SHIFT;
+
+  /// Generates a gradient-coherent-noise value from the fixed-point
+  /// coordinates of a two-dimensional input value.
+  ///
+  /// @param x The @a x coordinate of the input value, in Q16.16.
+  /// @param y The @a y coordinate of the input value, in Q16.16.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated gradient-coherent-noise value, in Q16.16.
+  ///
+  /// The return value ranges from -FIXED_ONE to +FIXED_ONE.
+  ///
+  /// This is an integer-only version of GradientCoherentNoise2D().  It uses
+  /// the same lattice and hash, with the gradient vectors, the S-curves and
+  /// the interpolation rounded to 14 or 15 fractional bits, so the result
+  /// stays within about 2.0e-3 of GradientCoherentNoise2D (x / 65536.0,
+  /// y / 65536.0).  Since there is no floating-point arithmetic, the result
+  /// is bit-exact on every platform, compiler and optimisation level.
+  ///
+  /// The gradient of a lattice point only depends on the lower 16 bits of
+  /// its coordinates, so gradient noise repeats every 65536 units and stays
+  /// seamless when the coordinates wrap around the 32-bit range.
+  int32 GradientCoherentNoise2DFixed (int32 x, int32 y, int seed = 0,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates gradient-coherent-noise values for a buffer of fixed-point
+  /// two-dimensional input values.
+  ///
+  /// @param x The @a x coordinates of the input values, in Q16.16.
+  /// @param y The @a y coordinates of the input values, in Q16.16.
+  /// @param out The buffer receiving the generated values, in Q16.16.
+  /// @param n The number of input values.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// This function is equivalent to calling GradientCoherentNoise2DFixed()
+  /// for each input value, using the integer registers of the SIMD
+  /// instruction set given by GetSimdLevel().  The results are identical
+  /// to the scalar function.
+  void GradientCoherentNoise2DFixedBatch (const int32* x, const int32* y,
+    int32* out, size_t n, int seed = 0,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
   /// Generates a gradient-noise value from the coordinates of a
   /// two-dimensional input value and the integer coordinates of a
   /// nearby two-dimensional value.
@@ -148,6 +551,22 @@ namespace noise
   /// to it.
   int IntValueNoise2D (int x, int y, int seed = 0);
 
+  /// Generates integer-noise values for a buffer of two-dimensional
+  /// integer input values.
+  ///
+  /// @param x The integer @a x coordinates of the input values.
+  /// @param y The integer @a y coordinates of the input values.
+  /// @param out The buffer receiving the generated values.
+  /// @param n The number of input values.
+  /// @param seed A random number seed.
+  ///
+  /// This function is equivalent to calling IntValueNoise2D() for each
+  /// input value.  The hashes are computed for several input values at
+  /// once in the integer registers of the SIMD instruction set given by
+  /// GetSimdLevel().  The results are identical to the scalar function.
+  void IntValueNoise2DBatch (const int* x, const int* y, int* out, size_t n,
+    int seed = 0);
+
   /// Modifies a floating-point value so that it can be stored in a
   /// noise::int32 variable.
   ///
@@ -176,6 +595,135 @@ namespace noise
     }
   }
 
+  /// Generates an OpenSimplex-noise value from the coordinates of a
+  /// two-dimensional input value.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param seed The random number seed.
+  ///
+  /// @returns The generated OpenSimplex-noise value.
+  ///
+  /// The return value ranges from -1.0 to +1.0.
+  ///
+  /// This is the smooth variant of simplex noise known as OpenSimplex2S.
+  /// It uses the same lattice as SimplexNoise2D(), but each lattice point
+  /// contributes within a radius of the edge length of a triangle instead
+  /// of the height.  Besides the three corners of its triangle, each value
+  /// also depends on the opposite corners of the three adjacent triangles.
+  /// The result has no visible lattice directions and no discontinuities
+  /// in its second derivatives.
+  double OpenSimplexNoise2D (double x, double y, int seed = 0);
+
+  /// Generates an OpenSimplex-noise value from the coordinates of a
+  /// two-dimensional input value, using the permutation-table hash.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param table The permutation table of the seed.
+  ///
+  /// @returns The generated OpenSimplex-noise value.
+  double OpenSimplexNoise2D (double x, double y,
+    const PermutationTable& table);
+
+  /// Generates an OpenSimplex-noise value and its partial derivatives
+  /// from the coordinates of a two-dimensional input value.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param dx Receives the partial derivative with respect to @a x.
+  /// @param dy Receives the partial derivative with respect to @a y.
+  /// @param seed The random number seed.
+  ///
+  /// @returns The generated OpenSimplex-noise value, bit-identical to
+  /// OpenSimplexNoise2D().
+  double OpenSimplexNoise2DDeriv (double x, double y, double& dx,
+    double& dy, int seed = 0);
+
+  /// Generates an OpenSimplex-noise value and its partial derivatives,
+  /// using the permutation-table hash.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param dx Receives the partial derivative with respect to @a x.
+  /// @param dy Receives the partial derivative with respect to @a y.
+  /// @param table The permutation table of the seed.
+  ///
+  /// @returns The generated OpenSimplex-noise value.
+  double OpenSimplexNoise2DDeriv (double x, double y, double& dx,
+    double& dy, const PermutationTable& table);
+
+  /// Generates OpenSimplex-noise values for a buffer of two-dimensional
+  /// input values.
+  ///
+  /// @param x The @a x coordinates of the input values.
+  /// @param y The @a y coordinates of the input values.
+  /// @param out The buffer receiving the generated values.
+  /// @param n The number of input values.
+  /// @param seed The random number seed.
+  ///
+  /// @pre The coordinates have been passed through MakeInt32Range().
+  ///
+  /// This function is equivalent to calling OpenSimplexNoise2D() for each
+  /// input value, using the SIMD instruction set given by GetSimdLevel().
+  /// As for GradientCoherentNoise2DBatch(), the results are bit-identical
+  /// to the scalar function.
+  void OpenSimplexNoise2DBatch (const double* x, const double* y,
+    double* out, size_t n, int seed = 0);
+
+  /// Generates OpenSimplex-noise values for a buffer of two-dimensional
+  /// input values, using the permutation-table hash.
+  ///
+  /// @param x The @a x coordinates of the input values.
+  /// @param y The @a y coordinates of the input values.
+  /// @param out The buffer receiving the generated values.
+  /// @param n The number of input values.
+  /// @param table The permutation table of the seed.
+  ///
+  /// @pre The coordinates have been passed through MakeInt32Range().
+  ///
+  /// This function is equivalent to calling OpenSimplexNoise2D() for each
+  /// input value.  There are no SIMD kernels for the permutation-table
+  /// hash.
+  void OpenSimplexNoise2DBatch (const double* x, const double* y,
+    double* out, size_t n, const PermutationTable& table);
+
+  /// Generates a simplex-noise value from the coordinates of a
+  /// two-dimensional input value.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param seed The random number seed.
+  ///
+  /// @returns The generated simplex-noise value.
+  ///
+  /// The return value ranges from -1.0 to +1.0.
+  ///
+  /// Simplex noise splits the skewed integer lattice into triangles.  Each
+  /// value only depends on the three corners of its triangle and their
+  /// gradient vectors, which are chosen by the same hash as in
+  /// GradientNoise2D().  Unlike gradient-coherent noise, there are no
+  /// S-curves and fewer axis-aligned artifacts.
+  double SimplexNoise2D (double x, double y, int seed = 0);
+
+  /// Generates simplex-noise values for a buffer of two-dimensional input
+  /// values.
+  ///
+  /// @param x The @a x coordinates of the input values.
+  /// @param y The @a y coordinates of the input values.
+  /// @param out The buffer receiving the generated values.
+  /// @param n The number of input values.
+  /// @param seed The random number seed.
+  ///
+  /// @pre The coordinates have been passed through MakeInt32Range().
+  ///
+  /// This function is equivalent to calling SimplexNoise2D() for each
+  /// input value, using the SIMD instruction set given by GetSimdLevel().
+  /// As for GradientCoherentNoise2DBatch(), the results are bit-identical
+  /// to the scalar function.
+  void SimplexNoise2DBatch (const double* x, const double* y, double* out,
+    size_t n, int seed = 0);
+
   /// Generates a value-coherent-noise value from the coordinates of a
   /// two-dimensional input value.
   ///
@@ -193,6 +741,249 @@ namespace noise
   double ValueCoherentNoise2D (double x, double y, int seed = 0,
     NoiseQuality noiseQuality = QUALITY_STD);
 
+  /// Generates a value-coherent-noise value from the coordinates of a
+  /// two-dimensional input value, using the permutation-table hash.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param table The permutation table of the seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated value-coherent-noise value.
+  ///
+  /// The return value ranges from -1.0 to +1.0.
+  ///
+  /// The value of a lattice point is derived from its hash, so there are
+  /// only 256 different lattice values.
+  double ValueCoherentNoise2D (double x, double y,
+    const PermutationTable& table, NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates a value-coherent-noise value and its partial derivatives
+  /// from the coordinates of a two-dimensional input value.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param dx Receives the partial derivative with respect to @a x.
+  /// @param dy Receives the partial derivative with respect to @a y.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated value-coherent-noise value.
+  ///
+  /// The return value is bit-identical to ValueCoherentNoise2D().  See
+  /// GradientCoherentNoise2DDeriv() for the derivatives.
+  double ValueCoherentNoise2DDeriv (double x, double y, double& dx,
+    double& dy, int seed = 0, NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates a value-coherent-noise value and its partial derivatives,
+  /// using the permutation-table hash.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param dx Receives the partial derivative with respect to @a x.
+  /// @param dy Receives the partial derivative with respect to @a y.
+  /// @param table The permutation table of the seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated value-coherent-noise value.
+  double ValueCoherentNoise2DDeriv (double x, double y, double& dx,
+    double& dy, const PermutationTable& table,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates value-coherent-noise values for a buffer of
+  /// two-dimensional input values.
+  ///
+  /// @param x The @a x coordinates of the input values.
+  /// @param y The @a y coordinates of the input values.
+  /// @param out The buffer receiving the generated values.
+  /// @param n The number of input values.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @pre The coordinates have been passed through MakeInt32Range().
+  ///
+  /// This function is equivalent to calling ValueCoherentNoise2D() for
+  /// each input value.  The corner hashes of several input values are
+  /// computed at once in the integer registers of the SIMD instruction set
+  /// given by GetSimdLevel().  As for GradientCoherentNoise2DBatch(), the
+  /// results are bit-identical to the scalar function.
+  void ValueCoherentNoise2DBatch (const double* x, const double* y,
+    double* out, size_t n, int seed = 0,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates value-coherent-noise values for a buffer of
+  /// two-dimensional input values, using the permutation-table hash.
+  ///
+  /// @param x The @a x coordinates of the input values.
+  /// @param y The @a y coordinates of the input values.
+  /// @param out The buffer receiving the generated values.
+  /// @param n The number of input values.
+  /// @param table The permutation table of the seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @pre The coordinates have been passed through MakeInt32Range().
+  ///
+  /// This function is equivalent to calling ValueCoherentNoise2D() for
+  /// each input value.
+  void ValueCoherentNoise2DBatch (const double* x, const double* y,
+    double* out, size_t n, const PermutationTable& table,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates value-coherent-noise values for a buffer of
+  /// two-dimensional input values, with one seed per input value.
+  ///
+  /// @param x The @a x coordinates of the input values.
+  /// @param y The @a y coordinates of the input values.
+  /// @param seeds The random number seeds of the input values.
+  /// @param out The buffer receiving the generated values.
+  /// @param n The number of input values.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @pre The coordinates have been passed through MakeInt32Range().
+  ///
+  /// This function is equivalent to calling ValueCoherentNoise2D() for
+  /// each input value with its seed, and uses the SIMD instruction set
+  /// given by GetSimdLevel() like ValueCoherentNoise2DBatch().  It lets
+  /// the fractal noise modules evaluate the octaves of a single input value
+  /// in parallel, one octave per lane.
+  void ValueCoherentNoise2DSeeds (const double* x, const double* y,
+    const int* seeds, double* out, size_t n,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates two channels of value-coherent-noise values for a buffer of
+  /// two-dimensional input values, one channel per seed.
+  ///
+  /// @param x The @a x coordinates of the input values.
+  /// @param y The @a y coordinates of the input values.
+  /// @param out0 The buffer receiving the values of @a seed0.
+  /// @param out1 The buffer receiving the values of @a seed1.
+  /// @param n The number of input values.
+  /// @param seed0 The random number seed of the first channel.
+  /// @param seed1 The random number seed of the second channel.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @pre The coordinates have been passed through MakeInt32Range().
+  ///
+  /// This function is equivalent to calling ValueCoherentNoise2DBatch() once
+  /// per seed, and uses the SIMD instruction set given by GetSimdLevel().
+  /// Both channels share the lattice cells, the S-curves and the
+  /// distances to the lattice points, so vector-valued noise, such as the
+  /// displacement of noise::module::Turbulence, costs less than two calls.
+  void ValueCoherentNoise2DPair (const double* x, const double* y,
+    double* out0, double* out1, size_t n, int seed0, int seed1,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates value-coherent-noise values for a grid of
+  /// two-dimensional input values.
+  ///
+  /// @param x The @a x coordinates of the grid columns.
+  /// @param width The number of grid columns.
+  /// @param y The @a y coordinates of the grid rows.
+  /// @param height The number of grid rows.
+  /// @param out The buffer receiving the generated values.
+  /// @param stride The distance between two rows in @a out.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @pre The coordinates have been passed through MakeInt32Range().
+  ///
+  /// @pre @a stride is at least @a width.
+  ///
+  /// This is the value-noise counterpart of GradientCoherentNoise2DGrid().
+  /// The noise value of each lattice point is computed once and reused for
+  /// all values in the adjacent cells.
+  void ValueCoherentNoise2DGrid (const double* x, size_t width,
+    const double* y, size_t height, double* out, size_t stride,
+    int seed = 0, NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates value-coherent-noise values for a grid of
+  /// two-dimensional input values, using the permutation-table hash.
+  ///
+  /// @param x The @a x coordinates of the grid columns.
+  /// @param width The number of grid columns.
+  /// @param y The @a y coordinates of the grid rows.
+  /// @param height The number of grid rows.
+  /// @param out The buffer receiving the generated values.
+  /// @param stride The distance between two rows in @a out.
+  /// @param table The permutation table of the seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @pre The coordinates have been passed through MakeInt32Range().
+  ///
+  /// @pre @a stride is at least @a width.
+  ///
+  /// See the seed based ValueCoherentNoise2DGrid().
+  void ValueCoherentNoise2DGrid (const double* x, size_t width,
+    const double* y, size_t height, double* out, size_t stride,
+    const PermutationTable& table, NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates a periodic value-coherent-noise value from the coordinates
+  /// of a two-dimensional input value.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param periodX The period along the @a x axis, in lattice cells.
+  /// @param periodY The period along the @a y axis, in lattice cells.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated value-coherent-noise value.
+  ///
+  /// The return value ranges from -1.0 to +1.0.
+  ///
+  /// See GradientCoherentNoise2DPeriodic().
+  double ValueCoherentNoise2DPeriodic (double x, double y, int periodX,
+    int periodY, int seed = 0, NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates a periodic value-coherent-noise value from the coordinates
+  /// of a two-dimensional input value, using the permutation-table hash.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param periodX The period along the @a x axis, in lattice cells.
+  /// @param periodY The period along the @a y axis, in lattice cells.
+  /// @param table The permutation table of the seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated value-coherent-noise value.
+  double ValueCoherentNoise2DPeriodic (double x, double y, int periodX,
+    int periodY, const PermutationTable& table,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates a value-coherent-noise value from the fixed-point
+  /// coordinates of a two-dimensional input value.
+  ///
+  /// @param x The @a x coordinate of the input value, in Q16.16.
+  /// @param y The @a y coordinate of the input value, in Q16.16.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated value-coherent-noise value, in Q16.16.
+  ///
+  /// The return value ranges from -FIXED_ONE to +FIXED_ONE.
+  ///
+  /// This is an integer-only version of ValueCoherentNoise2D(), see
+  /// GradientCoherentNoise2DFixed() for the precision.  Unlike gradient
+  /// noise, value noise does not repeat every 65536 units.
+  int32 ValueCoherentNoise2DFixed (int32 x, int32 y, int seed = 0,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates value-coherent-noise values for a buffer of fixed-point
+  /// two-dimensional input values.
+  ///
+  /// @param x The @a x coordinates of the input values, in Q16.16.
+  /// @param y The @a y coordinates of the input values, in Q16.16.
+  /// @param out The buffer receiving the generated values, in Q16.16.
+  /// @param n The number of input values.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// This function is equivalent to calling ValueCoherentNoise2DFixed()
+  /// for each input value, see GradientCoherentNoise2DFixedBatch().
+  void ValueCoherentNoise2DFixedBatch (const int32* x, const int32* y,
+    int32* out, size_t n, int seed = 0,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
   /// Generates a value-noise value from the coordinates of a
   /// two-dimensional input value.
   ///
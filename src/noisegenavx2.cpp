@@ -0,0 +1,153 @@
+// noisegenavx2.cpp
+//
+// Copyright (C) 2026 libnoise2d contributors
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "noisegenimpl.h"
+
+#ifdef NOISE_USE_SIMD
+
+#include <immintrin.h>
+
+namespace
+{
+
+  // AVX2 wrapper for the kernels in noisegenkernels.h.  Four doubles per
+  // register, the matching four 32-bit integers fit into an SSE register.
+  struct Avx2
+  {
+    enum { WIDTH = 4 };
+
+    typedef __m256d Real;
+    typedef __m128i Int;
+
+    static Real Load (const double* p) { return _mm256_loadu_pd (p); }
+    static void Store (double* p, Real a) { _mm256_storeu_pd (p, a); }
+    static Real Set (double a) { return _mm256_set1_pd (a); }
+    static Real Add (Real a, Real b) { return _mm256_add_pd (a, b); }
+    static Real Sub (Real a, Real b) { return _mm256_sub_pd (a, b); }
+    static Real Mul (Real a, Real b) { return _mm256_mul_pd (a, b); }
+    static Real Max (Real a, Real b) { return _mm256_max_pd (a, b); }
+    static Real IsGreater (Real a, Real b)
+    {
+      return _mm256_and_pd (_mm256_cmp_pd (a, b, _CMP_GT_OQ),
+        _mm256_set1_pd (1.0));
+    }
+
+    static Int LoadInt (const int* p)
+    {
+      return _mm_loadu_si128 ((const __m128i*)p);
+    }
+    static void StoreInt (int* p, Int a) { _mm_storeu_si128 ((__m128i*)p, a); }
+    static Int SetInt (int a) { return _mm_set1_epi32 (a); }
+    static Int AddInt (Int a, Int b) { return _mm_add_epi32 (a, b); }
+    static Int MulInt (Int a, Int b) { return _mm_mullo_epi32 (a, b); }
+    static Int XorInt (Int a, Int b) { return _mm_xor_si128 (a, b); }
+    static Int AndInt (Int a, Int b) { return _mm_and_si128 (a, b); }
+    static Int OrInt (Int a, Int b) { return _mm_or_si128 (a, b); }
+    template <int S> static Int ShiftRightInt (Int a)
+    {
+      return _mm_srai_epi32 (a, S);
+    }
+    template <int S> static Int ShiftRightLogicalInt (Int a)
+    {
+      return _mm_srli_epi32 (a, S);
+    }
+    template <int S> static Int ShiftLeftInt (Int a)
+    {
+      return _mm_slli_epi32 (a, S);
+    }
+
+    static Real ToReal (Int a) { return _mm256_cvtepi32_pd (a); }
+    static Int ToInt (Real a) { return _mm256_cvttpd_epi32 (a); }
+
+    static Int CellIndex (Real x)
+    {
+      Real notPositive = _mm256_cmp_pd (x, _mm256_setzero_pd (), _CMP_NGT_UQ);
+      Real truncated = _mm256_cvtepi32_pd (_mm256_cvttpd_epi32 (x));
+      return _mm256_cvttpd_epi32 (_mm256_sub_pd (truncated,
+        _mm256_and_pd (notPositive, _mm256_set1_pd (1.0))));
+    }
+
+    static Real Gather (const double* base, Int index)
+    {
+      return _mm256_i32gather_pd (base, index, 8);
+    }
+  };
+
+  // AVX2 wrapper for the fixed-point kernels, eight 32-bit integers per
+  // register.
+  struct Avx2Int
+  {
+    enum { WIDTH = 8 };
+
+    typedef __m256i Int;
+
+    static Int LoadInt (const int* p)
+    {
+      return _mm256_loadu_si256 ((const __m256i*)p);
+    }
+    static void StoreInt (int* p, Int a)
+    {
+      _mm256_storeu_si256 ((__m256i*)p, a);
+    }
+    static Int SetInt (int a) { return _mm256_set1_epi32 (a); }
+    static Int AddInt (Int a, Int b) { return _mm256_add_epi32 (a, b); }
+    static Int SubInt (Int a, Int b) { return _mm256_sub_epi32 (a, b); }
+    static Int MulInt (Int a, Int b) { return _mm256_mullo_epi32 (a, b); }
+    static Int XorInt (Int a, Int b) { return _mm256_xor_si256 (a, b); }
+    static Int AndInt (Int a, Int b) { return _mm256_and_si256 (a, b); }
+    static Int OrInt (Int a, Int b) { return _mm256_or_si256 (a, b); }
+    template <int S> static Int ShiftRightInt (Int a)
+    {
+      return _mm256_srai_epi32 (a, S);
+    }
+    template <int S> static Int ShiftRightLogicalInt (Int a)
+    {
+      return _mm256_srli_epi32 (a, S);
+    }
+    template <int S> static Int ShiftLeftInt (Int a)
+    {
+      return _mm256_slli_epi32 (a, S);
+    }
+
+    static Int GatherInt (const int* base, Int index)
+    {
+      return _mm256_i32gather_epi32 (base, index, 4);
+    }
+  };
+
+}
+
+#include "noisegenkernels.h"
+
+const noise::simd::KernelTable noise::simd::AVX2_KERNELS =
+{
+  GradientCoherentNoise2DKernel<Avx2>,
+  ValueCoherentNoise2DKernel<Avx2>,
+  IntValueNoise2DKernel<Avx2>,
+  SimplexNoise2DKernel<Avx2>,
+  OpenSimplexNoise2DKernel<Avx2>,
+  GradientCoherentNoise2DFixedKernel<Avx2Int>,
+  ValueCoherentNoise2DFixedKernel<Avx2Int>,
+  GradientCoherentNoise2DSeedsKernel<Avx2>,
+  ValueCoherentNoise2DSeedsKernel<Avx2>,
+  GradientCoherentNoise2DPairKernel<Avx2>,
+  ValueCoherentNoise2DPairKernel<Avx2>
+};
+
+#endif
@@ -0,0 +1,185 @@
+// noisegenimpl.h
+//
+// Copyright (C) 2026 libnoise2d contributors
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#ifndef NOISE_NOISEGENIMPL_H
+#define NOISE_NOISEGENIMPL_H
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+#include <cmath>
+#include "noisegen.h"
+
+// Internal header, not installed.  Shared by noisegen.cpp and the SIMD
+// kernels, which live in their own translation units (noisegensse2.cpp,
+// noisegenavx2.cpp, noisegenavx512.cpp) compiled with the matching compiler
+// flags.  The SIMD kernels are only called by noisegen.cpp after checking
+// the CPU at runtime.
+
+// Specifies the version of the coherent-noise functions to use.
+// - Set to 2 to use the current version.
+// - Set to 1 to use the flawed version from the original version of libnoise.
+// If your application requires coherent-noise values that were generated by
+// an earlier version of libnoise, change this constant to the appropriate
+// value and recompile libnoise.
+#define NOISE_VERSION 2
+
+namespace noise
+{
+
+  // These constants control certain parameters that all coherent-noise
+  // functions require.
+#if (NOISE_VERSION == 1)
+  // Constants used by the original version of libnoise.
+  // Because X_NOISE_GEN is not relatively prime to the other values, and
+  // Z_NOISE_GEN is close to 256 (the number of random gradient vectors),
+  // patterns show up in high-frequency coherent noise.
+  const int X_NOISE_GEN = 1;
+  const int Y_NOISE_GEN = 31337;
+  const int SEED_NOISE_GEN = 1013;
+  const int SHIFT_NOISE_GEN = 13;
+#else
+  // Constants used by the current version of libnoise.
+  const int X_NOISE_GEN = 1619;
+  const int Y_NOISE_GEN = 31337;
+  const int SEED_NOISE_GEN = 1013;
+  const int SHIFT_NOISE_GEN = 8;
+#endif
+
+  // Scales gradient noise to the range -1.0 to +1.0.
+  const double SQRT1_2 = 1.0 / std::sqrt(2.0);
+
+  // Skews the input space onto the simplex lattice and back, (sqrt(3) - 1)
+  // / 2 and (3 - sqrt(3)) / 6.
+  const double SIMPLEX_SKEW   = 0.36602540378443864676;
+  const double SIMPLEX_UNSKEW = 0.21132486540518711775;
+
+  // Scales simplex noise to the range -1.0 to +1.0.  With unit-length
+  // gradient vectors, the sum of the corners stays just below 0.0101.
+  const double SIMPLEX_SCALE = 99.0;
+
+  // Squared radius within which a lattice point contributes to simplex
+  // noise.  Simplex noise uses the height of a triangle, 0.5, and
+  // OpenSimplex noise the edge length, 2/3.
+  const double SIMPLEX_RADIUS2 = 0.5;
+  const double OPENSIMPLEX_RADIUS2 = 0.66666666666666666667;
+
+  // Scales OpenSimplex noise to the range -1.0 to +1.0.  With unit-length
+  // gradient vectors, the sum of the lattice points stays just below
+  // 0.0552.
+  const double OPENSIMPLEX_SCALE = 18.0;
+
+  // Offsets of the lattice points that contribute to OpenSimplex noise,
+  // relative to the first corner of a lower triangle (below the diagonal):
+  // the three corners, then the opposite corners of the three adjacent
+  // triangles.  For an upper triangle, the offsets are mirrored at the
+  // diagonal.
+  const int OPENSIMPLEX_POINTS = 6;
+  const int OPENSIMPLEX_OFFSET_X[OPENSIMPLEX_POINTS] = {0, 1, 1,  0, 2, 0};
+  const int OPENSIMPLEX_OFFSET_Y[OPENSIMPLEX_POINTS] = {0, 0, 1, -1, 1, 1};
+
+  // Scales fixed-point gradient noise to the range -1.0 to +1.0, SQRT1_2
+  // with 15 fractional bits.
+  const int32 FIXED_SQRT1_2 = 23170;
+
+  // Defined in vectortable.h, which may only be included once.
+  extern double g_randomVectors[256 * 2];
+  extern int g_randomVectorsFixed[256 * 2];
+
+#ifdef VALUE_NOISE_USE_XXHASH
+  // Constants of the xxHash32 algorithm (3rdParty/xxhash).
+  const uint32 XXH_PRIME32_2 = 2246822519U;
+  const uint32 XXH_PRIME32_3 = 3266489917U;
+  const uint32 XXH_PRIME32_4 =  668265263U;
+  const uint32 XXH_PRIME32_5 =  374761393U;
+
+  // Computes XXH32 (&pos, 8, seed) of the lattice position
+  // pos = ((uint64)x << 32) | (uint32)y, without the length dispatch and
+  // byte handling of the general function.  xxHash reads the buffer as
+  // little-endian 32-bit words, so on little-endian platforms the first
+  // word is @a y and the second word is @a x.
+  inline uint32 XxHash32Lattice (int x, int y, int seed)
+  {
+    uint32 h32 = (uint32)seed + XXH_PRIME32_5 + 8;
+    h32 += (uint32)y * XXH_PRIME32_3;
+    h32  = ((h32 << 17) | (h32 >> 15)) * XXH_PRIME32_4;
+    h32 += (uint32)x * XXH_PRIME32_3;
+    h32  = ((h32 << 17) | (h32 >> 15)) * XXH_PRIME32_4;
+
+    h32 ^= h32 >> 15;
+    h32 *= XXH_PRIME32_2;
+    h32 ^= h32 >> 13;
+    h32 *= XXH_PRIME32_3;
+    h32 ^= h32 >> 16;
+    return h32;
+  }
+#endif
+
+  namespace simd
+  {
+
+    // The batch noise kernels of one SIMD instruction set.
+    struct KernelTable
+    {
+      void (*gradientCoherentNoise2D) (const double* x, const double* y,
+        double* out, size_t n, int seed, NoiseQuality noiseQuality);
+
+      void (*valueCoherentNoise2D) (const double* x, const double* y,
+        double* out, size_t n, int seed, NoiseQuality noiseQuality);
+
+      void (*intValueNoise2D) (const int* x, const int* y, int* out,
+        size_t n, int seed);
+
+      void (*simplexNoise2D) (const double* x, const double* y, double* out,
+        size_t n, int seed);
+
+      void (*openSimplexNoise2D) (const double* x, const double* y,
+        double* out, size_t n, int seed);
+
+      void (*gradientCoherentNoise2DFixed) (const int32* x, const int32* y,
+        int32* out, size_t n, int seed, NoiseQuality noiseQuality);
+
+      void (*valueCoherentNoise2DFixed) (const int32* x, const int32* y,
+        int32* out, size_t n, int seed, NoiseQuality noiseQuality);
+
+      void (*gradientCoherentNoise2DSeeds) (const double* x, const double* y,
+        const int* seeds, double* out, size_t n, NoiseQuality noiseQuality);
+
+      void (*valueCoherentNoise2DSeeds) (const double* x, const double* y,
+        const int* seeds, double* out, size_t n, NoiseQuality noiseQuality);
+
+      void (*gradientCoherentNoise2DPair) (const double* x, const double* y,
+        double* out0, double* out1, size_t n, int seed0, int seed1,
+        NoiseQuality noiseQuality);
+
+      void (*valueCoherentNoise2DPair) (const double* x, const double* y,
+        double* out0, double* out1, size_t n, int seed0, int seed1,
+        NoiseQuality noiseQuality);
+    };
+
+    extern const KernelTable SSE2_KERNELS;
+    extern const KernelTable AVX2_KERNELS;
+    extern const KernelTable AVX512_KERNELS;
+
+  }
+
+}
+
+#endif
+
+#endif
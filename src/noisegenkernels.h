@@ -0,0 +1,826 @@
+// noisegenkernels.h
+//
+// Copyright (C) 2026 libnoise2d contributors
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#ifndef NOISE_NOISEGENKERNELS_H
+#define NOISE_NOISEGENKERNELS_H
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+#include "noisegenimpl.h"
+
+// Internal header, not installed.  Generic SIMD kernels of the coherent-noise
+// functions.  They are written against an instruction set wrapper that is
+// passed as template parameter @a Isa and must provide:
+//
+// - Isa::WIDTH: The number of doubles per register.
+// - Isa::Real, Isa::Int: Registers of WIDTH doubles and WIDTH 32-bit ints.
+// - Load, Store, Set, Add, Sub, Mul: Double arithmetic.
+// - Max: Returns (a > b? a: b) per lane.
+// - IsGreater: Returns 1.0 where a > b, else 0.0.
+// - LoadInt, StoreInt: Load and store WIDTH 32-bit integers.
+// - SetInt, AddInt, MulInt, XorInt, AndInt, OrInt, ShiftRightInt,
+//   ShiftRightLogicalInt, ShiftLeftInt: 32-bit integer arithmetic, wrapping
+//   on overflow.  ShiftRightInt is an arithmetic shift.
+// - ToReal: Converts integers to doubles.
+// - ToInt: Converts doubles to integers, truncating.
+// - CellIndex: Returns (x > 0.0? (int)x: (int)x - 1), the integer
+//   coordinate of the lattice cell used by the scalar functions.
+// - Gather: Loads base[index] for each lane.
+//
+// The fixed-point kernels only use integer registers.  They are instantiated
+// with a separate wrapper whose WIDTH is the number of 32-bit integers per
+// register, and which provides the integer operations above, SubInt and
+// GatherInt, the integer counterpart of Gather.
+//
+// This header may only be included by the translation units implementing
+// an instruction set, after the wrapper has been defined.  Everything is
+// kept in an anonymous namespace, so that the kernels compiled for
+// different instruction sets never get merged by the linker.
+//
+// Each operation mirrors the scalar code in noisegen.cpp and
+// noisegenscalar.h one by one and no fused multiply-adds are used, so the
+// results are bit-identical.
+
+namespace
+{
+
+  using namespace noise;
+
+  template <class Isa, NoiseQuality Q>
+  inline typename Isa::Real SCurve (typename Isa::Real a)
+  {
+    switch (Q) {
+      case QUALITY_FAST:
+        return a;
+      case QUALITY_STD:
+        // a * a * (3.0 - 2.0 * a)
+        return Isa::Mul (Isa::Mul (a, a),
+          Isa::Sub (Isa::Set (3.0), Isa::Mul (Isa::Set (2.0), a)));
+      case QUALITY_BEST:
+      default:
+      {
+        // (6.0 * a5) - (15.0 * a4) + (10.0 * a3)
+        typename Isa::Real a3 = Isa::Mul (Isa::Mul (a, a), a);
+        typename Isa::Real a4 = Isa::Mul (a3, a);
+        typename Isa::Real a5 = Isa::Mul (a4, a);
+        return Isa::Add (Isa::Sub (Isa::Mul (Isa::Set (6.0), a5),
+          Isa::Mul (Isa::Set (15.0), a4)), Isa::Mul (Isa::Set (10.0), a3));
+      }
+    }
+  }
+
+  template <class Isa>
+  inline typename Isa::Real LinearInterp (typename Isa::Real n0,
+    typename Isa::Real n1, typename Isa::Real a)
+  {
+    // ((1.0 - a) * n0) + (a * n1)
+    return Isa::Add (Isa::Mul (Isa::Sub (Isa::Set (1.0), a), n0),
+      Isa::Mul (a, n1));
+  }
+
+  // Lattice corner policies for CoherentNoise2DLoop.  Corner() returns the
+  // noise value at the integer coordinates (@a ix, @a iy); @a seedTerm is
+  // the seed dependent part of the hash, computed once by SeedTerm(), or per
+  // lane by SeedTerms().
+  // Scalar() is used for the remaining values that do not fill a whole
+  // register.
+
+  // Returns the index of the gradient vector of the integer coordinates
+  // (@a ix, @a iy) in g_randomVectors; @a seedTerm is SEED_NOISE_GEN * seed.
+  template <class Isa>
+  inline typename Isa::Int GradientIndex (typename Isa::Int ix,
+    typename Isa::Int iy, typename Isa::Int seedTerm)
+  {
+    typename Isa::Int vectorIndex = Isa::AddInt (Isa::AddInt (
+      Isa::MulInt (Isa::SetInt (X_NOISE_GEN), ix),
+      Isa::MulInt (Isa::SetInt (Y_NOISE_GEN), iy)),
+      seedTerm);
+    vectorIndex = Isa::XorInt (vectorIndex,
+      Isa::template ShiftRightInt<SHIFT_NOISE_GEN> (vectorIndex));
+    vectorIndex = Isa::AndInt (vectorIndex, Isa::SetInt (0xff));
+    return Isa::template ShiftLeftInt<1> (vectorIndex);
+  }
+
+  // See noise::GradientNoise2D().
+  template <class Isa>
+  struct GradientCorner
+  {
+    static typename Isa::Int SeedTerm (int seed)
+    {
+      return Isa::SetInt (SEED_NOISE_GEN * seed);
+    }
+
+    static typename Isa::Int SeedTerms (typename Isa::Int seeds)
+    {
+      return Isa::MulInt (Isa::SetInt (SEED_NOISE_GEN), seeds);
+    }
+
+    static typename Isa::Real Corner (typename Isa::Real fx,
+      typename Isa::Real fy, typename Isa::Int ix, typename Isa::Int iy,
+      typename Isa::Int seedTerm)
+    {
+      typename Isa::Int vectorIndex = GradientIndex<Isa> (ix, iy, seedTerm);
+      typename Isa::Real xvGradient = Isa::Gather (g_randomVectors,
+        vectorIndex);
+      typename Isa::Real yvGradient = Isa::Gather (g_randomVectors + 1,
+        vectorIndex);
+
+      typename Isa::Real xvPoint = Isa::Sub (fx, Isa::ToReal (ix));
+      typename Isa::Real yvPoint = Isa::Sub (fy, Isa::ToReal (iy));
+
+      return Isa::Mul (Isa::Add (Isa::Mul (xvGradient, xvPoint),
+        Isa::Mul (yvGradient, yvPoint)), Isa::Set (SQRT1_2));
+    }
+
+    static double Scalar (double x, double y, int seed,
+      NoiseQuality noiseQuality)
+    {
+      return GradientCoherentNoise2D (x, y, seed, noiseQuality);
+    }
+  };
+
+  // See noise::IntValueNoise2D().
+  template <class Isa>
+  inline typename Isa::Int IntValueNoise (typename Isa::Int x,
+    typename Isa::Int y, typename Isa::Int seedTerm)
+  {
+    typename Isa::Int mask = Isa::SetInt (0x7fffffff);
+    typename Isa::Int n = Isa::AndInt (Isa::AddInt (Isa::AddInt (
+      Isa::MulInt (Isa::SetInt (X_NOISE_GEN), x),
+      Isa::MulInt (Isa::SetInt (Y_NOISE_GEN), y)),
+      seedTerm), mask);
+    n = Isa::XorInt (Isa::template ShiftRightInt<13> (n), n);
+    typename Isa::Int t = Isa::AddInt (Isa::MulInt (Isa::MulInt (n, n),
+      Isa::SetInt (60493)), Isa::SetInt (19990303));
+    return Isa::AndInt (Isa::AddInt (Isa::MulInt (n, t),
+      Isa::SetInt (1376312589)), mask);
+  }
+
+#ifdef VALUE_NOISE_USE_XXHASH
+  template <class Isa>
+  inline typename Isa::Int XxHash32Round (typename Isa::Int h32,
+    typename Isa::Int input)
+  {
+    h32 = Isa::AddInt (h32, Isa::MulInt (input,
+      Isa::SetInt ((int)XXH_PRIME32_3)));
+    h32 = Isa::OrInt (Isa::template ShiftLeftInt<17> (h32),
+      Isa::template ShiftRightLogicalInt<15> (h32));
+    return Isa::MulInt (h32, Isa::SetInt ((int)XXH_PRIME32_4));
+  }
+
+  // See noise::XxHash32Lattice().  Hashes one lattice point per lane.
+  template <class Isa>
+  inline typename Isa::Int XxHash32 (typename Isa::Int x,
+    typename Isa::Int y, typename Isa::Int seedTerm)
+  {
+    typename Isa::Int h32 = XxHash32Round<Isa> (seedTerm, y);
+    h32 = XxHash32Round<Isa> (h32, x);
+
+    h32 = Isa::XorInt (h32, Isa::template ShiftRightLogicalInt<15> (h32));
+    h32 = Isa::MulInt (h32, Isa::SetInt ((int)XXH_PRIME32_2));
+    h32 = Isa::XorInt (h32, Isa::template ShiftRightLogicalInt<13> (h32));
+    h32 = Isa::MulInt (h32, Isa::SetInt ((int)XXH_PRIME32_3));
+    return Isa::XorInt (h32, Isa::template ShiftRightLogicalInt<16> (h32));
+  }
+#endif
+
+  // See noise::ValueNoise2D().  With VALUE_NOISE_USE_XXHASH, @a seedTerm is
+  // seed + XXH_PRIME32_5 + 8 instead, the start value of the hash.
+  template <class Isa>
+  struct ValueCorner
+  {
+    static typename Isa::Int SeedTerm (int seed)
+    {
+#ifdef VALUE_NOISE_USE_XXHASH
+      return Isa::SetInt ((int)((uint32)seed + XXH_PRIME32_5 + 8));
+#else
+      return Isa::SetInt (SEED_NOISE_GEN * seed);
+#endif
+    }
+
+    static typename Isa::Int SeedTerms (typename Isa::Int seeds)
+    {
+#ifdef VALUE_NOISE_USE_XXHASH
+      return Isa::AddInt (seeds, Isa::SetInt ((int)(XXH_PRIME32_5 + 8)));
+#else
+      return Isa::MulInt (Isa::SetInt (SEED_NOISE_GEN), seeds);
+#endif
+    }
+
+    static typename Isa::Real Corner (typename Isa::Real fx,
+      typename Isa::Real fy, typename Isa::Int ix, typename Isa::Int iy,
+      typename Isa::Int seedTerm)
+    {
+#ifdef VALUE_NOISE_USE_XXHASH
+      // Convert the unsigned hash by flipping the sign bit and adding 2^31
+      // back, which is exact.
+      typename Isa::Int hash = XxHash32<Isa> (ix, iy, seedTerm);
+      typename Isa::Real value = Isa::Add (Isa::ToReal (Isa::XorInt (hash,
+        Isa::SetInt ((int)0x80000000))), Isa::Set (2147483648.0));
+      return Isa::Sub (Isa::Set (1.0), Isa::Mul (value,
+        Isa::Set (2.0 / 4294967296.0)));
+#else
+      // Dividing by 2^30 is exact, so is multiplying by its inverse.
+      return Isa::Sub (Isa::Set (1.0), Isa::Mul (
+        Isa::ToReal (IntValueNoise<Isa> (ix, iy, seedTerm)),
+        Isa::Set (1.0 / 1073741824.0)));
+#endif
+    }
+
+    static double Scalar (double x, double y, int seed,
+      NoiseQuality noiseQuality)
+    {
+      return ValueCoherentNoise2D (x, y, seed, noiseQuality);
+    }
+  };
+
+  // See noise::GradientCoherentNoise2D() and noise::ValueCoherentNoise2D().
+  template <class Isa, class Lattice, NoiseQuality Q>
+  void CoherentNoise2DLoop (const double* x, const double* y,
+    double* out, size_t n, int seed)
+  {
+    typename Isa::Int one = Isa::SetInt (1);
+    typename Isa::Int seedTerm = Lattice::SeedTerm (seed);
+
+    size_t i = 0;
+    for (; i + Isa::WIDTH <= n; i += Isa::WIDTH) {
+      typename Isa::Real fx = Isa::Load (x + i);
+      typename Isa::Real fy = Isa::Load (y + i);
+
+      typename Isa::Int x0 = Isa::CellIndex (fx);
+      typename Isa::Int x1 = Isa::AddInt (x0, one);
+      typename Isa::Int y0 = Isa::CellIndex (fy);
+      typename Isa::Int y1 = Isa::AddInt (y0, one);
+
+      typename Isa::Real xs = SCurve<Isa, Q> (Isa::Sub (fx, Isa::ToReal (x0)));
+      typename Isa::Real ys = SCurve<Isa, Q> (Isa::Sub (fy, Isa::ToReal (y0)));
+
+      typename Isa::Real n0, n1, ix0, ix1;
+      n0  = Lattice::Corner (fx, fy, x0, y0, seedTerm);
+      n1  = Lattice::Corner (fx, fy, x1, y0, seedTerm);
+      ix0 = LinearInterp<Isa> (n0, n1, xs);
+      n0  = Lattice::Corner (fx, fy, x0, y1, seedTerm);
+      n1  = Lattice::Corner (fx, fy, x1, y1, seedTerm);
+      ix1 = LinearInterp<Isa> (n0, n1, xs);
+      Isa::Store (out + i, LinearInterp<Isa> (ix0, ix1, ys));
+    }
+
+    for (; i < n; i++) {
+      out[i] = Lattice::Scalar (x[i], y[i], seed, Q);
+    }
+  }
+
+  template <class Isa, class Lattice>
+  void CoherentNoise2DKernel (const double* x, const double* y,
+    double* out, size_t n, int seed, NoiseQuality noiseQuality)
+  {
+    switch (noiseQuality) {
+      case QUALITY_FAST:
+        CoherentNoise2DLoop<Isa, Lattice, QUALITY_FAST> (x, y, out, n, seed);
+        break;
+      case QUALITY_STD:
+        CoherentNoise2DLoop<Isa, Lattice, QUALITY_STD > (x, y, out, n, seed);
+        break;
+      case QUALITY_BEST:
+        CoherentNoise2DLoop<Isa, Lattice, QUALITY_BEST> (x, y, out, n, seed);
+        break;
+    }
+  }
+
+  template <class Isa>
+  void GradientCoherentNoise2DKernel (const double* x, const double* y,
+    double* out, size_t n, int seed, NoiseQuality noiseQuality)
+  {
+    CoherentNoise2DKernel<Isa, GradientCorner<Isa> > (x, y, out, n, seed,
+      noiseQuality);
+  }
+
+  template <class Isa>
+  void ValueCoherentNoise2DKernel (const double* x, const double* y,
+    double* out, size_t n, int seed, NoiseQuality noiseQuality)
+  {
+    CoherentNoise2DKernel<Isa, ValueCorner<Isa> > (x, y, out, n, seed,
+      noiseQuality);
+  }
+
+  // Same as CoherentNoise2DLoop, with one seed per input value.
+  template <class Isa, class Lattice, NoiseQuality Q>
+  void CoherentNoise2DSeedsLoop (const double* x, const double* y,
+    const int* seeds, double* out, size_t n)
+  {
+    typename Isa::Int one = Isa::SetInt (1);
+
+    size_t i = 0;
+    for (; i + Isa::WIDTH <= n; i += Isa::WIDTH) {
+      typename Isa::Real fx = Isa::Load (x + i);
+      typename Isa::Real fy = Isa::Load (y + i);
+      typename Isa::Int seedTerm = Lattice::SeedTerms (Isa::LoadInt (
+        seeds + i));
+
+      typename Isa::Int x0 = Isa::CellIndex (fx);
+      typename Isa::Int x1 = Isa::AddInt (x0, one);
+      typename Isa::Int y0 = Isa::CellIndex (fy);
+      typename Isa::Int y1 = Isa::AddInt (y0, one);
+
+      typename Isa::Real xs = SCurve<Isa, Q> (Isa::Sub (fx, Isa::ToReal (x0)));
+      typename Isa::Real ys = SCurve<Isa, Q> (Isa::Sub (fy, Isa::ToReal (y0)));
+
+      typename Isa::Real n0, n1, ix0, ix1;
+      n0  = Lattice::Corner (fx, fy, x0, y0, seedTerm);
+      n1  = Lattice::Corner (fx, fy, x1, y0, seedTerm);
+      ix0 = LinearInterp<Isa> (n0, n1, xs);
+      n0  = Lattice::Corner (fx, fy, x0, y1, seedTerm);
+      n1  = Lattice::Corner (fx, fy, x1, y1, seedTerm);
+      ix1 = LinearInterp<Isa> (n0, n1, xs);
+      Isa::Store (out + i, LinearInterp<Isa> (ix0, ix1, ys));
+    }
+
+    for (; i < n; i++) {
+      out[i] = Lattice::Scalar (x[i], y[i], seeds[i], Q);
+    }
+  }
+
+  template <class Isa, class Lattice>
+  void CoherentNoise2DSeedsKernel (const double* x, const double* y,
+    const int* seeds, double* out, size_t n, NoiseQuality noiseQuality)
+  {
+    switch (noiseQuality) {
+      case QUALITY_FAST:
+        CoherentNoise2DSeedsLoop<Isa, Lattice, QUALITY_FAST> (x, y, seeds,
+          out, n);
+        break;
+      case QUALITY_STD:
+        CoherentNoise2DSeedsLoop<Isa, Lattice, QUALITY_STD > (x, y, seeds,
+          out, n);
+        break;
+      case QUALITY_BEST:
+        CoherentNoise2DSeedsLoop<Isa, Lattice, QUALITY_BEST> (x, y, seeds,
+          out, n);
+        break;
+    }
+  }
+
+  template <class Isa>
+  void GradientCoherentNoise2DSeedsKernel (const double* x, const double* y,
+    const int* seeds, double* out, size_t n, NoiseQuality noiseQuality)
+  {
+    CoherentNoise2DSeedsKernel<Isa, GradientCorner<Isa> > (x, y, seeds, out,
+      n, noiseQuality);
+  }
+
+  template <class Isa>
+  void ValueCoherentNoise2DSeedsKernel (const double* x, const double* y,
+    const int* seeds, double* out, size_t n, NoiseQuality noiseQuality)
+  {
+    CoherentNoise2DSeedsKernel<Isa, ValueCorner<Isa> > (x, y, seeds, out, n,
+      noiseQuality);
+  }
+
+  // Same as CoherentNoise2DLoop, for two seeds at once.  The lattice
+  // cells, the S-curves and the distances to the lattice points are
+  // shared.
+  template <class Isa, class Lattice, NoiseQuality Q>
+  void CoherentNoise2DPairLoop (const double* x, const double* y,
+    double* out0, double* out1, size_t n, int seed0, int seed1)
+  {
+    typename Isa::Int one = Isa::SetInt (1);
+    typename Isa::Int seedTerm0 = Lattice::SeedTerm (seed0);
+    typename Isa::Int seedTerm1 = Lattice::SeedTerm (seed1);
+
+    size_t i = 0;
+    for (; i + Isa::WIDTH <= n; i += Isa::WIDTH) {
+      typename Isa::Real fx = Isa::Load (x + i);
+      typename Isa::Real fy = Isa::Load (y + i);
+
+      typename Isa::Int x0 = Isa::CellIndex (fx);
+      typename Isa::Int x1 = Isa::AddInt (x0, one);
+      typename Isa::Int y0 = Isa::CellIndex (fy);
+      typename Isa::Int y1 = Isa::AddInt (y0, one);
+
+      typename Isa::Real xs = SCurve<Isa, Q> (Isa::Sub (fx, Isa::ToReal (x0)));
+      typename Isa::Real ys = SCurve<Isa, Q> (Isa::Sub (fy, Isa::ToReal (y0)));
+
+      typename Isa::Real n0, n1, ix0, ix1;
+      n0  = Lattice::Corner (fx, fy, x0, y0, seedTerm0);
+      n1  = Lattice::Corner (fx, fy, x1, y0, seedTerm0);
+      ix0 = LinearInterp<Isa> (n0, n1, xs);
+      n0  = Lattice::Corner (fx, fy, x0, y1, seedTerm0);
+      n1  = Lattice::Corner (fx, fy, x1, y1, seedTerm0);
+      ix1 = LinearInterp<Isa> (n0, n1, xs);
+      Isa::Store (out0 + i, LinearInterp<Isa> (ix0, ix1, ys));
+
+      n0  = Lattice::Corner (fx, fy, x0, y0, seedTerm1);
+      n1  = Lattice::Corner (fx, fy, x1, y0, seedTerm1);
+      ix0 = LinearInterp<Isa> (n0, n1, xs);
+      n0  = Lattice::Corner (fx, fy, x0, y1, seedTerm1);
+      n1  = Lattice::Corner (fx, fy, x1, y1, seedTerm1);
+      ix1 = LinearInterp<Isa> (n0, n1, xs);
+      Isa::Store (out1 + i, LinearInterp<Isa> (ix0, ix1, ys));
+    }
+
+    for (; i < n; i++) {
+      out0[i] = Lattice::Scalar (x[i], y[i], seed0, Q);
+      out1[i] = Lattice::Scalar (x[i], y[i], seed1, Q);
+    }
+  }
+
+  template <class Isa, class Lattice>
+  void CoherentNoise2DPairKernel (const double* x, const double* y,
+    double* out0, double* out1, size_t n, int seed0, int seed1,
+    NoiseQuality noiseQuality)
+  {
+    switch (noiseQuality) {
+      case QUALITY_FAST:
+        CoherentNoise2DPairLoop<Isa, Lattice, QUALITY_FAST> (x, y, out0,
+          out1, n, seed0, seed1);
+        break;
+      case QUALITY_STD:
+        CoherentNoise2DPairLoop<Isa, Lattice, QUALITY_STD > (x, y, out0,
+          out1, n, seed0, seed1);
+        break;
+      case QUALITY_BEST:
+        CoherentNoise2DPairLoop<Isa, Lattice, QUALITY_BEST> (x, y, out0,
+          out1, n, seed0, seed1);
+        break;
+    }
+  }
+
+  template <class Isa>
+  void GradientCoherentNoise2DPairKernel (const double* x, const double* y,
+    double* out0, double* out1, size_t n, int seed0, int seed1,
+    NoiseQuality noiseQuality)
+  {
+    CoherentNoise2DPairKernel<Isa, GradientCorner<Isa> > (x, y, out0, out1,
+      n, seed0, seed1, noiseQuality);
+  }
+
+  template <class Isa>
+  void ValueCoherentNoise2DPairKernel (const double* x, const double* y,
+    double* out0, double* out1, size_t n, int seed0, int seed1,
+    NoiseQuality noiseQuality)
+  {
+    CoherentNoise2DPairKernel<Isa, ValueCorner<Isa> > (x, y, out0, out1, n,
+      seed0, seed1, noiseQuality);
+  }
+
+  template <class Isa>
+  void IntValueNoise2DKernel (const int* x, const int* y, int* out,
+    size_t n, int seed)
+  {
+    typename Isa::Int seedTerm = Isa::SetInt (SEED_NOISE_GEN * seed);
+
+    size_t i = 0;
+    for (; i + Isa::WIDTH <= n; i += Isa::WIDTH) {
+      Isa::StoreInt (out + i, IntValueNoise<Isa> (Isa::LoadInt (x + i),
+        Isa::LoadInt (y + i), seedTerm));
+    }
+    for (; i < n; i++) {
+      out[i] = IntValueNoise2D (x[i], y[i], seed);
+    }
+  }
+
+  // See MapToSCurveFixed() in noisegenscalar.h.
+  template <class Isa, NoiseQuality Q>
+  inline typename Isa::Int SCurveFixed (typename Isa::Int a)
+  {
+    switch (Q) {
+      case QUALITY_FAST:
+        return a;
+      case QUALITY_STD:
+      {
+        typename Isa::Int a2 = Isa::template ShiftRightInt<15> (
+          Isa::MulInt (a, a));
+        return Isa::template ShiftRightInt<14> (Isa::MulInt (a2,
+          Isa::SubInt (Isa::SetInt (3 << 14), a)));
+      }
+      case QUALITY_BEST:
+      default:
+      {
+        typename Isa::Int a2 = Isa::template ShiftRightInt<15> (
+          Isa::MulInt (a, a));
+        typename Isa::Int a3 = Isa::template ShiftRightInt<15> (
+          Isa::MulInt (a2, a));
+        typename Isa::Int inner = Isa::AddInt (
+          Isa::template ShiftRightInt<15> (Isa::MulInt (a, Isa::SubInt (
+            Isa::template ShiftRightInt<3> (Isa::MulInt (Isa::SetInt (6), a)),
+            Isa::SetInt (15 << 12)))),
+          Isa::SetInt (10 << 12));
+        return Isa::template ShiftRightInt<12> (Isa::MulInt (a3, inner));
+      }
+    }
+  }
+
+  template <class Isa>
+  inline typename Isa::Int LinearInterpFixed (typename Isa::Int n0,
+    typename Isa::Int n1, typename Isa::Int a)
+  {
+    // n0 + (((n1 - n0) * a) >> 15)
+    return Isa::AddInt (n0, Isa::template ShiftRightInt<15> (
+      Isa::MulInt (Isa::SubInt (n1, n0), a)));
+  }
+
+  // Fixed-point lattice corner policies for CoherentNoise2DFixedLoop, see
+  // GradientLatticeFixed and ValueLatticeFixed in noisegenscalar.h.
+  template <class Isa>
+  struct GradientCornerFixed
+  {
+    static typename Isa::Int SeedTerm (int seed)
+    {
+      return Isa::SetInt (SEED_NOISE_GEN * seed);
+    }
+
+    static typename Isa::Int Corner (typename Isa::Int xvPoint,
+      typename Isa::Int yvPoint, typename Isa::Int ix, typename Isa::Int iy,
+      typename Isa::Int seedTerm)
+    {
+      typename Isa::Int vectorIndex = GradientIndex<Isa> (ix, iy, seedTerm);
+      typename Isa::Int xvGradient = Isa::GatherInt (g_randomVectorsFixed,
+        vectorIndex);
+      typename Isa::Int yvGradient = Isa::GatherInt (g_randomVectorsFixed + 1,
+        vectorIndex);
+      return Isa::template ShiftRightInt<15> (Isa::AddInt (
+        Isa::MulInt (xvGradient, xvPoint), Isa::MulInt (yvGradient, yvPoint)));
+    }
+
+    static typename Isa::Int Scale (typename Isa::Int value)
+    {
+      return Isa::template ShiftRightInt<13> (Isa::MulInt (value,
+        Isa::SetInt (FIXED_SQRT1_2)));
+    }
+
+    static int32 Scalar (int32 x, int32 y, int seed,
+      NoiseQuality noiseQuality)
+    {
+      return GradientCoherentNoise2DFixed (x, y, seed, noiseQuality);
+    }
+  };
+
+  template <class Isa>
+  struct ValueCornerFixed
+  {
+    static typename Isa::Int SeedTerm (int seed)
+    {
+#ifdef VALUE_NOISE_USE_XXHASH
+      return Isa::SetInt ((int)((uint32)seed + XXH_PRIME32_5 + 8));
+#else
+      return Isa::SetInt (SEED_NOISE_GEN * seed);
+#endif
+    }
+
+    static typename Isa::Int Corner (typename Isa::Int, typename Isa::Int,
+      typename Isa::Int ix, typename Isa::Int iy, typename Isa::Int seedTerm)
+    {
+#ifdef VALUE_NOISE_USE_XXHASH
+      return Isa::SubInt (Isa::SetInt (16384),
+        Isa::template ShiftRightLogicalInt<17> (
+          XxHash32<Isa> (ix, iy, seedTerm)));
+#else
+      return Isa::SubInt (Isa::SetInt (16384),
+        Isa::template ShiftRightInt<16> (
+          IntValueNoise<Isa> (ix, iy, seedTerm)));
+#endif
+    }
+
+    static typename Isa::Int Scale (typename Isa::Int value)
+    {
+      return Isa::template ShiftLeftInt<2> (value);
+    }
+
+    static int32 Scalar (int32 x, int32 y, int seed,
+      NoiseQuality noiseQuality)
+    {
+      return ValueCoherentNoise2DFixed (x, y, seed, noiseQuality);
+    }
+  };
+
+  // See noise::GradientCoherentNoise2DFixed() and
+  // noise::ValueCoherentNoise2DFixed().
+  template <class Isa, class Lattice, NoiseQuality Q>
+  void CoherentNoise2DFixedLoop (const int32* x, const int32* y, int32* out,
+    size_t n, int seed)
+  {
+    typename Isa::Int one = Isa::SetInt (1);
+    typename Isa::Int cellMask = Isa::SetInt (0xffff);
+    typename Isa::Int cellSize = Isa::SetInt (32768);
+    typename Isa::Int seedTerm = Lattice::SeedTerm (seed);
+
+    size_t i = 0;
+    for (; i + Isa::WIDTH <= n; i += Isa::WIDTH) {
+      typename Isa::Int fx = Isa::LoadInt (x + i);
+      typename Isa::Int fy = Isa::LoadInt (y + i);
+
+      typename Isa::Int x0 = Isa::template ShiftRightInt<16> (fx);
+      typename Isa::Int x1 = Isa::AddInt (x0, one);
+      typename Isa::Int y0 = Isa::template ShiftRightInt<16> (fy);
+      typename Isa::Int y1 = Isa::AddInt (y0, one);
+
+      typename Isa::Int xvPoint0 = Isa::template ShiftRightLogicalInt<1> (
+        Isa::AndInt (fx, cellMask));
+      typename Isa::Int xvPoint1 = Isa::SubInt (xvPoint0, cellSize);
+      typename Isa::Int yvPoint0 = Isa::template ShiftRightLogicalInt<1> (
+        Isa::AndInt (fy, cellMask));
+      typename Isa::Int yvPoint1 = Isa::SubInt (yvPoint0, cellSize);
+
+      typename Isa::Int xs = SCurveFixed<Isa, Q> (xvPoint0);
+      typename Isa::Int ys = SCurveFixed<Isa, Q> (yvPoint0);
+
+      typename Isa::Int n0, n1, ix0, ix1;
+      n0  = Lattice::Corner (xvPoint0, yvPoint0, x0, y0, seedTerm);
+      n1  = Lattice::Corner (xvPoint1, yvPoint0, x1, y0, seedTerm);
+      ix0 = LinearInterpFixed<Isa> (n0, n1, xs);
+      n0  = Lattice::Corner (xvPoint0, yvPoint1, x0, y1, seedTerm);
+      n1  = Lattice::Corner (xvPoint1, yvPoint1, x1, y1, seedTerm);
+      ix1 = LinearInterpFixed<Isa> (n0, n1, xs);
+      Isa::StoreInt (out + i, Lattice::Scale (
+        LinearInterpFixed<Isa> (ix0, ix1, ys)));
+    }
+
+    for (; i < n; i++) {
+      out[i] = Lattice::Scalar (x[i], y[i], seed, Q);
+    }
+  }
+
+  template <class Isa, class Lattice>
+  void CoherentNoise2DFixedKernel (const int32* x, const int32* y,
+    int32* out, size_t n, int seed, NoiseQuality noiseQuality)
+  {
+    switch (noiseQuality) {
+      case QUALITY_FAST:
+        CoherentNoise2DFixedLoop<Isa, Lattice, QUALITY_FAST> (x, y, out, n,
+          seed);
+        break;
+      case QUALITY_STD:
+        CoherentNoise2DFixedLoop<Isa, Lattice, QUALITY_STD > (x, y, out, n,
+          seed);
+        break;
+      case QUALITY_BEST:
+        CoherentNoise2DFixedLoop<Isa, Lattice, QUALITY_BEST> (x, y, out, n,
+          seed);
+        break;
+    }
+  }
+
+  template <class Isa>
+  void GradientCoherentNoise2DFixedKernel (const int32* x, const int32* y,
+    int32* out, size_t n, int seed, NoiseQuality noiseQuality)
+  {
+    CoherentNoise2DFixedKernel<Isa, GradientCornerFixed<Isa> > (x, y, out, n,
+      seed, noiseQuality);
+  }
+
+  template <class Isa>
+  void ValueCoherentNoise2DFixedKernel (const int32* x, const int32* y,
+    int32* out, size_t n, int seed, NoiseQuality noiseQuality)
+  {
+    CoherentNoise2DFixedKernel<Isa, ValueCornerFixed<Isa> > (x, y, out, n,
+      seed, noiseQuality);
+  }
+
+  // See SimplexCorner() in noisegen.cpp.
+  template <class Isa>
+  inline typename Isa::Real SimplexCorner (typename Isa::Real x,
+    typename Isa::Real y, typename Isa::Int ix, typename Isa::Int iy,
+    typename Isa::Int seedTerm, typename Isa::Real radius2)
+  {
+    typename Isa::Real t = Isa::Sub (Isa::Sub (radius2, Isa::Mul (x, x)),
+      Isa::Mul (y, y));
+    t = Isa::Max (Isa::Set (0.0), t);
+    typename Isa::Real t2 = Isa::Mul (t, t);
+
+    typename Isa::Int vectorIndex = GradientIndex<Isa> (ix, iy, seedTerm);
+    typename Isa::Real xvGradient = Isa::Gather (g_randomVectors,
+      vectorIndex);
+    typename Isa::Real yvGradient = Isa::Gather (g_randomVectors + 1,
+      vectorIndex);
+
+    return Isa::Mul (Isa::Mul (t2, t2), Isa::Add (
+      Isa::Mul (xvGradient, x), Isa::Mul (yvGradient, y)));
+  }
+
+  // See SimplexCell() in noisegen.cpp.  Returns 1.0 in the lanes of lower
+  // triangles and 0.0 in the lanes of upper triangles.
+  template <class Isa>
+  inline typename Isa::Real SimplexCell (typename Isa::Real fx,
+    typename Isa::Real fy, typename Isa::Int& ix, typename Isa::Int& iy,
+    typename Isa::Real& x0, typename Isa::Real& y0)
+  {
+    typename Isa::Real s = Isa::Mul (Isa::Add (fx, fy),
+      Isa::Set (SIMPLEX_SKEW));
+    ix = Isa::CellIndex (Isa::Add (fx, s));
+    iy = Isa::CellIndex (Isa::Add (fy, s));
+    typename Isa::Real rx = Isa::ToReal (ix);
+    typename Isa::Real ry = Isa::ToReal (iy);
+
+    typename Isa::Real t = Isa::Mul (Isa::Add (rx, ry),
+      Isa::Set (SIMPLEX_UNSKEW));
+    x0 = Isa::Sub (fx, Isa::Sub (rx, t));
+    y0 = Isa::Sub (fy, Isa::Sub (ry, t));
+    return Isa::IsGreater (x0, y0);
+  }
+
+  // See noise::SimplexNoise2D().
+  template <class Isa>
+  void SimplexNoise2DKernel (const double* x, const double* y, double* out,
+    size_t n, int seed)
+  {
+    typename Isa::Real one = Isa::Set (1.0);
+    typename Isa::Real unskew = Isa::Set (SIMPLEX_UNSKEW);
+    typename Isa::Real radius2 = Isa::Set (SIMPLEX_RADIUS2);
+    typename Isa::Int oneInt = Isa::SetInt (1);
+    typename Isa::Int seedTerm = Isa::SetInt (SEED_NOISE_GEN * seed);
+
+    size_t i = 0;
+    for (; i + Isa::WIDTH <= n; i += Isa::WIDTH) {
+      typename Isa::Int ix, iy;
+      typename Isa::Real x0, y0;
+      typename Isa::Real i1 = SimplexCell<Isa> (Isa::Load (x + i),
+        Isa::Load (y + i), ix, iy, x0, y0);
+      typename Isa::Real j1 = Isa::Sub (one, i1);
+
+      typename Isa::Real x1 = Isa::Add (Isa::Sub (x0, i1), unskew);
+      typename Isa::Real y1 = Isa::Add (Isa::Sub (y0, j1), unskew);
+      typename Isa::Real x2 = Isa::Add (Isa::Sub (x0, one),
+        Isa::Set (2.0 * SIMPLEX_UNSKEW));
+      typename Isa::Real y2 = Isa::Add (Isa::Sub (y0, one),
+        Isa::Set (2.0 * SIMPLEX_UNSKEW));
+
+      typename Isa::Real n0 = SimplexCorner<Isa> (x0, y0, ix, iy, seedTerm,
+        radius2);
+      typename Isa::Real n1 = SimplexCorner<Isa> (x1, y1,
+        Isa::AddInt (ix, Isa::ToInt (i1)), Isa::AddInt (iy, Isa::ToInt (j1)),
+        seedTerm, radius2);
+      typename Isa::Real n2 = SimplexCorner<Isa> (x2, y2,
+        Isa::AddInt (ix, oneInt), Isa::AddInt (iy, oneInt), seedTerm,
+        radius2);
+      Isa::Store (out + i, Isa::Mul (Isa::Add (Isa::Add (n0, n1), n2),
+        Isa::Set (SIMPLEX_SCALE)));
+    }
+
+    for (; i < n; i++) {
+      out[i] = SimplexNoise2D (x[i], y[i], seed);
+    }
+  }
+
+  // See noise::OpenSimplexNoise2D().  The offsets of the lattice points
+  // are selected per lane by multiplying them with the triangle mask.
+  template <class Isa>
+  void OpenSimplexNoise2DKernel (const double* x, const double* y,
+    double* out, size_t n, int seed)
+  {
+    typename Isa::Real one = Isa::Set (1.0);
+    typename Isa::Real radius2 = Isa::Set (OPENSIMPLEX_RADIUS2);
+    typename Isa::Int seedTerm = Isa::SetInt (SEED_NOISE_GEN * seed);
+
+    size_t i = 0;
+    for (; i + Isa::WIDTH <= n; i += Isa::WIDTH) {
+      typename Isa::Int ix, iy;
+      typename Isa::Real x0, y0;
+      typename Isa::Real i1 = SimplexCell<Isa> (Isa::Load (x + i),
+        Isa::Load (y + i), ix, iy, x0, y0);
+      typename Isa::Real j1 = Isa::Sub (one, i1);
+
+      typename Isa::Real value = Isa::Set (0.0);
+      for (int k = 0; k < OPENSIMPLEX_POINTS; k++) {
+        typename Isa::Real offsetX = Isa::Set (OPENSIMPLEX_OFFSET_X[k]);
+        typename Isa::Real offsetY = Isa::Set (OPENSIMPLEX_OFFSET_Y[k]);
+        typename Isa::Real a = Isa::Add (Isa::Mul (i1, offsetX),
+          Isa::Mul (j1, offsetY));
+        typename Isa::Real b = Isa::Add (Isa::Mul (i1, offsetY),
+          Isa::Mul (j1, offsetX));
+        typename Isa::Real unskew = Isa::Set ((double)(
+          OPENSIMPLEX_OFFSET_X[k] + OPENSIMPLEX_OFFSET_Y[k]) * SIMPLEX_UNSKEW);
+        value = Isa::Add (value, SimplexCorner<Isa> (
+          Isa::Add (Isa::Sub (x0, a), unskew),
+          Isa::Add (Isa::Sub (y0, b), unskew),
+          Isa::AddInt (ix, Isa::ToInt (a)), Isa::AddInt (iy, Isa::ToInt (b)),
+          seedTerm, radius2));
+      }
+      Isa::Store (out + i, Isa::Mul (value, Isa::Set (OPENSIMPLEX_SCALE)));
+    }
+
+    for (; i < n; i++) {
+      out[i] = OpenSimplexNoise2D (x[i], y[i], seed);
+    }
+  }
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,838 @@
+// noisegenscalar.h
+//
+// Copyright (C) 2026 libnoise2d contributors
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#ifndef NOISE_NOISEGENSCALAR_H
+#define NOISE_NOISEGENSCALAR_H
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+#include "noisegenimpl.h"
+#include "interp.h"
+
+// Internal header, not installed.  Scalar building blocks of the
+// coherent-noise functions, shared by noisegen.cpp and the fractal modules.
+// The modules instantiate them with the noise type and quality as
+// constants, so the whole octave loop can be inlined (see Noise2D().)
+//
+// Everything is kept in an anonymous namespace, like in noisegenkernels.h,
+// so that each translation unit gets its own copy.
+
+namespace noise
+{
+
+  namespace
+  {
+
+    // Same as noise::IntValueNoise2D().
+    inline int IntValueHash (int x, int y, int seed)
+    {
+      // All constants are primes and must remain prime in order for this
+      // noise function to work correctly.  The hash relies on integer
+      // overflow wrapping around, so it is calculated unsigned.  Signed
+      // overflow is undefined and optimising compilers did drop the final
+      // mask.
+      uint32 n = (
+          X_NOISE_GEN    * (uint32)x
+        + Y_NOISE_GEN    * (uint32)y
+        + SEED_NOISE_GEN * (uint32)seed)
+        & 0x7fffffff;
+      n = (n >> 13) ^ n;
+      return (int)((n * (n * n * 60493 + 19990303) + 1376312589) & 0x7fffffff);
+    }
+
+    // Same as noise::ValueNoise2D().
+    inline double ValueHash (int x, int y, int seed)
+    {
+#ifdef VALUE_NOISE_USE_XXHASH
+      return 1.0 - ((double)XxHash32Lattice (x, y, seed)
+        * (2.0 / 4294967296.0));
+#else
+      return 1.0 - ((double)IntValueHash (x, y, seed) / 1073741824.0);
+#endif
+    }
+
+    // Returns the index of the random gradient vector of the given integer
+    // coordinates in g_randomVectors and g_randomVectorsFixed.
+    inline int GetGradientIndex (int ix, int iy, int seed)
+    {
+      // Randomly generate a gradient vector given the integer coordinates of
+      // the input value.  This implementation generates a random number and
+      // uses it as an index into a normalized-vector lookup table.  The
+      // calculation is done unsigned, since it wraps around on overflow.
+      uint32 vectorIndex = (
+          X_NOISE_GEN    * (uint32)ix
+        + Y_NOISE_GEN    * (uint32)iy
+        + SEED_NOISE_GEN * (uint32)seed);
+      vectorIndex ^= (vectorIndex >> SHIFT_NOISE_GEN);
+      vectorIndex &= 0xff;
+      return (int)(vectorIndex << 1);
+    }
+
+    // Returns the random gradient vector of the given integer coordinates.
+    inline const double* GetGradientVector (int ix, int iy, int seed)
+    {
+      return &g_randomVectors[GetGradientIndex (ix, iy, seed)];
+    }
+
+    // Maps the position of a coordinate within its lattice cell onto an
+    // S-curve.
+    inline double MapToSCurve (double a, NoiseQuality noiseQuality)
+    {
+      switch (noiseQuality) {
+        case QUALITY_FAST:
+          return a;
+        case QUALITY_STD:
+          return SCurve3 (a);
+        case QUALITY_BEST:
+          return SCurve5 (a);
+      }
+      return a;
+    }
+
+    // Lattice hashes.  GetGradient() returns the gradient vector and
+    // GetValue() the value-noise value of a lattice point.
+    struct ArithmeticHash
+    {
+      ArithmeticHash (int seed): m_seed (seed) {}
+
+      const double* GetGradient (int ix, int iy) const
+      {
+        return GetGradientVector (ix, iy, m_seed);
+      }
+
+      double GetValue (int ix, int iy) const
+      {
+        return ValueHash (ix, iy, m_seed);
+      }
+
+      int m_seed;
+    };
+
+    struct PermutationHash
+    {
+      PermutationHash (const PermutationTable& table): m_table (table) {}
+
+      const double* GetGradient (int ix, int iy) const
+      {
+        return &g_randomVectors[m_table.Hash (ix, iy) << 1];
+      }
+
+      double GetValue (int ix, int iy) const
+      {
+        return 1.0 - ((double)m_table.Hash (ix, iy) / 127.5);
+      }
+
+      const PermutationTable& m_table;
+    };
+
+    // Returns @a i modulo @a period, ranging from 0 to @a period - 1.  A
+    // period of 0 or less leaves @a i unchanged.
+    inline int WrapLattice (int i, int period)
+    {
+      if (period <= 0) {
+        return i;
+      }
+      int wrapped = i % period;
+      return (wrapped < 0)? wrapped + period: wrapped;
+    }
+
+    // Lattice hash that repeats every @a periodX and @a periodY lattice
+    // points, by wrapping the coordinates before passing them to @a Hash.
+    // The distances to the lattice points are still calculated from the
+    // unwrapped coordinates.
+    template <class Hash>
+    struct PeriodicHash
+    {
+      PeriodicHash (const Hash& hash, int periodX, int periodY):
+        m_hash (hash), m_periodX (periodX), m_periodY (periodY) {}
+
+      const double* GetGradient (int ix, int iy) const
+      {
+        return m_hash.GetGradient (WrapLattice (ix, m_periodX),
+          WrapLattice (iy, m_periodY));
+      }
+
+      double GetValue (int ix, int iy) const
+      {
+        return m_hash.GetValue (WrapLattice (ix, m_periodX),
+          WrapLattice (iy, m_periodY));
+      }
+
+      Hash m_hash;
+      int m_periodX;
+      int m_periodY;
+    };
+
+    // Returns the derivative of MapToSCurve().
+    inline double MapToSCurveDeriv (double a, NoiseQuality noiseQuality)
+    {
+      switch (noiseQuality) {
+        case QUALITY_FAST:
+          return 1.0;
+        case QUALITY_STD:
+          return SCurve3Deriv (a);
+        case QUALITY_BEST:
+          return SCurve5Deriv (a);
+      }
+      return 1.0;
+    }
+
+    // Lattice policies.  Noise() returns the noise value of a lattice point
+    // at the given input value and NoiseDeriv() also its partial
+    // derivatives.  For CoherentNoise2DGrid() in noisegen.cpp, Corner()
+    // stores the data of a lattice point, Column() combines it with the
+    // distance of a column to the lattice point, and Value() returns the
+    // noise value of a row from the column data.
+    struct GradientLattice
+    {
+      enum { SIZE = 2 };
+
+      template <class Hash>
+      static double Noise (const Hash& hash, double fx, double fy, int ix,
+        int iy)
+      {
+        // Same as GradientNoise2D().
+        const double* gradient = hash.GetGradient (ix, iy);
+        return ((gradient[0] * (fx - (double)ix))
+              + (gradient[1] * (fy - (double)iy))) * SQRT1_2;
+      }
+
+      template <class Hash>
+      static double NoiseDeriv (const Hash& hash, double fx, double fy, int ix,
+        int iy, double& dx, double& dy)
+      {
+        const double* gradient = hash.GetGradient (ix, iy);
+        dx = gradient[0] * SQRT1_2;
+        dy = gradient[1] * SQRT1_2;
+        return ((gradient[0] * (fx - (double)ix))
+              + (gradient[1] * (fy - (double)iy))) * SQRT1_2;
+      }
+
+      template <class Hash>
+      static void Corner (const Hash& hash, int ix, int iy, double* corner)
+      {
+        const double* gradient = hash.GetGradient (ix, iy);
+        corner[0] = gradient[0];
+        corner[1] = gradient[1];
+      }
+
+      static void Column (const double* corner, double xvPoint, double* column)
+      {
+        column[0] = corner[0] * xvPoint;
+        column[1] = corner[1];
+      }
+
+      static double Value (const double* column, double yvPoint)
+      {
+        // Same as GradientNoise2D().
+        return (column[0] + (column[1] * yvPoint)) * SQRT1_2;
+      }
+    };
+
+    struct ValueLattice
+    {
+      enum { SIZE = 1 };
+
+      template <class Hash>
+      static double Noise (const Hash& hash, double, double, int ix, int iy)
+      {
+        return hash.GetValue (ix, iy);
+      }
+
+      template <class Hash>
+      static double NoiseDeriv (const Hash& hash, double, double, int ix,
+        int iy, double& dx, double& dy)
+      {
+        dx = 0.0;
+        dy = 0.0;
+        return hash.GetValue (ix, iy);
+      }
+
+      template <class Hash>
+      static void Corner (const Hash& hash, int ix, int iy, double* corner)
+      {
+        corner[0] = hash.GetValue (ix, iy);
+      }
+
+      static void Column (const double* corner, double, double* column)
+      {
+        column[0] = corner[0];
+      }
+
+      static double Value (const double* column, double)
+      {
+        return column[0];
+      }
+    };
+
+    // Evaluates coherent noise, see GradientCoherentNoise2D().
+    template <class Lattice, class Hash>
+    inline double CoherentNoise2D (double x, double y, const Hash& hash,
+      NoiseQuality noiseQuality)
+    {
+      int x0 = (x > 0.0? (int)x: (int)x - 1);
+      int x1 = x0 + 1;
+      int y0 = (y > 0.0? (int)y: (int)y - 1);
+      int y1 = y0 + 1;
+
+      double xs = MapToSCurve (x - (double)x0, noiseQuality);
+      double ys = MapToSCurve (y - (double)y0, noiseQuality);
+
+      double n0, n1, ix0, ix1;
+      n0   = Lattice::Noise (hash, x, y, x0, y0);
+      n1   = Lattice::Noise (hash, x, y, x1, y0);
+      ix0  = LinearInterp (n0, n1, xs);
+      n0   = Lattice::Noise (hash, x, y, x0, y1);
+      n1   = Lattice::Noise (hash, x, y, x1, y1);
+      ix1  = LinearInterp (n0, n1, xs);
+      return LinearInterp (ix0, ix1, ys);
+    }
+
+    // Evaluates the coherent noise of two lattice hashes at the same input
+    // value, see GradientCoherentNoise2DPair().  The lattice cell and the
+    // S-curves are shared.  Returns the noise of @a hash0 and stores that
+    // of @a hash1 in @a value1, each calculated exactly as by
+    // CoherentNoise2D().
+    template <class Lattice, class Hash>
+    inline double CoherentNoise2DPair (double x, double y, const Hash& hash0,
+      const Hash& hash1, NoiseQuality noiseQuality, double& value1)
+    {
+      int x0 = (x > 0.0? (int)x: (int)x - 1);
+      int x1 = x0 + 1;
+      int y0 = (y > 0.0? (int)y: (int)y - 1);
+      int y1 = y0 + 1;
+
+      double xs = MapToSCurve (x - (double)x0, noiseQuality);
+      double ys = MapToSCurve (y - (double)y0, noiseQuality);
+
+      double n0, n1, ix0, ix1;
+      n0   = Lattice::Noise (hash1, x, y, x0, y0);
+      n1   = Lattice::Noise (hash1, x, y, x1, y0);
+      ix0  = LinearInterp (n0, n1, xs);
+      n0   = Lattice::Noise (hash1, x, y, x0, y1);
+      n1   = Lattice::Noise (hash1, x, y, x1, y1);
+      ix1  = LinearInterp (n0, n1, xs);
+      value1 = LinearInterp (ix0, ix1, ys);
+
+      n0   = Lattice::Noise (hash0, x, y, x0, y0);
+      n1   = Lattice::Noise (hash0, x, y, x1, y0);
+      ix0  = LinearInterp (n0, n1, xs);
+      n0   = Lattice::Noise (hash0, x, y, x0, y1);
+      n1   = Lattice::Noise (hash0, x, y, x1, y1);
+      ix1  = LinearInterp (n0, n1, xs);
+      return LinearInterp (ix0, ix1, ys);
+    }
+
+    // Evaluates coherent noise and its partial derivatives, see
+    // GradientCoherentNoise2DDeriv().  The value is calculated exactly as by
+    // CoherentNoise2D().
+    template <class Lattice, class Hash>
+    inline double CoherentNoise2DDeriv (double x, double y,
+      const Hash& hash, NoiseQuality noiseQuality, double& dx, double& dy)
+    {
+      int x0 = (x > 0.0? (int)x: (int)x - 1);
+      int x1 = x0 + 1;
+      int y0 = (y > 0.0? (int)y: (int)y - 1);
+      int y1 = y0 + 1;
+
+      double xs = MapToSCurve (x - (double)x0, noiseQuality);
+      double ys = MapToSCurve (y - (double)y0, noiseQuality);
+      double dxs = MapToSCurveDeriv (x - (double)x0, noiseQuality);
+      double dys = MapToSCurveDeriv (y - (double)y0, noiseQuality);
+
+      double n00, n10, n01, n11;
+      double dx00, dx10, dx01, dx11;
+      double dy00, dy10, dy01, dy11;
+      n00 = Lattice::NoiseDeriv (hash, x, y, x0, y0, dx00, dy00);
+      n10 = Lattice::NoiseDeriv (hash, x, y, x1, y0, dx10, dy10);
+      n01 = Lattice::NoiseDeriv (hash, x, y, x0, y1, dx01, dy01);
+      n11 = Lattice::NoiseDeriv (hash, x, y, x1, y1, dx11, dy11);
+
+      // Product rule on both interpolation steps.  The S-curve of the x axis
+      // only depends on x, and that of the y axis only on y.
+      double ix0 = LinearInterp (n00, n10, xs);
+      double ix1 = LinearInterp (n01, n11, xs);
+      double dxIx0 = LinearInterp (dx00, dx10, xs) + dxs * (n10 - n00);
+      double dxIx1 = LinearInterp (dx01, dx11, xs) + dxs * (n11 - n01);
+      double dyIx0 = LinearInterp (dy00, dy10, xs);
+      double dyIx1 = LinearInterp (dy01, dy11, xs);
+
+      dx = LinearInterp (dxIx0, dxIx1, ys);
+      dy = LinearInterp (dyIx0, dyIx1, ys) + dys * (ix1 - ix0);
+      return LinearInterp (ix0, ix1, ys);
+    }
+
+    // Returns the contribution of a lattice point with the given gradient
+    // vector to the simplex noise at a distance (@a x, @a y).  The contribution
+    // vanishes at the squared distance @a radius2.
+    inline double SimplexCorner (const double* gradient, double radius2,
+      double x, double y)
+    {
+      // The radially symmetric falloff vanishes at the opposite edge of the
+      // simplex.  Clamp it rather than branching, so that the SIMD kernels can
+      // follow the same calculation.
+      double t = (radius2 - (x * x)) - (y * y);
+      if (t < 0.0) {
+        t = 0.0;
+      }
+      double t2 = t * t;
+      return (t2 * t2) * ((gradient[0] * x) + (gradient[1] * y));
+    }
+
+    // Same as SimplexCorner(), and adds the partial derivatives of the
+    // contribution to @a dx and @a dy.
+    inline double SimplexCornerDeriv (const double* gradient,
+      double radius2, double x, double y, double& dx, double& dy)
+    {
+      double t = (radius2 - (x * x)) - (y * y);
+      if (t < 0.0) {
+        t = 0.0;
+      }
+      double t2 = t * t;
+      double t4 = t2 * t2;
+      double dot = (gradient[0] * x) + (gradient[1] * y);
+
+      // d/dx (t^4 * dot) = t^4 * gradient[0] - 8 * t^3 * x * dot
+      double falloffDeriv = -8.0 * (t2 * t) * dot;
+      dx += (t4 * gradient[0]) + (falloffDeriv * x);
+      dy += (t4 * gradient[1]) + (falloffDeriv * y);
+      return t4 * dot;
+    }
+
+    // Skews the input value to find the unit square of the simplex lattice that
+    // contains it.  Each square is split into two triangles (simplices.)
+    // Stores the integer coordinates of the square in @a i and @a j and the
+    // distance to its first corner in @a x0 and @a y0.  Returns true if the
+    // input value lies in the lower triangle, below the diagonal.
+    inline bool SimplexCell (double x, double y, int& i, int& j,
+      double& x0, double& y0)
+    {
+      double s = (x + y) * SIMPLEX_SKEW;
+      double xs = x + s;
+      double ys = y + s;
+      i = (xs > 0.0? (int)xs: (int)xs - 1);
+      j = (ys > 0.0? (int)ys: (int)ys - 1);
+
+      // Unskew the origin of the square back to the input space.  The sum may
+      // exceed the integer range, so it is calculated in floating point.
+      double t = ((double)i + (double)j) * SIMPLEX_UNSKEW;
+      x0 = x - ((double)i - t);
+      y0 = y - ((double)j - t);
+      return x0 > y0;
+    }
+
+    // Generates OpenSimplex noise, using the given lattice hash.  If @a pDx is
+    // not NULL, the partial derivatives are stored in *pDx and *pDy.
+    template <class Hash>
+    inline double OpenSimplex2D (double x, double y, const Hash& hash,
+      double* pDx = NULL, double* pDy = NULL)
+    {
+      int i, j;
+      double x0, y0;
+      bool lower = SimplexCell (x, y, i, j, x0, y0);
+
+      double value = 0.0;
+      double dx = 0.0;
+      double dy = 0.0;
+      for (int k = 0; k < OPENSIMPLEX_POINTS; k++) {
+        // Mirror the offsets at the diagonal for the upper triangle.  The
+        // unskew term only depends on the sum of the offsets.
+        int a = lower? OPENSIMPLEX_OFFSET_X[k]: OPENSIMPLEX_OFFSET_Y[k];
+        int b = lower? OPENSIMPLEX_OFFSET_Y[k]: OPENSIMPLEX_OFFSET_X[k];
+        double unskew = (double)(OPENSIMPLEX_OFFSET_X[k]
+          + OPENSIMPLEX_OFFSET_Y[k]) * SIMPLEX_UNSKEW;
+        double xk = (x0 - (double)a) + unskew;
+        double yk = (y0 - (double)b) + unskew;
+        const double* gradient = hash.GetGradient (i + a, j + b);
+        if (pDx != NULL) {
+          value += SimplexCornerDeriv (gradient, OPENSIMPLEX_RADIUS2, xk, yk,
+            dx, dy);
+        } else {
+          value += SimplexCorner (gradient, OPENSIMPLEX_RADIUS2, xk, yk);
+        }
+      }
+
+      if (pDx != NULL) {
+        *pDx = dx * OPENSIMPLEX_SCALE;
+        *pDy = dy * OPENSIMPLEX_SCALE;
+      }
+      return value * OPENSIMPLEX_SCALE;
+    }
+
+    // Same as OpenSimplex2D() for two lattice hashes at once.  The skewed
+    // cell and the falloff of each lattice point are shared.  Returns the
+    // noise of @a hash0 and stores that of @a hash1 in @a value1.
+    template <class Hash>
+    inline double OpenSimplex2DPair (double x, double y, const Hash& hash0,
+      const Hash& hash1, double& value1)
+    {
+      int i, j;
+      double x0, y0;
+      bool lower = SimplexCell (x, y, i, j, x0, y0);
+
+      double value0 = 0.0;
+      value1 = 0.0;
+      for (int k = 0; k < OPENSIMPLEX_POINTS; k++) {
+        int a = lower? OPENSIMPLEX_OFFSET_X[k]: OPENSIMPLEX_OFFSET_Y[k];
+        int b = lower? OPENSIMPLEX_OFFSET_Y[k]: OPENSIMPLEX_OFFSET_X[k];
+        double unskew = (double)(OPENSIMPLEX_OFFSET_X[k]
+          + OPENSIMPLEX_OFFSET_Y[k]) * SIMPLEX_UNSKEW;
+        double xk = (x0 - (double)a) + unskew;
+        double yk = (y0 - (double)b) + unskew;
+
+        // Same as SimplexCorner().
+        double t = (OPENSIMPLEX_RADIUS2 - (xk * xk)) - (yk * yk);
+        if (t < 0.0) {
+          t = 0.0;
+        }
+        double t2 = t * t;
+        double falloff = t2 * t2;
+        const double* gradient0 = hash0.GetGradient (i + a, j + b);
+        const double* gradient1 = hash1.GetGradient (i + a, j + b);
+        value0 += falloff * ((gradient0[0] * xk) + (gradient0[1] * yk));
+        value1 += falloff * ((gradient1[0] * xk) + (gradient1[1] * yk));
+      }
+
+      value1 *= OPENSIMPLEX_SCALE;
+      return value0 * OPENSIMPLEX_SCALE;
+    }
+
+    // Evaluates coherent noise of the given type and quality.  Both are
+    // constants, so the switches on them fold away when this function is
+    // inlined into an octave loop.
+    template <NoiseType TYPE, NoiseQuality QUALITY, class Hash>
+    inline double Noise2D (double x, double y, const Hash& hash)
+    {
+      switch (TYPE) {
+        case TYPE_GRADIENT:
+          return CoherentNoise2D<GradientLattice> (x, y, hash, QUALITY);
+        case TYPE_VALUE:
+          return CoherentNoise2D<ValueLattice> (x, y, hash, QUALITY);
+        case TYPE_OPENSIMPLEX:
+          return OpenSimplex2D (x, y, hash);
+      }
+      return 0.0;
+    }
+
+    // Same as Noise2D() for two lattice hashes at once.  Returns the noise
+    // of @a hash0 and stores that of @a hash1 in @a value1.
+    template <NoiseType TYPE, NoiseQuality QUALITY, class Hash>
+    inline double Noise2DPair (double x, double y, const Hash& hash0,
+      const Hash& hash1, double& value1)
+    {
+      switch (TYPE) {
+        case TYPE_GRADIENT:
+          return CoherentNoise2DPair<GradientLattice> (x, y, hash0, hash1,
+            QUALITY, value1);
+        case TYPE_VALUE:
+          return CoherentNoise2DPair<ValueLattice> (x, y, hash0, hash1,
+            QUALITY, value1);
+        case TYPE_OPENSIMPLEX:
+          return OpenSimplex2DPair (x, y, hash0, hash1, value1);
+      }
+      value1 = 0.0;
+      return 0.0;
+    }
+
+    // Same as Noise2D(), with the lattice repeating every @a periodX and
+    // @a periodY lattice points.  Periods of 0 or less disable the wrap.
+    // The skewed lattice of OpenSimplex noise does not line up with the
+    // axes, so OpenSimplex noise is never periodic.
+    template <NoiseType TYPE, NoiseQuality QUALITY, class Hash>
+    inline double PeriodicNoise2D (double x, double y, const Hash& hash,
+      int periodX, int periodY)
+    {
+      if (TYPE == TYPE_OPENSIMPLEX || (periodX <= 0 && periodY <= 0)) {
+        return Noise2D<TYPE, QUALITY> (x, y, hash);
+      }
+      return Noise2D<TYPE, QUALITY> (x, y,
+        PeriodicHash<Hash> (hash, periodX, periodY));
+    }
+
+    // Evaluates coherent noise of the given type and quality and its
+    // partial derivatives, with the lattice repeating as in
+    // PeriodicNoise2D().
+    template <class Hash>
+    inline double PeriodicNoise2DDeriv (double x, double y, const Hash& hash,
+      int periodX, int periodY, NoiseType noiseType,
+      NoiseQuality noiseQuality, double& dx, double& dy)
+    {
+      PeriodicHash<Hash> periodicHash (hash, periodX, periodY);
+      switch (noiseType) {
+        case TYPE_GRADIENT:
+          return CoherentNoise2DDeriv<GradientLattice> (x, y, periodicHash,
+            noiseQuality, dx, dy);
+        case TYPE_VALUE:
+          return CoherentNoise2DDeriv<ValueLattice> (x, y, periodicHash,
+            noiseQuality, dx, dy);
+        case TYPE_OPENSIMPLEX:
+          return OpenSimplex2D (x, y, hash, &dx, &dy);
+      }
+      return 0.0;
+    }
+
+    // Returns the lattice period of an octave, the period of the first
+    // octave scaled by the lacunarity once per octave (@a scale) and
+    // rounded to the nearest integer.
+    inline int ScalePeriod (int period, double scale)
+    {
+      return (period > 0)? (int)(((double)period * scale) + 0.5): 0;
+    }
+
+    // Returns the number of octaves, at least 1 and at most @a octaveCount,
+    // whose wavelength is not shorter than @a footprint.  The first octave
+    // has the given frequency, and each following octave the frequency of
+    // the previous one multiplied by @a lacunarity.  A footprint of 0 or
+    // less keeps all octaves.
+    inline int FootprintOctaveCount (double frequency, double lacunarity,
+      int octaveCount, double footprint)
+    {
+      if (footprint <= 0.0) {
+        return octaveCount;
+      }
+      int count = 1;
+      double curFrequency = frequency * lacunarity;
+      while (count < octaveCount && curFrequency * footprint <= 1.0) {
+        count++;
+        curFrequency *= lacunarity;
+      }
+      return count;
+    }
+
+    // Returns the number of octaves, at least 1 and at most @a octaveCount,
+    // after which the octaves left cannot change a fractal sum by
+    // @a tolerance or more.  The sum is scaled by @a norm, and its octaves
+    // are weighted by the powers of @a persistence with coherent-noise values
+    // between -1 and +1.  A tolerance of 0 or less keeps all octaves.
+    inline int ToleranceOctaveCount (double persistence, double norm,
+      int octaveCount, double tolerance)
+    {
+      if (tolerance <= 0.0) {
+        return octaveCount;
+      }
+      double total = 0.0;
+      double amplitude = fabs (norm);
+      for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+        total += amplitude;
+        amplitude *= fabs (persistence);
+      }
+      double remaining = total;
+      amplitude = fabs (norm);
+      int count = 0;
+      while (count < octaveCount) {
+        remaining -= amplitude;
+        amplitude *= fabs (persistence);
+        count++;
+        if (remaining < tolerance) {
+          break;
+        }
+      }
+      return count;
+    }
+
+    // Maximum number of octaves OctaveNoise2D() evaluates at once, a
+    // multiple of the widest SIMD vector.
+    const int OCTAVE_LANES = 32;
+
+    // Minimum number of octaves for which OctaveNoise2D() is faster than
+    // evaluating the octaves one by one; below, the cost of the batch call
+    // outweighs the parallel lanes.  With the two lanes of SSE2, it is never
+    // faster, so it requires at least AVX2 (see UseOctaveNoise2D().)
+    const int SIMD_OCTAVE_THRESHOLD = 8;
+
+    // Returns true if OctaveNoise2D() is faster than evaluating
+    // @a octaveCount octaves one by one.
+    inline bool UseOctaveNoise2D (int octaveCount)
+    {
+      return octaveCount >= SIMD_OCTAVE_THRESHOLD
+        && GetSimdLevel () >= SIMD_AVX2;
+    }
+
+    // Evaluates the coherent noise of the first @a octaveCount octaves of a
+    // fractal sum at once, one octave per SIMD lane, and stores the values
+    // in @a signals, which holds OCTAVE_LANES values.  The first octave has
+    // the input value (@a x, @a y) and the seed @a seed; each following
+    // octave the input value of the previous one multiplied by
+    // @a lacunarity and the next seed, masked by @a seedMask.  The values
+    // are bit-identical to one Noise2D() call per octave with an
+    // ArithmeticHash.  Only gradient and value noise have batch kernels with
+    // one seed per input value.
+    template <NoiseType TYPE, NoiseQuality QUALITY>
+    inline void OctaveNoise2D (double x, double y, double lacunarity,
+      int seed, int seedMask, int octaveCount, double* signals)
+    {
+      double nx[OCTAVE_LANES];
+      double ny[OCTAVE_LANES];
+      int seeds[OCTAVE_LANES];
+
+      // Pad to a multiple of the vector width, so that the kernels never
+      // fall back to their scalar tail loop.
+      int widthMask = (1 << GetSimdLevel ()) - 1;
+      int laneCount = (octaveCount + widthMask) & ~widthMask;
+      int curOctave = 0;
+      for (; curOctave < octaveCount; curOctave++) {
+        nx[curOctave] = MakeInt32Range (x);
+        ny[curOctave] = MakeInt32Range (y);
+        seeds[curOctave] = (seed + curOctave) & seedMask;
+        x *= lacunarity;
+        y *= lacunarity;
+      }
+      for (; curOctave < laneCount; curOctave++) {
+        nx[curOctave] = 0.0;
+        ny[curOctave] = 0.0;
+        seeds[curOctave] = 0;
+      }
+
+      if (TYPE == TYPE_VALUE) {
+        ValueCoherentNoise2DSeeds (nx, ny, seeds, signals, laneCount,
+          QUALITY);
+      } else {
+        GradientCoherentNoise2DSeeds (nx, ny, seeds, signals, laneCount,
+          QUALITY);
+      }
+    }
+
+    // Fixed-point building blocks, see GradientCoherentNoise2DFixed().
+    // Positions within a lattice cell and S-curve values have 15 fractional
+    // bits, the noise values of lattice points 14.  All products fit into
+    // 32 bits.  Right shifts of negative values are arithmetic shifts on
+    // every supported compiler.
+
+    // Fixed-point MapToSCurve().  @a a ranges from 0 to 32767.
+    inline int32 MapToSCurveFixed (int32 a, NoiseQuality noiseQuality)
+    {
+      switch (noiseQuality) {
+        case QUALITY_FAST:
+          return a;
+        case QUALITY_STD:
+        {
+          // a * a * (3 - 2 * a), the second factor with 14 fractional bits.
+          int32 a2 = (a * a) >> 15;
+          return (a2 * ((3 << 14) - a)) >> 14;
+        }
+        case QUALITY_BEST:
+        {
+          // a * a * a * (a * (6 * a - 15) + 10), the second factor with 12
+          // fractional bits.
+          int32 a2 = (a * a) >> 15;
+          int32 a3 = (a2 * a) >> 15;
+          int32 inner = ((a * (((6 * a) >> 3) - (15 << 12))) >> 15)
+            + (10 << 12);
+          return (a3 * inner) >> 12;
+        }
+      }
+      return a;
+    }
+
+    // Fixed-point LinearInterp(), @a a has 15 fractional bits.
+    inline int32 LinearInterpFixed (int32 n0, int32 n1, int32 a)
+    {
+      return n0 + (((n1 - n0) * a) >> 15);
+    }
+
+    // Fixed-point lattice policies.  Noise() returns the noise value of a
+    // lattice point at the given distance and Scale() converts the
+    // interpolated value to 16 fractional bits.
+    struct GradientLatticeFixed
+    {
+      static int32 Noise (int seed, int32 xvPoint, int32 yvPoint, int ix,
+        int iy)
+      {
+        const int* gradient = &g_randomVectorsFixed[
+          GetGradientIndex (ix, iy, seed)];
+        return ((gradient[0] * xvPoint) + (gradient[1] * yvPoint)) >> 15;
+      }
+
+      static int32 Scale (int32 value)
+      {
+        return (value * FIXED_SQRT1_2) >> 13;
+      }
+    };
+
+    struct ValueLatticeFixed
+    {
+      static int32 Noise (int seed, int32, int32, int ix, int iy)
+      {
+#ifdef VALUE_NOISE_USE_XXHASH
+        return 16384 - (int32)(XxHash32Lattice (ix, iy, seed) >> 17);
+#else
+        return 16384 - (IntValueHash (ix, iy, seed) >> 16);
+#endif
+      }
+
+      static int32 Scale (int32 value)
+      {
+        return value * 4;
+      }
+    };
+
+    // Evaluates fixed-point coherent noise, see
+    // GradientCoherentNoise2DFixed().
+    template <class Lattice>
+    inline int32 CoherentNoise2DFixed (int32 x, int32 y, int seed,
+      NoiseQuality noiseQuality)
+    {
+      // The integer part selects the same lattice cell as in
+      // CoherentNoise2D().
+      int x0 = x >> 16;
+      int x1 = x0 + 1;
+      int y0 = y >> 16;
+      int y1 = y0 + 1;
+
+      // Distances to the lower and the upper lattice lines.
+      int32 xvPoint0 = (int32)(((uint32)x & 0xffff) >> 1);
+      int32 xvPoint1 = xvPoint0 - 32768;
+      int32 yvPoint0 = (int32)(((uint32)y & 0xffff) >> 1);
+      int32 yvPoint1 = yvPoint0 - 32768;
+
+      int32 xs = MapToSCurveFixed (xvPoint0, noiseQuality);
+      int32 ys = MapToSCurveFixed (yvPoint0, noiseQuality);
+
+      int32 n0, n1, ix0, ix1;
+      n0  = Lattice::Noise (seed, xvPoint0, yvPoint0, x0, y0);
+      n1  = Lattice::Noise (seed, xvPoint1, yvPoint0, x1, y0);
+      ix0 = LinearInterpFixed (n0, n1, xs);
+      n0  = Lattice::Noise (seed, xvPoint0, yvPoint1, x0, y1);
+      n1  = Lattice::Noise (seed, xvPoint1, yvPoint1, x1, y1);
+      ix1 = LinearInterpFixed (n0, n1, xs);
+      return Lattice::Scale (LinearInterpFixed (ix0, ix1, ys));
+    }
+
+    // Converts a module parameter to fixed point with 16 fractional bits,
+    // rounding to nearest.  The multiplication is exact, so the result is
+    // the same on every platform.
+    inline int64 ToFixed (double a)
+    {
+      return (int64)floor ((a * 65536.0) + 0.5);
+    }
+
+    // Returns @a x * @a frequency, both with 16 fractional bits, wrapped
+    // around to 32 bits like the lattice coordinates.
+    inline int32 ScaleFixed (int32 x, uint64 frequency)
+    {
+      return (int32)(uint32)(((uint64)(int64)x * frequency) >> 16);
+    }
+
+  }
+
+}
+
+#endif
+
+#endif
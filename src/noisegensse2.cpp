@@ -0,0 +1,165 @@
+// noisegensse2.cpp
+//
+// Copyright (C) 2026 libnoise2d contributors
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "noisegenimpl.h"
+
+#ifdef NOISE_USE_SIMD
+
+#include <emmintrin.h>
+
+namespace
+{
+
+  // SSE2 wrapper for the kernels in noisegenkernels.h.  Two doubles per
+  // register; only the lower two lanes of the integer registers are used.
+  struct Sse2
+  {
+    enum { WIDTH = 2 };
+
+    typedef __m128d Real;
+    typedef __m128i Int;
+
+    static Real Load (const double* p) { return _mm_loadu_pd (p); }
+    static void Store (double* p, Real a) { _mm_storeu_pd (p, a); }
+    static Real Set (double a) { return _mm_set1_pd (a); }
+    static Real Add (Real a, Real b) { return _mm_add_pd (a, b); }
+    static Real Sub (Real a, Real b) { return _mm_sub_pd (a, b); }
+    static Real Mul (Real a, Real b) { return _mm_mul_pd (a, b); }
+    static Real Max (Real a, Real b) { return _mm_max_pd (a, b); }
+    static Real IsGreater (Real a, Real b)
+    {
+      return _mm_and_pd (_mm_cmpgt_pd (a, b), _mm_set1_pd (1.0));
+    }
+
+    static Int LoadInt (const int* p)
+    {
+      return _mm_loadl_epi64 ((const __m128i*)p);
+    }
+    static void StoreInt (int* p, Int a) { _mm_storel_epi64 ((__m128i*)p, a); }
+    static Int SetInt (int a) { return _mm_set1_epi32 (a); }
+    static Int AddInt (Int a, Int b) { return _mm_add_epi32 (a, b); }
+    static Int XorInt (Int a, Int b) { return _mm_xor_si128 (a, b); }
+    static Int AndInt (Int a, Int b) { return _mm_and_si128 (a, b); }
+    static Int OrInt (Int a, Int b) { return _mm_or_si128 (a, b); }
+    template <int S> static Int ShiftRightInt (Int a)
+    {
+      return _mm_srai_epi32 (a, S);
+    }
+    template <int S> static Int ShiftRightLogicalInt (Int a)
+    {
+      return _mm_srli_epi32 (a, S);
+    }
+    template <int S> static Int ShiftLeftInt (Int a)
+    {
+      return _mm_slli_epi32 (a, S);
+    }
+
+    // SSE2 has no 32-bit multiply.  Multiply the even and odd lanes to
+    // 64 bits and keep the lower halves, which are the same for signed and
+    // unsigned integers.
+    static Int MulInt (Int a, Int b)
+    {
+      Int even = _mm_mul_epu32 (a, b);
+      Int odd  = _mm_mul_epu32 (_mm_srli_si128 (a, 4), _mm_srli_si128 (b, 4));
+      return _mm_unpacklo_epi32 (
+        _mm_shuffle_epi32 (even, _MM_SHUFFLE (0, 0, 2, 0)),
+        _mm_shuffle_epi32 (odd , _MM_SHUFFLE (0, 0, 2, 0)));
+    }
+
+    static Real ToReal (Int a) { return _mm_cvtepi32_pd (a); }
+    static Int ToInt (Real a) { return _mm_cvttpd_epi32 (a); }
+
+    static Int CellIndex (Real x)
+    {
+      Real notPositive = _mm_cmpngt_pd (x, _mm_setzero_pd ());
+      Real truncated = _mm_cvtepi32_pd (_mm_cvttpd_epi32 (x));
+      return _mm_cvttpd_epi32 (_mm_sub_pd (truncated,
+        _mm_and_pd (notPositive, _mm_set1_pd (1.0))));
+    }
+
+    static Real Gather (const double* base, Int index)
+    {
+      int i0 = _mm_cvtsi128_si32 (index);
+      int i1 = _mm_cvtsi128_si32 (_mm_srli_si128 (index, 4));
+      return _mm_set_pd (base[i1], base[i0]);
+    }
+  };
+
+  // SSE2 wrapper for the fixed-point kernels, using all four lanes of the
+  // integer registers.
+  struct Sse2Int
+  {
+    enum { WIDTH = 4 };
+
+    typedef __m128i Int;
+
+    static Int LoadInt (const int* p)
+    {
+      return _mm_loadu_si128 ((const __m128i*)p);
+    }
+    static void StoreInt (int* p, Int a) { _mm_storeu_si128 ((__m128i*)p, a); }
+    static Int SetInt (int a) { return _mm_set1_epi32 (a); }
+    static Int AddInt (Int a, Int b) { return _mm_add_epi32 (a, b); }
+    static Int SubInt (Int a, Int b) { return _mm_sub_epi32 (a, b); }
+    static Int MulInt (Int a, Int b) { return Sse2::MulInt (a, b); }
+    static Int XorInt (Int a, Int b) { return _mm_xor_si128 (a, b); }
+    static Int AndInt (Int a, Int b) { return _mm_and_si128 (a, b); }
+    static Int OrInt (Int a, Int b) { return _mm_or_si128 (a, b); }
+    template <int S> static Int ShiftRightInt (Int a)
+    {
+      return _mm_srai_epi32 (a, S);
+    }
+    template <int S> static Int ShiftRightLogicalInt (Int a)
+    {
+      return _mm_srli_epi32 (a, S);
+    }
+    template <int S> static Int ShiftLeftInt (Int a)
+    {
+      return _mm_slli_epi32 (a, S);
+    }
+
+    static Int GatherInt (const int* base, Int index)
+    {
+      int lanes[4];
+      _mm_storeu_si128 ((__m128i*)lanes, index);
+      return _mm_set_epi32 (base[lanes[3]], base[lanes[2]], base[lanes[1]],
+        base[lanes[0]]);
+    }
+  };
+
+}
+
+#include "noisegenkernels.h"
+
+const noise::simd::KernelTable noise::simd::SSE2_KERNELS =
+{
+  GradientCoherentNoise2DKernel<Sse2>,
+  ValueCoherentNoise2DKernel<Sse2>,
+  IntValueNoise2DKernel<Sse2>,
+  SimplexNoise2DKernel<Sse2>,
+  OpenSimplexNoise2DKernel<Sse2>,
+  GradientCoherentNoise2DFixedKernel<Sse2Int>,
+  ValueCoherentNoise2DFixedKernel<Sse2Int>,
+  GradientCoherentNoise2DSeedsKernel<Sse2>,
+  ValueCoherentNoise2DSeedsKernel<Sse2>,
+  GradientCoherentNoise2DPairKernel<Sse2>,
+  ValueCoherentNoise2DPairKernel<Sse2>
+};
+
+#endif
@@ -284,6 +284,76 @@ namespace noise
     0.0337884, -0.979891, 
   };
 
+  // The same vectors in fixed point with 14 fractional bits, rounded to
+  // nearest, for the fixed-point coherent-noise functions.
+  int g_randomVectorsFixed[256 * 2] =
+  {
+    -12515, -9772, 6489, 14820, -8176, -14197, 7680, -13513,
+    13592, 7077, -7446, 10314, -2660, -14253, 15283, 4153,
+    -5659, 15193, -11715, -4812, -4030, 11755, -15850, -4103,
+    14774, 6506, 14625, -1181, 426, -593, 15550, -3193,
+    7730, -13223, 14414, 2324, 9351, 11410, -2322, -16191,
+    -9539, -496, -9981, 3924, 4905, -3229, -13953, -3616,
+    13908, 5601, -2558, -11260, -10906, 10268, 9763, -11052,
+    2802, -8344, 12879, 8789, 3097, -12970, -4832, 13844,
+    5604, -9623, 9364, 12893, 14500, -6688, -12935, 9366,
+    12691, 5172, -13057, -710, -2333, -7754, -1145, 2793,
+    11269, -7942, 8908, -8756, 15923, 3021, 11585, 7958,
+    15439, 5439, 8177, 9829, -4738, 3459, 6757, -11742,
+    14372, -1357, -6893, -3511, 12330, -642, 1255, -16331,
+    -8918, -5070, -7461, -6809, -14329, 7926, 4017, -1374,
+    6263, -7091, -4714, -14836, -10940, 11550, 11762, -7602,
+    15996, -3521, -1201, -15092, -16159, 2478, -14734, -7040,
+    10684, -11872, 3338, 7504, -498, 11448, -7540, 13748,
+    -1472, 13728, -11986, 1301, -7328, -12917, 3055, 10582,
+    -4244, 15327, 7305, 13429, 5734, 12370, -16336, -589,
+    -7064, -2417, 4909, -10472, 6505, 9282, -8233, 7181,
+    1126, 5802, -781, -7579, -3636, 14758, -15665, -3697,
+    -3074, 6414, -3673, -5168, -11974, -8799, -579, -13382,
+    -15424, 2900, -2526, 6397, -4651, 8746, -7909, -13934,
+    -10636, 7827, 14506, -6642, -2413, 2976, 1572, -1898,
+    -14700, -3135, 14804, -7020, 13911, -4847, 10740, 12153,
+    10092, -2927, 185, 15274, -12993, 4227, 6913, 7443,
+    -5243, 658, -13365, 9033, -6187, 53, 2126, -10921,
+    9862, -10719, -15196, -563, -7187, -14226, -10631, -12274,
+    8313, -9639, 11910, 10218, 6736, 6023, 13211, 9587,
+    4324, -14432, 6907, -3299, -11194, -9332, -1919, -666,
+    -10546, -1789, -9201, -10320, 1030, 1715, 7877, -4697,
+    -3745, -3751, -1670, -10765, 1129, -11112, 6570, -12354,
+    -12159, 8963, -35, -13048, 4862, -6716, -4275, -13078,
+    -10512, 12163, -3048, -1663, 1748, -15763, -12181, 5077,
+    -13039, -9913, -13577, -6873, 1388, -8025, -6249, 12911,
+    4621, -15620, 8696, 13884, 844, 15115, -10346, -11617,
+    11276, 8475, 10595, -5469, -15279, -4056, 10332, 11265,
+    9467, -6458, -14546, -7165, 11321, 2851, -14200, 194,
+    -7911, 11914, -9463, 11184, 6124, 1611, 2797, 15798,
+    16280, -586, 9618, 6788, -6496, 4343, -1420, 13689,
+    15126, 2186, 62, -4237, 3918, 4017, 12431, -9107,
+    4839, 5071, 870, -14910, 4431, 376, 9235, 531,
+    2561, 2415, -672, 16086, -6317, -9443, 6362, 14818,
+    15492, -3160, 13836, 8523, 542, 16370, -9709, -7905,
+    8839, 10339, 10745, -448, 4497, 14543, -2022, 15977,
+    -3661, 11601, -14887, 3216, -15689, -142, 15737, 501,
+    -6769, 14869, -13894, 5748, 10072, 6485, -8249, -10914,
+    -4405, -12100, 12988, -9831, -10446, 8325, 12290, 4623,
+    -5754, -6427, 4098, -15745, -11999, 11156, -12463, -2310,
+    3651, -4981, 3427, 8285, 12418, -9278, -12827, -5557,
+    -7585, 9594, 10138, 3180, 12147, -4534, 11593, 11512,
+    2565, 13435, -13002, 7212, 3843, 14505, 2172, 13126,
+    -6191, -10472, -14188, -6496, -10237, -7255, -7958, 13527,
+    -15922, 2876, -7472, 6433, -171, 8546, -10823, -12209,
+    -258, -5038, -9887, -4099, 8305, 4097, 4185, 15840,
+    7647, -14323, 7784, -1118, -3686, -15384, -6192, -13349,
+    -5011, 8886, 4368, -14793, 452, 5278, 304, 11737,
+    -3356, 16030, -14717, 6127, -149, 8955, 10817, -12306,
+    14013, -4965, 13060, 1021, 8019, -14202, 4115, 11052,
+    -9477, -12081, -4173, -8435, 6144, 12478, 10491, -12030,
+    -10454, 4678, 12664, -2619, 13078, -9677, -16159, -948,
+    -5128, -15491, -8148, 2922, -1657, -16073, -8547, 907,
+    -12881, -9565, -9260, 13465, 7174, 2500, -15138, 5791,
+    3477, -13356, -14078, 2350, 16242, 1848, 554, -16055
+  };
+
 }
 
 #endif